@@ -0,0 +1,193 @@
+/**
+ * bankers_benchmark.cpp
+ *
+ * Measures ResourceManager's Banker's safety check with 1k and 10k
+ * registered flights. A random stream of single-unit requests, releases
+ * and flight churn (unregister + register) is replayed against the
+ * ResourceManager and against the textbook implementation it replaced
+ * (nested vectors, full O(n^2 * m) check per request, no compaction).
+ *
+ * Safety is a property of the state, not of the sequence found, so both
+ * must grant exactly the same requests; mismatches are reported.
+ *
+ * Usage: bankers_benchmark [operations]
+ */
+
+#include "../src/resources/ResourceManager.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+static const int TYPES = 7;
+static const int POOL[TYPES] = {8, 6, 10, 4, 5, 6, 8};  // Same pools as the simulation
+
+// Textbook Banker's, as ResourceManager implemented it before
+class LegacyBankers {
+    vector<int> available;
+    vector<vector<int>> max_need, allocation, need;
+    int num_flights = 0;
+
+    bool is_safe_state() {
+        vector<int> work = available;
+        vector<bool> finish(num_flights, false);
+        int count = 0;
+        while (count < num_flights) {
+            bool found = false;
+            for (int i = 0; i < num_flights; i++) {
+                if (finish[i]) continue;
+                bool can_finish = true;
+                for (int j = 0; j < TYPES; j++) {
+                    if (need[i][j] > work[j]) { can_finish = false; break; }
+                }
+                if (can_finish) {
+                    for (int j = 0; j < TYPES; j++) work[j] += allocation[i][j];
+                    finish[i] = true;
+                    found = true;
+                    count++;
+                }
+            }
+            if (!found) return false;
+        }
+        return true;
+    }
+
+public:
+    LegacyBankers() : available(POOL, POOL + TYPES) {}
+
+    int register_flight(const vector<int>& max_demand) {
+        max_need.push_back(max_demand);
+        allocation.push_back(vector<int>(TYPES, 0));
+        need.push_back(max_demand);
+        return num_flights++;
+    }
+    void unregister_flight(int i) {
+        for (int j = 0; j < TYPES; j++) {
+            available[j] += allocation[i][j];
+            allocation[i][j] = need[i][j] = max_need[i][j] = 0;
+        }
+    }
+    bool request(int i, int type, int count) {
+        if (count > need[i][type] || count > available[type]) return false;
+        available[type] -= count;
+        allocation[i][type] += count;
+        need[i][type] -= count;
+        if (!is_safe_state()) {
+            available[type] += count;
+            allocation[i][type] -= count;
+            need[i][type] += count;
+            return false;
+        }
+        return true;
+    }
+    void release(int i, int type, int count) {
+        int actual = min(count, allocation[i][type]);
+        allocation[i][type] -= actual;
+        available[type] += actual;
+        need[i][type] += actual;
+    }
+    int slots() const { return num_flights; }
+};
+
+struct Op {
+    int kind;       // 0 = request, 1 = release, 2 = churn
+    int flight;     // Index into the live flight list
+    int type;
+    vector<int> max_demand;
+};
+
+static vector<int> random_demand() {
+    vector<int> demand(TYPES);
+    for (int j = 0; j < TYPES; j++) {
+        demand[j] = rand() % 3;  // 0-2 units of each type
+    }
+    return demand;
+}
+
+static void run(int flights, int operations) {
+    srand(1234 + flights);
+    vector<vector<int>> initial;
+    for (int f = 0; f < flights; f++) initial.push_back(random_demand());
+
+    vector<Op> ops;
+    for (int k = 0; k < operations; k++) {
+        Op op;
+        int r = rand() % 100;
+        op.kind = r < 55 ? 0 : (r < 95 ? 1 : 2);
+        op.flight = rand() % flights;
+        op.type = rand() % TYPES;
+        if (op.kind == 2) op.max_demand = random_demand();
+        ops.push_back(op);
+    }
+
+    ResourceManager manager;
+    manager.initialize(POOL[0], POOL[1], POOL[2], POOL[3], POOL[4], POOL[5], POOL[6]);
+    LegacyBankers legacy;
+    vector<int> handles, legacy_ids;
+    for (const vector<int>& demand : initial) {
+        handles.push_back(manager.register_flight(demand));
+        legacy_ids.push_back(legacy.register_flight(demand));
+    }
+
+    vector<char> granted(ops.size(), 0);
+    long long granted_count = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t k = 0; k < ops.size(); k++) {
+        const Op& op = ops[k];
+        int h = handles[op.flight];
+        if (op.kind == 0) {
+            granted[k] = manager.request_resources(h, (ResourceType)op.type, 1);
+            granted_count += granted[k];
+        } else if (op.kind == 1) {
+            manager.release_resources(h, (ResourceType)op.type, 1);
+        } else {
+            manager.unregister_flight(h);
+            handles[op.flight] = manager.register_flight(op.max_demand);
+        }
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ops.size();
+
+    int mismatches = 0;
+    start = chrono::steady_clock::now();
+    for (size_t k = 0; k < ops.size(); k++) {
+        const Op& op = ops[k];
+        int id = legacy_ids[op.flight];
+        if (op.kind == 0) {
+            if (legacy.request(id, op.type, 1) != (bool)granted[k]) mismatches++;
+        } else if (op.kind == 1) {
+            legacy.release(id, op.type, 1);
+        } else {
+            legacy.unregister_flight(id);
+            legacy_ids[op.flight] = legacy.register_flight(op.max_demand);
+        }
+    }
+    double legacy_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / ops.size();
+
+    cout << flights << " registered flights, " << ops.size() << " operations:\n";
+    cout << "  incremental:  " << ns << " ns/op  (" << manager.get_incremental_checks()
+         << " incremental, " << manager.get_full_checks() << " full checks, "
+         << manager.get_registered_flights() << " rows)\n";
+    cout << "  textbook:     " << legacy_ns << " ns/op  (" << legacy.slots() << " rows)\n";
+    cout << "  speedup:      " << legacy_ns / ns << "x\n";
+    cout << "  granted:      " << granted_count << "  mismatches: " << mismatches << "\n\n";
+}
+
+int main(int argc, char** argv) {
+    int operations = argc > 1 ? atoi(argv[1]) : 20000;
+    if (operations <= 0) {
+        cerr << "Usage: bankers_benchmark [operations]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║           Banker's Safety Check Benchmark - 7 Types           ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+
+    cout << fixed << setprecision(1);
+    run(1000, operations);
+    run(10000, operations);
+    return 0;
+}
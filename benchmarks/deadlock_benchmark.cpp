@@ -0,0 +1,215 @@
+/**
+ * deadlock_benchmark.cpp
+ *
+ * Builds a wait-for graph of 100k waiting flights and measures the
+ * DeadlockDetector against the full-DFS design it replaced.
+ *
+ *   - build: flights wait for 1-2 flights holding resources one level up
+ *     the turnaround chain, inserted in random order; the detector checks
+ *     every new edge as it goes
+ *   - churn: finished flights leave (remove_flight) and new waits arrive
+ *   - cycles: a few edges close wait cycles; the deadlocked flights are
+ *     reported
+ *
+ * The old design needs a full DFS per detect_deadlock() call and a
+ * DFS per node in get_deadlocked_flights(), so it is only timed on a
+ * sample of calls (and the report on a smaller graph).
+ *
+ * Usage: deadlock_benchmark [flights]
+ */
+
+#include "../src/resources/DeadlockDetector.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+// Full-DFS detector, as DeadlockDetector was implemented before
+// (iterative DFS here so long wait chains cannot overflow the stack)
+class LegacyDetector {
+    unordered_map<int, unordered_set<int>> wait_for_graph;
+
+    bool dfs_detect_cycle(int start, unordered_set<int>& visited) {
+        unordered_set<int> rec_stack;
+        vector<pair<int, unordered_set<int>::iterator>> path;
+        visited.insert(start);
+        rec_stack.insert(start);
+        auto it = wait_for_graph.find(start);
+        if (it == wait_for_graph.end()) return false;
+        path.push_back(make_pair(start, it->second.begin()));
+        while (!path.empty()) {
+            int node = path.back().first;
+            auto& next = path.back().second;
+            if (next == wait_for_graph[node].end()) {
+                rec_stack.erase(node);
+                path.pop_back();
+                continue;
+            }
+            int neighbor = *next++;
+            if (rec_stack.count(neighbor)) return true;
+            if (!visited.count(neighbor)) {
+                visited.insert(neighbor);
+                auto adj = wait_for_graph.find(neighbor);
+                if (adj != wait_for_graph.end()) {
+                    rec_stack.insert(neighbor);
+                    path.push_back(make_pair(neighbor, adj->second.begin()));
+                }
+            }
+        }
+        return false;
+    }
+
+public:
+    void add_wait(int waiter, int holder) { wait_for_graph[waiter].insert(holder); }
+    void remove_flight(int flight) {
+        wait_for_graph.erase(flight);
+        for (auto& pair : wait_for_graph) pair.second.erase(flight);
+    }
+    bool detect_deadlock() {
+        unordered_set<int> visited;
+        for (auto& pair : wait_for_graph) {
+            if (!visited.count(pair.first) && dfs_detect_cycle(pair.first, visited)) return true;
+        }
+        return false;
+    }
+    vector<int> get_deadlocked_flights() {
+        vector<int> out;
+        for (auto& pair : wait_for_graph) {
+            unordered_set<int> visited;
+            if (dfs_detect_cycle(pair.first, visited)) out.push_back(pair.first);
+        }
+        return out;
+    }
+};
+
+static double elapsed_us(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+// Flights are spread over a few levels of the turnaround chain (waiting
+// for a gate, a tug, a crew...). A flight waits for 1-2 flights holding
+// resources one level up, so wait chains stay short as they do at an
+// airport, while holders are shared by many waiters.
+static const int LEVELS = 4;
+
+static vector<pair<int, int>> build_edges(int flights, unsigned seed) {
+    srand(seed);
+    int per_level = flights / LEVELS;
+    vector<pair<int, int>> edges;
+    for (int f = 0; f < per_level * (LEVELS - 1); f++) {
+        int next_level = (f / per_level + 1) * per_level;
+        int waits = 1 + rand() % 2;
+        for (int k = 0; k < waits; k++) {
+            edges.push_back(make_pair(f, next_level + rand() % per_level));
+        }
+    }
+    random_shuffle(edges.begin(), edges.end());
+    return edges;
+}
+
+int main(int argc, char** argv) {
+    int flights = argc > 1 ? atoi(argv[1]) : 100000;
+    if (flights < 100) {
+        cerr << "Usage: deadlock_benchmark [flights >= 100]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║          Deadlock Detector Benchmark - Wait-For Graph         ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(2);
+
+    vector<pair<int, int>> edges = build_edges(flights, 99);
+    cout << flights << " waiting flights, " << edges.size() << " wait edges\n\n";
+
+    // ----- Build: add_wait with online cycle check per edge -----
+    DeadlockDetector detector;
+    auto start = chrono::steady_clock::now();
+    int cycles_seen = 0;
+    for (const auto& e : edges) {
+        cycles_seen += detector.add_wait(e.first, e.second);
+    }
+    double build_us = elapsed_us(start);
+
+    LegacyDetector legacy;
+    for (const auto& e : edges) legacy.add_wait(e.first, e.second);
+    start = chrono::steady_clock::now();
+    const int legacy_samples = 5;
+    for (int i = 0; i < legacy_samples; i++) legacy.detect_deadlock();
+    double legacy_detect_us = elapsed_us(start) / legacy_samples;
+
+    cout << "Add wait + deadlock check (per edge):\n";
+    cout << "  incremental:   " << build_us * 1000 / edges.size() << " ns  (cycles: " << cycles_seen << ")\n";
+    cout << "  full DFS:      " << legacy_detect_us * 1000 << " ns\n\n";
+
+    // ----- Churn: departures and new waits -----
+    const int churn = 2000;
+    srand(7);
+    vector<int> leaving, arriving_waiter, arriving_holder;
+    for (int i = 0; i < churn; i++) {
+        leaving.push_back(rand() % flights);
+        int per_level = flights / LEVELS;
+        int waiter = rand() % (per_level * (LEVELS - 1));
+        arriving_waiter.push_back(waiter);
+        arriving_holder.push_back((waiter / per_level + 1) * per_level + rand() % per_level);
+    }
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < churn; i++) {
+        detector.remove_flight(leaving[i]);
+        detector.add_wait(arriving_waiter[i], arriving_holder[i]);
+        detector.detect_deadlock();
+    }
+    double churn_us = elapsed_us(start) / churn;
+
+    const int legacy_churn = 20;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < legacy_churn; i++) {
+        legacy.remove_flight(leaving[i]);
+        legacy.add_wait(arriving_waiter[i], arriving_holder[i]);
+        legacy.detect_deadlock();
+    }
+    double legacy_churn_us = elapsed_us(start) / legacy_churn;
+
+    cout << "Remove flight + add wait + check:\n";
+    cout << "  incremental:   " << churn_us << " us\n";
+    cout << "  full DFS:      " << legacy_churn_us << " us\n\n";
+
+    // ----- Cycles: close a few wait loops and report members -----
+    // (a top-level holder ends up waiting for a bottom-level flight)
+    vector<pair<int, int>> current = build_edges(flights, 99);
+    for (int c = 0; c < 5; c++) {
+        const auto& e = current[c * 1000];
+        detector.add_wait(e.second, e.first);
+    }
+    start = chrono::steady_clock::now();
+    bool deadlock = detector.detect_deadlock();
+    vector<int> deadlocked = detector.get_deadlocked_flights();
+    double report_us = elapsed_us(start);
+
+    // Old report is quadratic - time it on a 2k-flight graph instead
+    int small = min(flights, 2000);
+    LegacyDetector legacy_small;
+    vector<pair<int, int>> small_edges = build_edges(small, 99);
+    for (const auto& e : small_edges) legacy_small.add_wait(e.first, e.second);
+    legacy_small.add_wait(small_edges[0].second, small_edges[0].first);
+    start = chrono::steady_clock::now();
+    vector<int> legacy_deadlocked = legacy_small.get_deadlocked_flights();
+    double legacy_report_us = elapsed_us(start);
+
+    cout << "Deadlock report:\n";
+    cout << "  Tarjan SCC:    " << report_us << " us at " << flights << " flights ("
+         << (deadlock ? "deadlock" : "no deadlock") << ", " << deadlocked.size() << " flights in cycles)\n";
+    cout << "  DFS per node:  " << legacy_report_us << " us at " << small << " flights ("
+         << legacy_deadlocked.size() << " flights reported)\n";
+    cout << "  graph now:     " << detector.get_flight_count() << " flights, "
+         << detector.get_edge_count() << " edges\n";
+
+    return 0;
+}
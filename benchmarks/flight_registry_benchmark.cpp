@@ -0,0 +1,185 @@
+/**
+ * flight_registry_benchmark.cpp
+ *
+ * Creates a day of generated flights (ids like "EK1234", the simulator's
+ * aircraft mix) and compares two ways of storing them:
+ *
+ *   - legacy: the Flight layout used before - std::string id, a new
+ *     Aircraft per flight, fields in declaration order - each flight and
+ *     aircraft a separate heap allocation, never freed
+ *   - registry: FlightRegistry slot map with interned ids and the shared
+ *     Aircraft table, slots reused as flights finish
+ *
+ * Reports bytes per flight, create/release cost, a scan over live flights
+ * (priority and aircraft fields, as the schedulers read them), and how
+ * many flights share a memory-simulator process id under the old
+ * flight_id[0] + flight_id[1] * 256 hash versus Flight::number.
+ *
+ * Usage: flight_registry_benchmark [flights] [live_flights]
+ */
+
+#include "../src/airport/FlightRegistry.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+static const char* AIRLINES[] = {"AA", "UA", "DL", "BA", "LH", "AF", "EK", "QR", "SQ", "CX"};
+static const AircraftType MIX[] = {A380, B777, B737, A320, G650, FALCON_7X, B747F};
+
+// Flight as laid out before the registry
+class LegacyFlight {
+public:
+    std::string flight_id;
+    Aircraft* aircraft;
+    FlightType flight_type;
+    FlightStatus status;
+    long long scheduled_arrival_time;
+    long long actual_arrival_time;
+    long long scheduled_departure_time;
+    long long actual_departure_time;
+    int passenger_count;
+    int connecting_passengers;
+    int reserve_fuel_minutes;
+    bool is_delayed;
+    int delay_minutes;
+    int go_around_count;
+    int assigned_runway_id;
+    int assigned_gate_id;
+    int priority;
+
+    LegacyFlight(const std::string& id, Aircraft* ac, FlightType ft, long long arr, long long dep)
+        : flight_id(id), aircraft(ac), flight_type(ft), status(SCHEDULED),
+          scheduled_arrival_time(arr), actual_arrival_time(0),
+          scheduled_departure_time(dep), actual_departure_time(0),
+          is_delayed(false), delay_minutes(0), go_around_count(0),
+          assigned_runway_id(-1), assigned_gate_id(-1) {
+        passenger_count = aircraft->passenger_capacity * (70 + rand() % 30) / 100;
+        connecting_passengers = passenger_count * 15 / 100;
+        reserve_fuel_minutes = 30 + rand() % 31;
+        priority = aircraft->is_private ? 80 : aircraft->is_cargo ? 60 : 50;
+    }
+};
+
+struct Spec {
+    string id;
+    AircraftType type;
+    FlightType flight_type;
+};
+
+static double elapsed_us(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+// Heap bytes including the allocator's 16-byte chunk header
+static size_t heap_bytes(size_t size) {
+    return (size + 8 + 15) / 16 * 16;
+}
+
+int main(int argc, char** argv) {
+    int flights = argc > 1 ? atoi(argv[1]) : 100000;
+    int live = argc > 2 ? atoi(argv[2]) : 500;
+    if (flights <= 0 || live <= 0 || live > flights) {
+        cerr << "Usage: flight_registry_benchmark [flights] [live_flights]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║         Flight Registry Benchmark - Flight Storage            ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(2);
+
+    srand(4);
+    vector<Spec> specs;
+    for (int f = 0; f < flights; f++) {
+        Spec spec;
+        spec.id = string(AIRLINES[rand() % 10]) + to_string(100 + f);
+        spec.type = MIX[rand() % 7];
+        spec.flight_type = rand() % 2 ? INTERNATIONAL : DOMESTIC;
+        specs.push_back(spec);
+    }
+    cout << flights << " flights, " << live << " live at a time\n\n";
+
+    // ----- Legacy: new Flight + new Aircraft, never freed -----
+    vector<LegacyFlight*> legacy;
+    legacy.reserve(flights);
+    auto start = chrono::steady_clock::now();
+    for (const Spec& spec : specs) {
+        legacy.push_back(new LegacyFlight(spec.id, new Aircraft(spec.type), spec.flight_type, 0, 300));
+    }
+    double legacy_create_ns = elapsed_us(start) * 1000 / flights;
+    size_t legacy_bytes = heap_bytes(sizeof(LegacyFlight)) + heap_bytes(sizeof(Aircraft));
+
+    // ----- Registry: create, and release once `live` flights are up -----
+    FlightRegistry registry;
+    vector<Flight*> window;
+    start = chrono::steady_clock::now();
+    for (int f = 0; f < flights; f++) {
+        if ((int)window.size() == live) {
+            registry.release(window[f % live]);
+            window[f % live] = registry.create(specs[f].id, specs[f].type, specs[f].flight_type, 0, 300);
+        } else {
+            window.push_back(registry.create(specs[f].id, specs[f].type, specs[f].flight_type, 0, 300));
+        }
+    }
+    double registry_create_ns = elapsed_us(start) * 1000 / flights;
+    size_t registry_bytes = sizeof(Flight);
+
+    cout << "Memory:\n";
+    cout << "  legacy:    " << legacy_bytes << " bytes per flight (" << sizeof(LegacyFlight)
+         << " flight + " << sizeof(Aircraft) << " aircraft, two allocations), "
+         << legacy_bytes * flights / 1024 << " KB retained\n";
+    cout << "  registry:  " << registry_bytes << " bytes per flight, "
+         << registry.get_capacity() << " slots ("
+         << registry.get_capacity() * registry_bytes / 1024 << " KB) for " << registry.get_live_count()
+         << " live flights, " << FlightRegistry::get_interned_count() << " interned ids\n\n";
+
+    cout << "Create (+ release):\n";
+    cout << "  legacy:    " << legacy_create_ns << " ns\n";
+    cout << "  registry:  " << registry_create_ns << " ns\n\n";
+
+    // ----- Scan the live flights, as a scheduler pass would -----
+    const int passes = 2000;
+    vector<LegacyFlight*> legacy_live(legacy.end() - live, legacy.end());
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (LegacyFlight* flight : legacy_live) {
+            checksum += flight->priority + flight->aircraft->service_time_minutes + (flight->aircraft->is_private ? 1 : 0);
+        }
+    }
+    double legacy_scan_ns = elapsed_us(start) * 1000 / ((double)passes * live);
+    start = chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (Flight* flight : window) {
+            checksum += flight->priority + flight->aircraft->service_time_minutes + (flight->aircraft->is_private ? 1 : 0);
+        }
+    }
+    double registry_scan_ns = elapsed_us(start) * 1000 / ((double)passes * live);
+    cout << "Scan of live flights (per flight):\n";
+    cout << "  legacy:    " << legacy_scan_ns << " ns\n";
+    cout << "  registry:  " << registry_scan_ns << " ns  (checksum " << checksum % 1000 << ")\n\n";
+
+    // ----- Memory-simulator process ids -----
+    unordered_set<int> hashed, numbered;
+    for (Flight* flight : window) {
+        hashed.insert(abs((int)(flight->flight_id[0] + flight->flight_id[1] * 256)));
+        numbered.insert(flight->number);
+    }
+    cout << "Process ids for " << live << " live flights:\n";
+    cout << "  id[0] + id[1]*256 hash:  " << hashed.size() << " distinct\n";
+    cout << "  Flight::number:          " << numbered.size() << " distinct\n\n";
+
+    // ----- Stale handles -----
+    FlightHandle handle = registry.handle_of(window[0]);
+    registry.release(window[0]);
+    Flight* reused = registry.create("REUSE", A320, DOMESTIC, 0, 300);
+    cout << "Released flight's handle after its slot is reused: "
+         << (registry.get(handle) == nullptr ? "stale (nullptr)" : "STILL RESOLVES")
+         << ", new flight in slot " << reused->slot << "\n";
+    return 0;
+}
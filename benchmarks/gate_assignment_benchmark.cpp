@@ -0,0 +1,219 @@
+/**
+ * gate_assignment_benchmark.cpp
+ *
+ * An arrival bank of 80 flights (A380s, widebodies, narrowbodies and
+ * business jets, 40% international) lands in random order at an airport
+ * with 100 gates. Three ways of giving them gates are compared:
+ *
+ *   - first fit: the GateManager scan used before - first available,
+ *     compatible gate in list order (big stands are listed first)
+ *   - best fit: allocate_gate from the (type, size) free lists
+ *   - bank plan: optimize_pending() assigns the whole bank first, then
+ *     each flight takes its planned gate on arrival
+ *
+ * Reports flights left without a gate, narrowbodies parked on widebody
+ * stands, passenger walking distance, and allocation / planning time.
+ *
+ * Usage: gate_assignment_benchmark [bank_size]
+ */
+
+#include "../src/airport/GateManager.h"
+#include "../src/core/Logger.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+struct GateSpec {
+    GateType type;
+    GateSize size;
+    int count;
+};
+
+// Widebody stands first, as an airport would list them
+static const GateSpec LAYOUT[] = {
+    {GATE_INTERNATIONAL, GATE_LARGE, 8},
+    {GATE_INTERNATIONAL, GATE_HEAVY, 20},
+    {GATE_DOMESTIC, GATE_HEAVY, 6},
+    {GATE_INTERNATIONAL, GATE_MEDIUM, 14},
+    {GATE_DOMESTIC, GATE_MEDIUM, 36},
+    {GATE_DOMESTIC, GATE_REGIONAL, 8},
+    {GATE_DOMESTIC, GATE_SMALL, 8},
+};
+
+struct Outcome {
+    int unassigned;
+    int widebody_stands_lost;   // Narrowbodies/jets on LARGE or HEAVY stands
+    long long walk_km;          // Passenger-kilometres walked
+};
+
+static double elapsed_us(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+static void build_gates(GateManager& manager, vector<Gate*>& list, vector<int>& walk) {
+    srand(3);
+    int id = 0;
+    for (const GateSpec& spec : LAYOUT) {
+        for (int k = 0; k < spec.count; k++, id++) {
+            Gate* gate = new Gate(id, spec.type, spec.size, spec.size != GATE_SMALL);
+            manager.add_gate(gate);
+            walk.push_back(100 + rand() % 700);
+            manager.set_walk_distance(id, walk.back());
+            list.push_back(gate);
+        }
+    }
+}
+
+static vector<Flight*> build_bank(int size) {
+    static const AircraftType MIX[] = {A380, B777, B777, B737, A320, B737, A320, A320, G650, FALCON_7X};
+    srand(21);
+    vector<Flight*> bank;
+    for (int f = 0; f < size; f++) {
+        AircraftType type = MIX[rand() % 10];
+        bool intl = type == A380 || rand() % 10 < 4;
+        if (type == G650 || type == FALCON_7X) intl = false;   // Only domestic small stands
+        bank.push_back(new Flight("F" + to_string(f), new Aircraft(type),
+                                  intl ? INTERNATIONAL : DOMESTIC, 0, 300));
+    }
+    return bank;
+}
+
+// A flight that best-fits this gate (used to fill the airport)
+static Flight* filler_for(Gate* gate) {
+    AircraftType type = A320;
+    if (gate->get_size() == GATE_LARGE) type = A380;
+    if (gate->get_size() == GATE_HEAVY) type = B777;
+    if (gate->get_size() == GATE_REGIONAL || gate->get_size() == GATE_SMALL) type = G650;
+    FlightType ft = gate->get_type() == GATE_INTERNATIONAL && type != G650 ? INTERNATIONAL : DOMESTIC;
+    return new Flight("FILL" + to_string(gate->get_id()), new Aircraft(type), ft, 0, 300);
+}
+
+static void score(Flight* flight, Gate* gate, const vector<int>& walk, Outcome& out) {
+    if (gate == nullptr) {
+        out.unassigned++;
+        return;
+    }
+    AircraftType t = flight->aircraft->type;
+    bool narrow = t == B737 || t == A320 || t == G650 || t == FALCON_7X;
+    if (narrow && (gate->get_size() == GATE_LARGE || gate->get_size() == GATE_HEAVY)) {
+        out.widebody_stands_lost++;
+    }
+    out.walk_km += (long long)flight->passenger_count * walk[gate->get_id()] / 1000;
+}
+
+static void print(const char* name, const Outcome& out) {
+    cout << "  " << left << setw(11) << name << right
+         << setw(4) << out.unassigned << " without gate, "
+         << setw(3) << out.widebody_stands_lost << " widebody stands lost, "
+         << setw(6) << out.walk_km << " passenger-km walked\n";
+}
+
+int main(int argc, char** argv) {
+    int bank_size = argc > 1 ? atoi(argv[1]) : 80;
+    if (bank_size <= 0) {
+        cerr << "Usage: gate_assignment_benchmark [bank_size]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║           Gate Assignment Benchmark - Arrival Bank            ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(2);
+
+    vector<Flight*> bank = build_bank(bank_size);
+    vector<Flight*> arrival_order = bank;
+    srand(8);
+    random_shuffle(arrival_order.begin(), arrival_order.end());
+
+    // ----- First fit (old allocate_gate scan) -----
+    GateManager first_fit_manager;
+    vector<Gate*> first_fit_gates;
+    vector<int> walk;
+    build_gates(first_fit_manager, first_fit_gates, walk);
+    cout << bank_size << " arrivals, " << first_fit_gates.size() << " gates\n\n";
+
+    Outcome first_fit = {};
+    for (Flight* flight : arrival_order) {
+        Gate* chosen = nullptr;
+        for (Gate* gate : first_fit_gates) {
+            if (gate->is_available() && gate->is_compatible(flight) && gate->try_reserve(flight)) {
+                chosen = gate;
+                break;
+            }
+        }
+        score(flight, chosen, walk, first_fit);
+    }
+
+    // ----- Best fit from the free lists -----
+    GateManager best_fit_manager;
+    vector<Gate*> best_fit_gates;
+    walk.clear();
+    build_gates(best_fit_manager, best_fit_gates, walk);
+    Outcome best_fit = {};
+    for (Flight* flight : arrival_order) {
+        score(flight, best_fit_manager.allocate_gate(flight), walk, best_fit);
+    }
+
+    // ----- Bank plan, then allocation on arrival -----
+    GateManager plan_manager;
+    vector<Gate*> plan_gates;
+    walk.clear();
+    build_gates(plan_manager, plan_gates, walk);
+    for (Flight* flight : bank) plan_manager.add_pending_arrival(flight);
+    int planned = plan_manager.optimize_pending();
+    double plan_us = plan_manager.get_last_plan_us();
+    Outcome bank_plan = {};
+    for (Flight* flight : arrival_order) {
+        score(flight, plan_manager.allocate_gate(flight), walk, bank_plan);
+    }
+
+    cout << "Assignment quality:\n";
+    print("first fit", first_fit);
+    print("best fit", best_fit);
+    print("bank plan", bank_plan);
+    cout << "\nBank plan: " << planned << " flights planned in " << plan_us << " us\n\n";
+
+    // ----- Allocation cost with the airport nearly full -----
+    // Every gate but two small stands is taken; one business jet then
+    // allocates and releases repeatedly. Both log as allocate_gate does.
+    const int rounds = 20000;
+    Logger* logger = Logger::get_instance();
+    Flight* probe = new Flight("PROBE", new Aircraft(G650), DOMESTIC, 0, 300);
+    for (Gate* gate : first_fit_gates) gate->release();
+    for (size_t g = 0; g + 2 < first_fit_gates.size(); g++) first_fit_gates[g]->try_reserve(filler_for(first_fit_gates[g]));
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (Gate* gate : first_fit_gates) {
+            if (gate->is_available() && gate->is_compatible(probe) && gate->try_reserve(probe)) {
+                logger->log_event("[GateManager] Flight PROBE allocated gate " + to_string(gate->get_id()));
+                gate->release();
+                logger->log_event("[GateManager] Gate " + to_string(gate->get_id()) + " released");
+                break;
+            }
+        }
+    }
+    double scan_ns = elapsed_us(start) * 1000 / rounds;
+
+    GateManager timing_manager;
+    vector<Gate*> timing_gates;
+    walk.clear();
+    build_gates(timing_manager, timing_gates, walk);
+    for (size_t g = 0; g + 2 < timing_gates.size(); g++) timing_manager.allocate_gate(filler_for(timing_gates[g]));
+    start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        Gate* gate = timing_manager.allocate_gate(probe);
+        if (gate) timing_manager.release_gate(gate->get_id());
+    }
+    double free_list_ns = elapsed_us(start) * 1000 / rounds;
+
+    cout << "Allocate + release, airport nearly full:\n";
+    cout << "  scan:        " << scan_ns << " ns\n";
+    cout << "  free lists:  " << free_list_ns << " ns\n";
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * gate_timeline_benchmark.cpp
+ *
+ * A day of scheduled arrivals at 24 gates, in simulation time units. Some
+ * flights land late and some stay at the gate past their departure slot.
+ * Two ways of handing out gates are compared:
+ *
+ *   - polling: allocate_gate on landing, and a flight without a gate asks
+ *     again every 10 units (the old one-second sleep loop)
+ *   - timeline: each flight is booked from the schedule when its arrival is
+ *     created (preassign_gate), re-booked when its delay becomes known
+ *     (update_gate_times), overstays are cleared ahead of the next flight
+ *     (replan_gate_conflicts every 20 units), and a flight without a gate
+ *     only asks again when one is released
+ *
+ * Reports gate waits, allocation attempts, how often the gate known 30
+ * units before landing is the one the flight gets, and planning cost.
+ *
+ * Usage: gate_timeline_benchmark [flights] [units_between_arrivals]
+ */
+
+#include "../src/airport/GateManager.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+struct GateSpec {
+    GateType type;
+    GateSize size;
+    int count;
+};
+
+static const GateSpec LAYOUT[] = {
+    {GATE_INTERNATIONAL, GATE_LARGE, 3},
+    {GATE_INTERNATIONAL, GATE_HEAVY, 6},
+    {GATE_INTERNATIONAL, GATE_MEDIUM, 4},
+    {GATE_DOMESTIC, GATE_MEDIUM, 8},
+    {GATE_DOMESTIC, GATE_SMALL, 3},
+};
+
+static const long long CREATE_LEAD = 600;   // Arrival event created this far ahead
+static const long long DELAY_NOTICE = 100;  // Delay known this long before landing
+static const long long GATE_NOTICE = 30;    // "Gate known ahead" sample point
+static const long long POLL_INTERVAL = 10;
+static const long long REPLAN_INTERVAL = 20;
+
+enum StepType { STEP_CREATE, STEP_DELAY, STEP_NOTICE, STEP_LAND, STEP_DEPART, STEP_REPLAN };
+
+struct Step {
+    long long time;
+    int order;
+    StepType type;
+    int flight;
+    bool operator>(const Step& other) const {
+        if (time != other.time) return time > other.time;
+        return order > other.order;
+    }
+};
+
+struct Movement {
+    Flight* flight;
+    long long land;         // Actual landing
+    long long overstay;     // Beyond the scheduled stay
+    Gate* gate;
+    Gate* known;            // Booked gate GATE_NOTICE units before landing
+    long long wait;
+};
+
+struct Outcome {
+    int waited;
+    long long wait_units;
+    long long max_wait;
+    long long attempts;
+    int known_ahead;
+    int unserved;
+};
+
+static double elapsed_us(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+static void build_gates(GateManager& manager) {
+    int id = 0;
+    for (const GateSpec& spec : LAYOUT) {
+        for (int k = 0; k < spec.count; k++, id++) {
+            manager.add_gate(new Gate(id, spec.type, spec.size, spec.size != GATE_SMALL));
+        }
+    }
+}
+
+static vector<Movement> build_schedule(int flights, int spacing) {
+    static const AircraftType MIX[] = {A380, B777, B777, B737, A320, B737, A320, A320, A320, G650};
+    srand(11);
+    vector<Movement> schedule;
+    for (int f = 0; f < flights; f++) {
+        AircraftType type = MIX[rand() % 10];
+        bool intl = type == A380 || rand() % 10 < 4;
+        if (type == G650) intl = false;
+        long long arrival = CREATE_LEAD + (long long)f * spacing + rand() % spacing;
+        long long departure = arrival + 120 + rand() % 180;
+        Movement m;
+        m.flight = new Flight("F" + to_string(f), new Aircraft(type), intl ? INTERNATIONAL : DOMESTIC,
+                              arrival, departure);
+        m.land = arrival + (rand() % 10 < 3 ? 20 + rand() % 130 : 0);
+        m.overstay = rand() % 10 < 2 ? 30 + rand() % 120 : 0;
+        m.gate = nullptr;
+        m.known = nullptr;
+        m.wait = 0;
+        schedule.push_back(m);
+    }
+    return schedule;
+}
+
+static Outcome run(vector<Movement>& schedule, bool use_timeline, double& plan_us, GateTimelineStats& stats) {
+    GateManager manager;
+    build_gates(manager);
+    priority_queue<Step, vector<Step>, greater<Step>> steps;
+    int order = 0;
+    for (size_t f = 0; f < schedule.size(); f++) {
+        Movement& m = schedule[f];
+        m.gate = m.known = nullptr;
+        m.wait = 0;
+        long long created = m.flight->scheduled_arrival_time - CREATE_LEAD;
+        steps.push(Step{created, order++, STEP_CREATE, (int)f});
+        if (m.land > m.flight->scheduled_arrival_time) {
+            steps.push(Step{m.land - DELAY_NOTICE, order++, STEP_DELAY, (int)f});
+        }
+        steps.push(Step{m.land - GATE_NOTICE, order++, STEP_NOTICE, (int)f});
+        steps.push(Step{m.land, order++, STEP_LAND, (int)f});
+    }
+    if (use_timeline) steps.push(Step{0, order++, STEP_REPLAN, -1});
+
+    Outcome out = {};
+    deque<int> waiting;
+    int remaining = schedule.size();
+    plan_us = 0;
+    auto try_gate = [&](int f, long long now) {
+        Movement& m = schedule[f];
+        out.attempts++;
+        m.gate = use_timeline ? manager.allocate_gate(m.flight, now) : manager.allocate_gate(m.flight);
+        if (m.gate == nullptr) return false;
+        m.wait = now - m.land;
+        long long stay = m.flight->scheduled_departure_time - m.flight->scheduled_arrival_time;
+        steps.push(Step{now + stay + m.overstay, order++, STEP_DEPART, f});
+        return true;
+    };
+
+    while (!steps.empty() && remaining > 0) {
+        Step s = steps.top();
+        steps.pop();
+        Movement* m = s.flight >= 0 ? &schedule[s.flight] : nullptr;
+        switch (s.type) {
+        case STEP_CREATE:
+            if (use_timeline) {
+                auto start = chrono::steady_clock::now();
+                manager.preassign_gate(m->flight);
+                plan_us += elapsed_us(start);
+            }
+            break;
+        case STEP_DELAY:
+            if (use_timeline) {
+                long long stay = m->flight->scheduled_departure_time - m->flight->scheduled_arrival_time;
+                auto start = chrono::steady_clock::now();
+                manager.update_gate_times(m->flight, m->land, m->land + stay + GateManager::GATE_BUFFER);
+                plan_us += elapsed_us(start);
+            }
+            break;
+        case STEP_NOTICE:
+            m->known = manager.get_booked_gate(m->flight);
+            break;
+        case STEP_LAND:
+            // Polling asks again on a timer; the timeline waits for a release
+            if (!try_gate(s.flight, s.time)) {
+                if (use_timeline) waiting.push_back(s.flight);
+                else steps.push(Step{s.time + POLL_INTERVAL, order++, STEP_LAND, s.flight});
+            }
+            break;
+        case STEP_DEPART:
+            manager.release_gate(m->gate->get_id());
+            remaining--;
+            if (use_timeline) {
+                for (size_t w = 0; w < waiting.size();) {
+                    if (try_gate(waiting[w], s.time)) waiting.erase(waiting.begin() + w);
+                    else w++;
+                }
+            }
+            break;
+        case STEP_REPLAN: {
+            auto start = chrono::steady_clock::now();
+            manager.replan_gate_conflicts(s.time);
+            plan_us += elapsed_us(start);
+            steps.push(Step{s.time + REPLAN_INTERVAL, order++, STEP_REPLAN, -1});
+            break;
+        }
+        }
+    }
+
+    for (Movement& m : schedule) {
+        if (m.gate == nullptr) {
+            out.unserved++;
+            continue;
+        }
+        if (m.wait > 0) {
+            out.waited++;
+            out.wait_units += m.wait;
+            out.max_wait = max(out.max_wait, m.wait);
+        }
+        if (m.known == m.gate) out.known_ahead++;
+    }
+    stats = manager.get_timeline_stats();
+    return out;
+}
+
+static void print(const char* name, const Outcome& out, int flights) {
+    cout << "  " << left << setw(10) << name << right
+         << setw(5) << out.waited << " waited, "
+         << setw(7) << (out.waited ? (double)out.wait_units / out.waited : 0.0) << " avg / "
+         << setw(4) << out.max_wait << " max units, "
+         << setw(6) << out.attempts << " allocation attempts, "
+         << setw(6) << 100.0 * out.known_ahead / flights << "% gate known ahead\n";
+}
+
+int main(int argc, char** argv) {
+    int flights = argc > 1 ? atoi(argv[1]) : 1000;
+    int spacing = argc > 2 ? atoi(argv[2]) : 14;
+    if (flights <= 0 || spacing <= 0) {
+        cerr << "Usage: gate_timeline_benchmark [flights] [units_between_arrivals]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║      Gate Timeline Benchmark - Delays and Overstays           ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(2);
+
+    vector<Movement> schedule = build_schedule(flights, spacing);
+    cout << flights << " arrivals, one every ~" << spacing << " units, 24 gates; "
+         << "30% land late, 20% overstay\n\n";
+
+    double polling_us, timeline_us;
+    GateTimelineStats polling_stats, stats;
+    Outcome polling = run(schedule, false, polling_us, polling_stats);
+    Outcome timeline = run(schedule, true, timeline_us, stats);
+
+    cout << "Gate waits:\n";
+    print("polling", polling, flights);
+    print("timeline", timeline, flights);
+    if (polling.unserved || timeline.unserved) {
+        cout << "  unserved: " << polling.unserved << " polling, " << timeline.unserved << " timeline\n";
+    }
+
+    cout << "\nTimeline: " << stats.preassigned << " preassigned, " << stats.rebooked
+         << " delays kept their gate, " << stats.moved << " bookings moved, "
+         << stats.conflicts_predicted << " overstay conflicts predicted, "
+         << stats.unplanned << " left unbooked\n";
+    cout << "          " << stats.booked_hits << " flights took their booked gate, planning "
+         << timeline_us / flights << " us per flight\n";
+    return 0;
+}
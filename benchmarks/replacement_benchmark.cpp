@@ -0,0 +1,318 @@
+/**
+ * replacement_benchmark.cpp
+ *
+ * Replays a page-reference trace against AWSC-PPC (ClockReplacer) and the
+ * baseline policies plain CLOCK, LRU and ARC, reporting fault rate and
+ * ns/access at several frame counts.
+ *
+ * Usage: replacement_benchmark [trace_file]
+ *   trace_file  page trace captured with SmartAirportOS --page-trace;
+ *               a synthetic multi-flight trace is generated if omitted
+ */
+
+#include "../src/memory/PageTrace.h"
+#include "../src/memory/Page.h"
+#include "../src/memory/PageFrame.h"
+#include "../src/memory/ClockReplacer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+
+using namespace std;
+
+static inline uint64_t page_key(const PageTraceRecord& r) {
+    return ((uint64_t)(uint32_t)r.process_id << 32) | (uint32_t)r.page_id;
+}
+
+// ========== Policies ==========
+
+class ReplacementSim {
+public:
+    virtual ~ReplacementSim() = default;
+    virtual const char* name() const = 0;
+    // Returns true on hit
+    virtual bool access(const PageTraceRecord& r) = 0;
+};
+
+// AWSC-PPC: the simulator's ClockReplacer over real PageFrame/Page objects
+class AwscPpcSim : public ReplacementSim {
+    int capacity;
+    int used;
+    ClockReplacer replacer;
+    vector<PageFrame*> frames;
+    unordered_map<uint64_t, Page*> pages;
+public:
+    AwscPpcSim(int n) : capacity(n), used(0), replacer(n) {
+        for (int i = 0; i < n; i++) {
+            frames.push_back(new PageFrame(i));
+            replacer.add_frame(frames.back());
+        }
+    }
+    ~AwscPpcSim() override {
+        for (PageFrame* f : frames) delete f;
+        for (auto& p : pages) delete p.second;
+    }
+    const char* name() const override { return "AWSC-PPC"; }
+    bool access(const PageTraceRecord& r) override {
+        Page*& page = pages[page_key(r)];
+        if (page == nullptr) page = new Page(r.page_id, r.process_id);
+
+        bool hit = page->get_state() != PAGE_INVALID;
+        if (!hit) {
+            PageFrame* frame;
+            if (used < capacity) {
+                frame = frames[used++];
+            } else {
+                frame = frames[replacer.find_victim(r.time)];
+                Page* evicted = frame->evict_page();
+                if (evicted) evicted->clear_modified_bit();  // Written back
+            }
+            frame->load_page(page, r.time);
+        }
+        page->access(r.time);
+        if (r.is_write) page->modify();
+        return hit;
+    }
+};
+
+// Plain CLOCK (second chance)
+class ClockSim : public ReplacementSim {
+    int capacity;
+    int hand;
+    vector<uint64_t> keys;
+    vector<bool> ref;
+    unordered_map<uint64_t, int> where;
+public:
+    ClockSim(int n) : capacity(n), hand(0) {}
+    const char* name() const override { return "CLOCK"; }
+    bool access(const PageTraceRecord& r) override {
+        uint64_t key = page_key(r);
+        auto it = where.find(key);
+        if (it != where.end()) {
+            ref[it->second] = true;
+            return true;
+        }
+        if ((int)keys.size() < capacity) {
+            where[key] = keys.size();
+            keys.push_back(key);
+            ref.push_back(true);
+            return false;
+        }
+        while (ref[hand]) {
+            ref[hand] = false;
+            hand = (hand + 1) % capacity;
+        }
+        where.erase(keys[hand]);
+        keys[hand] = key;
+        ref[hand] = true;
+        where[key] = hand;
+        hand = (hand + 1) % capacity;
+        return false;
+    }
+};
+
+// Least recently used
+class LruSim : public ReplacementSim {
+    int capacity;
+    list<uint64_t> order;  // Front = most recent
+    unordered_map<uint64_t, list<uint64_t>::iterator> where;
+public:
+    LruSim(int n) : capacity(n) {}
+    const char* name() const override { return "LRU"; }
+    bool access(const PageTraceRecord& r) override {
+        uint64_t key = page_key(r);
+        auto it = where.find(key);
+        if (it != where.end()) {
+            order.splice(order.begin(), order, it->second);
+            return true;
+        }
+        if ((int)order.size() >= capacity) {
+            where.erase(order.back());
+            order.pop_back();
+        }
+        order.push_front(key);
+        where[key] = order.begin();
+        return false;
+    }
+};
+
+// Adaptive Replacement Cache (Megiddo & Modha)
+class ArcSim : public ReplacementSim {
+    enum ListId { T1, T2, B1, B2 };
+    int c;
+    int p;
+    list<uint64_t> lists[4];
+    unordered_map<uint64_t, pair<ListId, list<uint64_t>::iterator>> where;
+
+    void move_to(uint64_t key, ListId to) {
+        auto it = where.find(key);
+        if (it != where.end()) lists[it->second.first].erase(it->second.second);
+        lists[to].push_front(key);
+        where[key] = {to, lists[to].begin()};
+    }
+    void drop_lru(ListId from) {
+        uint64_t key = lists[from].back();
+        lists[from].pop_back();
+        where.erase(key);
+    }
+    void replace(bool in_b2) {
+        int t1 = lists[T1].size();
+        if (t1 > 0 && (t1 > p || (in_b2 && t1 == p))) {
+            uint64_t key = lists[T1].back();
+            move_to(key, B1);
+        } else if (!lists[T2].empty()) {
+            uint64_t key = lists[T2].back();
+            move_to(key, B2);
+        } else {
+            uint64_t key = lists[T1].back();
+            move_to(key, B1);
+        }
+    }
+public:
+    ArcSim(int n) : c(n), p(0) {}
+    const char* name() const override { return "ARC"; }
+    bool access(const PageTraceRecord& r) override {
+        uint64_t key = page_key(r);
+        auto it = where.find(key);
+        ListId id = it != where.end() ? it->second.first : T1;
+
+        if (it != where.end() && (id == T1 || id == T2)) {
+            move_to(key, T2);
+            return true;
+        }
+        if (it != where.end() && id == B1) {
+            int delta = max(1, (int)(lists[B2].size() / max<size_t>(1, lists[B1].size())));
+            p = min(c, p + delta);
+            replace(false);
+            move_to(key, T2);
+            return false;
+        }
+        if (it != where.end() && id == B2) {
+            int delta = max(1, (int)(lists[B1].size() / max<size_t>(1, lists[B2].size())));
+            p = max(0, p - delta);
+            replace(true);
+            move_to(key, T2);
+            return false;
+        }
+
+        // Complete miss
+        int l1 = lists[T1].size() + lists[B1].size();
+        int total = l1 + lists[T2].size() + lists[B2].size();
+        if (l1 == c) {
+            if ((int)lists[T1].size() < c) {
+                drop_lru(B1);
+                replace(false);
+            } else {
+                drop_lru(T1);
+            }
+        } else if (l1 < c && total >= c) {
+            if (total == 2 * c) drop_lru(B2);
+            replace(false);
+        }
+        move_to(key, T1);
+        return false;
+    }
+};
+
+// ========== Synthetic flight trace ==========
+
+// Concurrent flights, each with a hot working set, a manifest scan and
+// shared airport-wide pages (runway/gate status) under process 0
+static vector<PageTraceRecord> build_synthetic_trace(int accesses, unsigned seed) {
+    srand(seed);
+    vector<PageTraceRecord> trace;
+    trace.reserve(accesses);
+
+    const int CONCURRENT = 24;
+    struct ActiveFlight { int pid; int remaining; int scan_pos; int hot_pages; int manifest_pages; };
+    vector<ActiveFlight> flights;
+    int next_pid = 1;
+
+    for (int t = 0; t < accesses; t++) {
+        while ((int)flights.size() < CONCURRENT) {
+            flights.push_back({next_pid++, 200 + rand() % 800, 0, 4 + rand() % 8, 16 + rand() % 48});
+        }
+        ActiveFlight& f = flights[rand() % flights.size()];
+        int roll = rand() % 100;
+        PageTraceRecord r;
+        r.time = t;
+        r.is_write = false;
+
+        if (roll < 10) {
+            r.process_id = 0;                                  // Shared status pages
+            r.page_id = rand() % 16;
+        } else if (roll < 65) {
+            r.process_id = f.pid;                              // Hot flight data
+            r.page_id = rand() % f.hot_pages;
+            r.is_write = (rand() % 4 == 0);
+        } else {
+            r.process_id = f.pid;                              // Manifest scan
+            r.page_id = 100 + f.scan_pos;
+            f.scan_pos = (f.scan_pos + 1) % f.manifest_pages;
+        }
+        trace.push_back(r);
+
+        if (--f.remaining <= 0) {
+            f = flights.back();
+            flights.pop_back();
+        }
+    }
+    return trace;
+}
+
+int main(int argc, char** argv) {
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║          Page Replacement Benchmark - Trace Replay            ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+
+    vector<PageTraceRecord> trace;
+    if (argc > 1) {
+        if (!PageTrace::load(argv[1], trace)) {
+            cerr << "Error: could not read page trace " << argv[1] << endl;
+            return 1;
+        }
+        cout << "Trace: " << argv[1] << " (" << trace.size() << " references)\n\n";
+    } else {
+        trace = build_synthetic_trace(500000, 42);
+        cout << "Trace: synthetic multi-flight (" << trace.size() << " references)\n\n";
+    }
+    if (trace.empty()) {
+        cerr << "Error: empty trace" << endl;
+        return 1;
+    }
+
+    const int frame_counts[] = {64, 128, 256, 512};
+
+    cout << left << setw(10) << "Policy" << right << setw(8) << "Frames"
+         << setw(14) << "Fault rate" << setw(14) << "ns/access" << "\n";
+    cout << string(46, '-') << "\n";
+
+    for (int frames : frame_counts) {
+        vector<ReplacementSim*> sims = {
+            new AwscPpcSim(frames), new ClockSim(frames), new LruSim(frames), new ArcSim(frames)
+        };
+        for (ReplacementSim* sim : sims) {
+            long long faults = 0;
+            auto start = chrono::steady_clock::now();
+            for (const PageTraceRecord& r : trace) {
+                if (!sim->access(r)) faults++;
+            }
+            double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count()
+                        / trace.size();
+
+            cout << left << setw(10) << sim->name() << right << setw(8) << frames
+                 << fixed << setprecision(2)
+                 << setw(13) << (100.0 * faults / trace.size()) << "%"
+                 << setw(14) << ns << "\n";
+            delete sim;
+        }
+        cout << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * runway_bitmap_benchmark.cpp
+ *
+ * Hundreds of requester threads poll allocate_runway (as approaching
+ * flights do) and release what they get, while a dashboard thread polls
+ * get_available_runway_count, at 4, 16 and 64 runways.
+ *
+ * RunwayManager's atomic availability bitmask is compared with the design
+ * it replaced: manager_mutex held while scanning every runway's
+ * is_available() (each taking the runway's own mutex), for both the
+ * allocation search and the count. Both log each allocation and release
+ * the same way.
+ *
+ * Usage: runway_bitmap_benchmark [requesters] [milliseconds_per_run]
+ */
+
+#include "../src/airport/RunwayManager.h"
+#include "../src/core/Logger.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+#include <sched.h>
+
+using namespace std;
+
+static const long long NOW = 1000000;  // Well past any wake separation
+static const int HOLD_SPINS = 2000;    // Work done while holding a runway
+
+// Mutex + scan, as RunwayManager allocated before
+class LegacyRunways {
+    vector<Runway*> runways;
+    pthread_mutex_t manager_mutex;
+public:
+    LegacyRunways(int count) {
+        pthread_mutex_init(&manager_mutex, nullptr);
+        for (int i = 0; i < count; i++) runways.push_back(new Runway(i, "R" + to_string(i)));
+    }
+    ~LegacyRunways() {
+        for (Runway* r : runways) delete r;
+        pthread_mutex_destroy(&manager_mutex);
+    }
+    Runway* allocate_runway(Flight* flight, long long current_time) {
+        pthread_mutex_lock(&manager_mutex);
+        Runway* chosen = nullptr;
+        for (Runway* r : runways) {
+            if (r->is_available()) { chosen = r; break; }
+        }
+        pthread_mutex_unlock(&manager_mutex);
+        if (chosen && chosen->try_reserve(flight, current_time)) {
+            ostringstream log_msg;
+            log_msg << "[RunwayManager] Flight " << flight->flight_id << " allocated runway " << chosen->get_name();
+            Logger::get_instance()->log_event(log_msg.str());
+            return chosen;
+        }
+        return nullptr;
+    }
+    void release_runway(int runway_id, long long current_time) {
+        pthread_mutex_lock(&manager_mutex);
+        for (Runway* r : runways) {
+            if (r->get_id() == runway_id) {
+                pthread_mutex_unlock(&manager_mutex);
+                r->release(current_time);
+                ostringstream log_msg;
+                log_msg << "[RunwayManager] Runway " << r->get_name() << " released";
+                Logger::get_instance()->log_event(log_msg.str());
+                return;
+            }
+        }
+        pthread_mutex_unlock(&manager_mutex);
+    }
+    int get_available_runway_count() {
+        pthread_mutex_lock(&manager_mutex);
+        int count = 0;
+        for (Runway* r : runways) count += r->is_available();
+        pthread_mutex_unlock(&manager_mutex);
+        return count;
+    }
+};
+
+template <typename Runways>
+struct Shared {
+    Runways* runways;
+    atomic<bool> go;
+    atomic<bool> stop;
+    atomic<long long> attempts;
+    atomic<long long> granted;
+    atomic<long long> polls;
+};
+
+template <typename Runways>
+struct RequesterArgs {
+    Shared<Runways>* shared;
+    Flight* flight;
+};
+
+template <typename Runways>
+static void* requester(void* arg) {
+    RequesterArgs<Runways>* a = static_cast<RequesterArgs<Runways>*>(arg);
+    Shared<Runways>* s = a->shared;
+    while (!s->go.load()) sched_yield();
+
+    long long attempts = 0, granted = 0;
+    volatile int sink = 0;
+    while (!s->stop.load(memory_order_relaxed)) {
+        Runway* r = s->runways->allocate_runway(a->flight, NOW);
+        attempts++;
+        if (r) {
+            for (int k = 0; k < HOLD_SPINS; k++) sink += k;
+            s->runways->release_runway(r->get_id(), 0);
+            granted++;
+        } else {
+            sched_yield();  // Flights back off before asking again
+        }
+    }
+    s->attempts += attempts;
+    s->granted += granted;
+    return nullptr;
+}
+
+template <typename Runways>
+static void* dashboard(void* arg) {
+    Shared<Runways>* s = static_cast<Shared<Runways>*>(arg);
+    while (!s->go.load()) sched_yield();
+    long long polls = 0;
+    volatile int sink = 0;
+    while (!s->stop.load(memory_order_relaxed)) {
+        sink += s->runways->get_available_runway_count();
+        polls++;
+    }
+    s->polls = polls;
+    return nullptr;
+}
+
+template <typename Runways>
+static void run(const char* name, Runways* runways, const vector<Flight*>& flights, int millis) {
+    Shared<Runways> s;
+    s.runways = runways;
+    s.go = false;
+    s.stop = false;
+    s.attempts = 0;
+    s.granted = 0;
+    s.polls = 0;
+
+    int threads = flights.size();
+    vector<pthread_t> tids(threads);
+    vector<RequesterArgs<Runways>> args(threads);
+    for (int t = 0; t < threads; t++) {
+        args[t].shared = &s;
+        args[t].flight = flights[t];
+        pthread_create(&tids[t], nullptr, requester<Runways>, &args[t]);
+    }
+    pthread_t dash;
+    pthread_create(&dash, nullptr, dashboard<Runways>, &s);
+
+    auto start = chrono::steady_clock::now();
+    s.go = true;
+    usleep(millis * 1000);
+    s.stop = true;
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], nullptr);
+    pthread_join(dash, nullptr);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "  " << left << setw(22) << name << right
+         << setw(9) << s.attempts / seconds / 1e6 << " M allocate/s  "
+         << setw(9) << s.granted / seconds / 1e3 << " k granted/s  "
+         << setw(9) << s.polls / seconds / 1e6 << " M count polls/s\n";
+}
+
+int main(int argc, char** argv) {
+    int requesters = argc > 1 ? atoi(argv[1]) : 256;
+    int millis = argc > 2 ? atoi(argv[2]) : 500;
+    if (requesters <= 0 || millis <= 0) {
+        cerr << "Usage: runway_bitmap_benchmark [requesters] [milliseconds_per_run]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║         Runway Bitmap Benchmark - Concurrent Requesters       ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << requesters << " requester threads + 1 dashboard poller, " << millis << " ms per run\n";
+    cout << "(allocations are logged to logs/events.log)\n\n";
+    cout << fixed << setprecision(2);
+
+    Aircraft aircraft(A320);
+    vector<Flight*> flights;
+    for (int t = 0; t < requesters; t++) {
+        flights.push_back(new Flight("BM" + to_string(t), &aircraft, DOMESTIC, 0, 0));
+    }
+
+    const int sizes[] = {4, 16, RunwayManager::MAX_RUNWAYS};
+    for (int count : sizes) {
+        cout << count << " runways:\n";
+
+        RunwayManager manager;
+        for (int i = 0; i < count; i++) manager.add_runway(new Runway(i, "R" + to_string(i)));
+        run("Atomic bitmap", &manager, flights, millis);
+
+        LegacyRunways legacy(count);
+        run("Mutex + scan", &legacy, flights, millis);
+        cout << "\n";
+    }
+
+    for (Flight* f : flights) delete f;
+    return 0;
+}
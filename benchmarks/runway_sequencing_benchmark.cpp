@@ -0,0 +1,135 @@
+/**
+ * runway_sequencing_benchmark.cpp
+ *
+ * Replays random arrival banks (a burst of flights with a mixed heavy /
+ * medium / light fleet and a few emergencies) against four runways and
+ * compares the total priority-weighted landing delay of:
+ *
+ *   - first free runway, first come first served: how RunwayManager
+ *     picked runways before (first runway that can take the flight, in
+ *     arrival order)
+ *   - RunwaySequencer: constrained position shifting with a rolling-horizon
+ *     search, at a few max_shift / lookahead settings
+ *
+ * Wake separation and landing occupancy match the simulation (Runway's
+ * separation table, 30 time units per landing).
+ *
+ * Usage: runway_sequencing_benchmark [banks] [flights_per_bank]
+ */
+
+#include "../src/airport/RunwaySequencer.h"
+#include "../src/airport/Runway.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+
+using namespace std;
+
+static const int RUNWAYS = 4;
+static const long long OCCUPANCY = 30;
+
+static vector<SequenceRequest> make_bank(int flights, unsigned seed) {
+    srand(seed);
+    vector<SequenceRequest> bank;
+    long long t = 0;
+    for (int i = 0; i < flights; i++) {
+        SequenceRequest f;
+        f.key = i;
+        int mix = rand() % 10;
+        f.weight_class = mix < 3 ? HEAVY : (mix < 8 ? MEDIUM : LIGHT);
+        t += rand() % 25;  // Peak bank: a flight every ~12 time units
+        f.earliest_time = t;
+        f.priority = (rand() % 40 == 0) ? 0 : 20 + rand() % 80;
+        bank.push_back(f);
+    }
+    return bank;
+}
+
+static vector<RunwayState> idle_runways() {
+    RunwayState idle;
+    idle.free_at = 0;
+    idle.last_release = -1000;  // Long enough ago that no wake remains
+    idle.last_class = LIGHT;
+    return vector<RunwayState>(RUNWAYS, idle);
+}
+
+// Arrival order, each flight on the first runway (by index) it can use
+// soonest - the old allocate_runway loop, ignoring polling delays
+static long long legacy_delay(vector<SequenceRequest> bank) {
+    stable_sort(bank.begin(), bank.end(), [](const SequenceRequest& a, const SequenceRequest& b) {
+        return a.earliest_time < b.earliest_time;
+    });
+    vector<RunwayState> runways = idle_runways();
+    long long total = 0;
+    for (const SequenceRequest& f : bank) {
+        int chosen = -1;
+        long long chosen_time = LLONG_MAX;
+        for (int r = 0; r < RUNWAYS; r++) {
+            long long t = max(f.earliest_time, runways[r].free_at);
+            t = max(t, runways[r].last_release + Runway::wake_separation(runways[r].last_class, f.weight_class));
+            if (t == f.earliest_time || t < chosen_time) {
+                chosen = r;
+                chosen_time = t;
+                if (t == f.earliest_time) break;  // First runway free right now
+            }
+        }
+        runways[chosen].free_at = chosen_time + OCCUPANCY;
+        runways[chosen].last_release = chosen_time + OCCUPANCY;
+        runways[chosen].last_class = f.weight_class;
+        total += RunwaySequencer::weight(f.priority) * (chosen_time - f.earliest_time);
+    }
+    return total;
+}
+
+static long long weighted_delay(const vector<SequenceRequest>& bank, const vector<SequenceSlot>& slots) {
+    long long total = 0;
+    for (const SequenceSlot& s : slots) {
+        total += RunwaySequencer::weight(bank[s.key].priority) * s.delay;
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    int banks = argc > 1 ? atoi(argv[1]) : 200;
+    int flights = argc > 2 ? atoi(argv[2]) : 40;
+    if (banks <= 0 || flights <= 0) {
+        cerr << "Usage: runway_sequencing_benchmark [banks] [flights_per_bank]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║       Runway Sequencing Benchmark - Peak Arrival Banks        ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << banks << " banks x " << flights << " arrivals on " << RUNWAYS << " runways\n\n";
+    cout << fixed << setprecision(2);
+
+    long long legacy_total = 0;
+    for (int b = 0; b < banks; b++) {
+        legacy_total += legacy_delay(make_bank(flights, 1000 + b));
+    }
+    cout << "First free runway (FCFS):\n";
+    cout << "  weighted delay: " << (double)legacy_total / banks << " per bank\n\n";
+
+    // (max_shift, lookahead); the first is the RunwayManager default
+    const int configs[][2] = {{1, 3}, {1, 2}, {1, 4}, {2, 3}};
+    for (const auto& config : configs) {
+        RunwaySequencer sequencer(config[0], config[1], OCCUPANCY);
+        long long total = 0;
+        vector<SequenceSlot> slots;
+        for (int b = 0; b < banks; b++) {
+            vector<SequenceRequest> bank = make_bank(flights, 1000 + b);
+            sequencer.sequence(bank, idle_runways(), slots);
+            total += weighted_delay(bank, slots);
+        }
+        cout << "Sequencer (max shift " << config[0] << ", lookahead " << config[1] << "):\n";
+        cout << "  weighted delay: " << (double)total / banks << " per bank ("
+             << 100.0 * (legacy_total - total) / max(legacy_total, 1LL) << "% less)\n";
+        cout << "  decision time:  " << sequencer.get_average_decision_us() << " us per flight\n\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * schedule_ingest_benchmark.cpp
+ *
+ * Writes a day's timetable as CSV (default 50000 flights, HH:MM times) and
+ * loads it into flights and arrival events two ways:
+ *
+ *   - legacy: ifstream + getline, stringstream field splitting and stoll,
+ *     new Aircraft / new Flight per row, EventQueue::push per event - how
+ *     a loader in the old engine style would look
+ *   - streaming: ScheduleReader over the memory-mapped file,
+ *     FlightRegistry::create with the shared aircraft table, and one
+ *     EventQueue::push_bulk heapify
+ *
+ * Reports parse throughput, flight creation, event insertion and total
+ * load time.
+ *
+ * Usage: schedule_ingest_benchmark [flights] [csv_path]
+ */
+
+#include "../src/data/ScheduleReader.h"
+#include "../src/airport/FlightRegistry.h"
+#include "../src/core/EventQueue.h"
+#include "../src/core/FlightEvents.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace std;
+
+static const char* AIRLINES[] = {"AA", "UA", "DL", "BA", "LH", "AF", "EK", "QR", "SQ", "CX"};
+static const char* TYPES[] = {"A380", "B777", "B737", "A320", "B777F", "G650", "Falcon 7X"};
+
+static double elapsed_ms(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void write_schedule(const string& path, int flights) {
+    srand(12);
+    ofstream out(path);
+    out << "flight_id,aircraft_type,flight_type,arrival,departure\n";
+    char line[96];
+    for (int f = 0; f < flights; f++) {
+        int arrival = 5 * 3600 + (long long)f * 19 * 3600 / flights;    // 05:00 to 24:00
+        int departure = arrival + 2400 + rand() % 5400;
+        snprintf(line, sizeof(line), "%s%d,%s,%s,%02d:%02d:%02d,%02d:%02d:%02d\n",
+                 AIRLINES[rand() % 10], 100 + f, TYPES[rand() % 7], rand() % 2 ? "INTERNATIONAL" : "DOMESTIC",
+                 arrival / 3600, arrival / 60 % 60, arrival % 60,
+                 departure / 3600, departure / 60 % 60, departure % 60);
+        out << line;
+    }
+}
+
+// ----- Legacy loader pieces -----
+
+static AircraftType legacy_aircraft(const string& name) {
+    if (name == "A380") return A380;
+    if (name == "B777") return B777;
+    if (name == "B747F") return B747F;
+    if (name == "B777F") return B777F;
+    if (name == "B737") return B737;
+    if (name == "A320") return A320;
+    if (name == "G650") return G650;
+    if (name == "Falcon 7X") return FALCON_7X;
+    return EMERGENCY;
+}
+
+static long long legacy_time(const string& text) {
+    stringstream ss(text);
+    string part;
+    long long seconds = 0;
+    while (getline(ss, part, ':')) {
+        seconds = seconds * 60 + stoll(part);
+    }
+    return seconds;
+}
+
+struct LegacyRow {
+    string flight_id;
+    AircraftType aircraft_type;
+    FlightType flight_type;
+    long long arrival_time;
+    long long departure_time;
+};
+
+static void drain(EventQueue& queue) {
+    while (Event* event = queue.pop()) {
+        delete event;
+    }
+}
+
+int main(int argc, char** argv) {
+    int flights = argc > 1 ? atoi(argv[1]) : 50000;
+    string path = argc > 2 ? argv[2] : "schedule_ingest_benchmark.csv";
+    if (flights <= 0) {
+        cerr << "Usage: schedule_ingest_benchmark [flights] [csv_path]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║        Schedule Ingest Benchmark - Daily Timetable            ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(2);
+
+    write_schedule(path, flights);
+    ifstream probe(path, ios::binary | ios::ate);
+    double mb = probe.tellg() / (1024.0 * 1024.0);
+    probe.close();
+    cout << flights << " flights, " << mb << " MB CSV (" << path << ")\n\n";
+
+    // ----- Legacy: getline + stringstream, per-row allocation, push each -----
+    auto start = chrono::steady_clock::now();
+    vector<LegacyRow> legacy_rows;
+    {
+        ifstream in(path);
+        string line;
+        getline(in, line);      // Header
+        while (getline(in, line)) {
+            stringstream ss(line);
+            vector<string> fields;
+            string field;
+            while (getline(ss, field, ',')) fields.push_back(field);
+            if (fields.size() != 5) continue;
+            LegacyRow row;
+            row.flight_id = fields[0];
+            row.aircraft_type = legacy_aircraft(fields[1]);
+            row.flight_type = fields[2] == "INTERNATIONAL" ? INTERNATIONAL : DOMESTIC;
+            row.arrival_time = legacy_time(fields[3]);
+            row.departure_time = legacy_time(fields[4]);
+            legacy_rows.push_back(row);
+        }
+    }
+    double legacy_parse = elapsed_ms(start);
+    auto phase = chrono::steady_clock::now();
+    vector<Flight*> legacy_flights;
+    for (const LegacyRow& row : legacy_rows) {
+        legacy_flights.push_back(new Flight(row.flight_id, new Aircraft(row.aircraft_type), row.flight_type,
+                                            row.arrival_time, row.departure_time));
+    }
+    double legacy_create = elapsed_ms(phase);
+    phase = chrono::steady_clock::now();
+    EventQueue legacy_queue;
+    for (Flight* flight : legacy_flights) {
+        legacy_queue.push(new FlightArrivalEvent(flight, nullptr, flight->scheduled_arrival_time));
+    }
+    double legacy_insert = elapsed_ms(phase);
+    double legacy_total = elapsed_ms(start);
+
+    // ----- Streaming: mmap reader, registry, bulk insert -----
+    // A parse-only pass first, to split parsing from flight creation
+    ScheduleReader reader;
+    ScheduleRow row;
+    start = chrono::steady_clock::now();
+    if (!reader.open(path)) {
+        cerr << "Could not open " << path << endl;
+        return 1;
+    }
+    int parsed = 0;
+    while (reader.next(row)) parsed++;
+    double stream_parse = elapsed_ms(start);
+
+    start = chrono::steady_clock::now();
+    reader.open(path);
+    FlightRegistry registry;
+    vector<Flight*> flights_loaded;
+    while (reader.next(row)) {
+        flights_loaded.push_back(registry.create(row.flight_id, row.aircraft_type, row.flight_type,
+                                                 row.arrival_time, row.departure_time));
+    }
+    double stream_create = elapsed_ms(start) - stream_parse;
+    phase = chrono::steady_clock::now();
+    vector<Event*> arrivals;
+    arrivals.reserve(flights_loaded.size());
+    for (Flight* flight : flights_loaded) {
+        arrivals.push_back(new FlightArrivalEvent(flight, nullptr, flight->scheduled_arrival_time));
+    }
+    EventQueue queue;
+    queue.push_bulk(arrivals);
+    double stream_insert = elapsed_ms(phase);
+    double stream_total = elapsed_ms(start);
+
+    // Both queues must hand out the same first arrival
+    Event* first_legacy = legacy_queue.peek();
+    Event* first_stream = queue.peek();
+    bool same_head = first_legacy && first_stream && first_legacy->get_time() == first_stream->get_time();
+
+    cout << "                 parse       create      insert      total\n";
+    cout << "  legacy:    " << setw(8) << legacy_parse << " ms " << setw(8) << legacy_create << " ms "
+         << setw(8) << legacy_insert << " ms " << setw(8) << legacy_total << " ms\n";
+    cout << "  streaming: " << setw(8) << stream_parse << " ms " << setw(8) << stream_create << " ms "
+         << setw(8) << stream_insert << " ms " << setw(8) << stream_total << " ms\n\n";
+    cout << "Parse throughput: " << mb * 1000 / legacy_parse << " MB/s legacy, "
+         << mb * 1000 / stream_parse << " MB/s streaming\n";
+    cout << "Rows: " << legacy_rows.size() << " legacy, " << parsed << " streaming ("
+         << reader.get_error_count() << " rejected); queue heads match: " << (same_head ? "yes" : "NO") << "\n";
+
+    drain(legacy_queue);
+    drain(queue);
+    for (Flight* flight : legacy_flights) {
+        delete flight->aircraft;
+        delete flight;
+    }
+    remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * service_executor_benchmark.cpp
+ *
+ * Runs the standard 15-service turnaround DAG through two executors:
+ *
+ *   - legacy: the old ServiceExecutor - one service at a time on the
+ *     calling thread, ready services found by re-scanning every service
+ *     against the completed list (which queues the same service again
+ *     while it is still ready), 10ms polling when nothing is ready
+ *   - pool: ServiceExecutor with in-degree counters, a critical-path-first
+ *     ready queue and a worker pool
+ *
+ * Service work is slept at a reduced time scale. The legacy copy retries
+ * after an equipment failure like the pool does; as written it left the
+ * service in SVC_EQUIPMENT_FAILURE and spun forever.
+ *
+ * Reports simulated turnaround length (minutes), wall time, duplicate
+ * queue entries, and a batch of turnarounds sharing one pool. The legacy
+ * clock also advances for every duplicate entry it pops, which is why its
+ * simulated length is far above the 249 minutes of serial work.
+ *
+ * Usage: service_executor_benchmark [turnarounds] [us_per_minute] [workers]
+ */
+
+#include "../src/services/ServiceExecutor.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+
+static double elapsed_ms(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// ----- Legacy executor (sequential, O(n^2) ready scan) -----
+
+struct LegacyExecutor {
+    ServiceDependencyGraph* dep_graph;
+    int us_per_minute;
+    vector<GroundService*> all_services;
+    vector<GroundService*> completed_services;
+    queue<GroundService*> ready_queue;
+    int duplicates = 0;
+
+    LegacyExecutor(ServiceDependencyGraph* graph, int scale) : dep_graph(graph), us_per_minute(scale) {}
+
+    ~LegacyExecutor() {
+        for (GroundService* svc : all_services) delete svc;
+    }
+
+    void create_turnaround_services(int flight_id, int gate_id) {
+        int id = 0;
+        vector<ServiceType> order = dep_graph->get_execution_order();
+        for (ServiceType type : order) {
+            GroundService* service = new GroundService(id++, type, flight_id, gate_id);
+            vector<ServiceType> deps = dep_graph->get_dependencies(type);
+            for (ServiceType dep : deps) service->add_dependency(dep);
+            all_services.push_back(service);
+        }
+    }
+
+    void update_ready_queue() {
+        for (GroundService* svc : all_services) {
+            if (svc->get_status() == SVC_PENDING && svc->dependencies_met(completed_services)) {
+                ready_queue.push(svc);
+            }
+        }
+    }
+
+    GroundService* get_next_ready() {
+        update_ready_queue();
+        GroundService* next = nullptr;
+        if (!ready_queue.empty()) {
+            next = ready_queue.front();
+            ready_queue.pop();
+        }
+        return next;
+    }
+
+    bool execute_service(GroundService* service, long long current_time) {
+        while (!service->start(current_time)) {
+            if (service->get_status() != SVC_EQUIPMENT_FAILURE) return false;
+            usleep(service->get_recovery_time() * us_per_minute);
+            current_time += service->get_recovery_time();
+            if (!service->attempt_recovery()) {
+                completed_services.push_back(service);   // Count it so the loop ends
+                return false;
+            }
+        }
+        usleep(service->get_duration() * us_per_minute);
+        service->complete(current_time + service->get_duration());
+        completed_services.push_back(service);
+        return true;
+    }
+
+    long long execute_all(long long start_time) {
+        long long current = start_time;
+        long long finish = start_time;
+        while (completed_services.size() < all_services.size()) {
+            GroundService* next = get_next_ready();
+            if (next != nullptr) {
+                if (next->get_status() != SVC_PENDING) duplicates++;
+                execute_service(next, current);
+                current += next->get_duration();
+                finish = max(finish, next->get_end_time());
+            } else {
+                usleep(10000);
+            }
+        }
+        return finish - start_time;
+    }
+};
+
+int main(int argc, char** argv) {
+    int turnarounds = argc > 1 ? atoi(argv[1]) : 20;
+    int scale = argc > 2 ? atoi(argv[2]) : 200;
+    int workers = argc > 3 ? atoi(argv[3]) : ServiceExecutor::DEFAULT_WORKERS;
+    if (turnarounds <= 0 || scale < 0 || workers <= 0) {
+        cerr << "Usage: service_executor_benchmark [turnarounds] [us_per_minute] [workers]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║        Service Executor Benchmark - Turnaround DAG            ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(1);
+
+    ServiceDependencyGraph graph;
+    graph.build_standard_turnaround();
+    int total_work = 0;
+    for (int i = 0; i < SERVICE_TYPE_COUNT; i++) {
+        total_work += GroundService::get_default_duration((ServiceType)i);
+    }
+    cout << SERVICE_TYPE_COUNT << " services, " << total_work << " min of work, critical path "
+         << graph.get_critical_path_length() << " min; " << turnarounds << " turnarounds at "
+         << scale << " us/min, " << workers << " workers\n\n";
+
+    // ----- One turnaround at a time -----
+    double legacy_minutes = 0, legacy_wall = 0;
+    int legacy_duplicates = 0;
+    for (int t = 0; t < turnarounds; t++) {
+        LegacyExecutor legacy(&graph, scale);
+        legacy.create_turnaround_services(t, t % 8);
+        auto start = chrono::steady_clock::now();
+        legacy_minutes += legacy.execute_all(0);
+        legacy_wall += elapsed_ms(start);
+        legacy_duplicates += legacy.duplicates;
+    }
+
+    double pool_minutes = 0, pool_wall = 0;
+    int pool_failed = 0;
+    for (int t = 0; t < turnarounds; t++) {
+        ServiceExecutor executor(&graph, workers);
+        executor.set_time_scale(scale);
+        executor.create_turnaround_services(t, t % 8);
+        auto start = chrono::steady_clock::now();
+        executor.execute_all(0);
+        pool_wall += elapsed_ms(start);
+        pool_minutes += executor.get_makespan();
+        pool_failed += executor.get_failed_count();
+    }
+
+    cout << "Per turnaround      sim minutes    wall ms    duplicate entries\n";
+    cout << "  legacy:       " << setw(12) << legacy_minutes / turnarounds << setw(11)
+         << legacy_wall / turnarounds << setw(12) << legacy_duplicates / (double)turnarounds << "\n";
+    cout << "  pool:         " << setw(12) << pool_minutes / turnarounds << setw(11)
+         << pool_wall / turnarounds << setw(12) << 0.0 << "\n\n";
+
+    // ----- All turnarounds sharing one pool -----
+    ServiceExecutor batch(&graph, workers * 2);
+    batch.set_time_scale(scale);
+    for (int t = 0; t < turnarounds; t++) {
+        batch.create_turnaround_services(t, t % 8);
+    }
+    auto start = chrono::steady_clock::now();
+    batch.execute_all(0);
+    double batch_wall = elapsed_ms(start);
+
+    cout << "Batch of " << turnarounds << " on " << workers * 2 << " workers: " << batch_wall
+         << " ms wall (legacy, one after another: " << legacy_wall << " ms), "
+         << batch.get_completed_count() << "/" << batch.get_total_count() << " services completed\n";
+    cout << "Services failed after retries: " << pool_failed << " single, "
+         << batch.get_failed_count() << " batch (incl. dependents)\n";
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * superpage_benchmark.cpp
+ *
+ * Measures how superpage promotion cuts TLB pressure for large, contiguous
+ * flight data. Each flight maps a passenger manifest of several superpage
+ * runs (contiguous, aligned frames) plus a handful of scattered base pages
+ * (crew, gate and fuel records). Accesses are random across flights.
+ *
+ * Midway through, single manifest pages of some flights are evicted and
+ * re-faulted, which demotes and later re-promotes their runs.
+ *
+ * The same workload is replayed with promotion disabled for comparison.
+ *
+ * Usage: superpage_benchmark [flights] [accesses]
+ */
+
+#include "../src/memory/PageTable.h"
+#include "../src/memory/TLB.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+static const int TLB_ENTRIES = 64;
+static const int SUPERPAGE_PAGES = TLB::DEFAULT_SUPERPAGE_PAGES;
+static const int MANIFEST_PAGES = 4 * SUPERPAGE_PAGES;  // 8 MiB manifest
+static const int RECORD_PAGES = 5;                      // Small per-flight records
+static const int RECORD_BASE = 1 << 20;                 // Page id of first record
+
+struct RunResult {
+    long long accesses;
+    int misses;
+    int superpage_hits;
+    double average_reach;
+    int promotions;
+    int demotions;
+    double ns_per_access;
+};
+
+static RunResult run(int flights, long long accesses, int superpage_size, unsigned seed) {
+    srand(seed);
+    TLB tlb(TLB_ENTRIES, SUPERPAGE_PAGES);
+    vector<PageTable*> tables;
+
+    // Map flight data: manifests get aligned contiguous frames,
+    // records get scattered frames from a separate range
+    int next_frame = 0;
+    int next_record_frame = flights * MANIFEST_PAGES;
+    for (int f = 0; f < flights; f++) {
+        PageTable* pt = new PageTable(f, superpage_size);
+        pt->attach_tlb(&tlb);
+        for (int p = 0; p < MANIFEST_PAGES; p++) {
+            pt->add_entry(p, next_frame++);
+        }
+        for (int p = 0; p < RECORD_PAGES; p++) {
+            pt->add_entry(RECORD_BASE + p, next_record_frame + p * 7);
+        }
+        next_record_frame += RECORD_PAGES * 7;
+        tables.push_back(pt);
+    }
+
+    double reach_sum = 0;
+    int reach_samples = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < accesses; i++) {
+        int f = rand() % flights;
+        PageTable* pt = tables[f];
+        int page = (rand() % 5 == 0) ? RECORD_BASE + rand() % RECORD_PAGES
+                                     : rand() % MANIFEST_PAGES;
+
+        // Partial eviction halfway through: demote one run per 4 flights
+        if (i == accesses / 2) {
+            for (int e = 0; e < flights; e += 4) {
+                int victim = ((e / 4) % 4) * SUPERPAGE_PAGES + 17;
+                tables[e]->remove_entry(victim);
+                tlb.invalidate(e, victim);
+                // Refault into the same frame - run becomes promotable again
+                tables[e]->add_entry(victim, e * MANIFEST_PAGES + victim);
+            }
+        }
+
+        if (tlb.lookup(f, page) < 0) {
+            // TLB miss - walk the page table, refill the widest mapping
+            int region, frame_base;
+            if (pt->get_superpage_mapping(page, region, frame_base)) {
+                tlb.insert_superpage(f, region, frame_base);
+            } else {
+                PageTableEntry* entry = pt->lookup(page);
+                if (entry) {
+                    tlb.insert(f, page, entry->frame_id);
+                }
+            }
+        }
+
+        if ((i & 1023) == 0) {
+            reach_sum += tlb.get_reach_pages();
+            reach_samples++;
+        }
+    }
+    auto end = chrono::steady_clock::now();
+
+    RunResult result;
+    result.accesses = accesses;
+    result.misses = tlb.get_misses();
+    result.superpage_hits = tlb.get_superpage_hits();
+    result.average_reach = reach_samples ? reach_sum / reach_samples : 0.0;
+    result.promotions = 0;
+    result.demotions = 0;
+    for (PageTable* pt : tables) {
+        result.promotions += pt->get_promotions();
+        result.demotions += pt->get_demotions();
+        delete pt;
+    }
+    result.ns_per_access = chrono::duration<double, nano>(end - start).count() / accesses;
+    return result;
+}
+
+static void print_result(const char* name, const RunResult& r) {
+    cout << name << ":\n";
+    cout << "  TLB misses:      " << r.misses << "\n";
+    cout << "  miss rate:       " << 100.0 * r.misses / r.accesses << "%\n";
+    cout << "  superpage hits:  " << r.superpage_hits << "\n";
+    cout << "  average reach:   " << r.average_reach << " pages ("
+         << r.average_reach * 4 / 1024 << " MiB)\n";
+    cout << "  promotions:      " << r.promotions << "\n";
+    cout << "  demotions:       " << r.demotions << "\n";
+    cout << "  ns/access:       " << r.ns_per_access << "\n\n";
+}
+
+int main(int argc, char** argv) {
+    int flights = argc > 1 ? atoi(argv[1]) : 24;
+    long long accesses = argc > 2 ? atoll(argv[2]) : 2000000;
+    if (flights <= 0 || accesses <= 0) {
+        cerr << "Usage: superpage_benchmark [flights] [accesses]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║           Superpage Benchmark - Passenger Manifests           ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << "Flights: " << flights << " x " << MANIFEST_PAGES << " manifest pages + "
+         << RECORD_PAGES << " record pages, " << TLB_ENTRIES << "-entry TLB, "
+         << SUPERPAGE_PAGES << "-page superpages, " << accesses << " accesses\n\n";
+
+    cout << fixed << setprecision(3);
+    RunResult base = run(flights, accesses, 0, 42);
+    RunResult super = run(flights, accesses, SUPERPAGE_PAGES, 42);
+    print_result("Base pages only", base);
+    print_result("With superpage promotion", super);
+
+    if (base.misses > 0) {
+        cout << "Miss reduction:    " << 100.0 * (base.misses - super.misses) / base.misses << "%\n";
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * taxi_routing_benchmark.cpp
+ *
+ * Builds a 2000-node airport taxiway graph (50x40 grid of junctions with
+ * random segment times, 100 gate stands and 8 runway exits) and times
+ * routing queries:
+ *
+ *   - gate <-> runway: TaxiwayGraph's precomputed next-hop tables
+ *   - junction -> junction: A* with landmark lower bounds over CSR
+ *   - the unweighted BFS find_path used before (unordered_map/set per
+ *     call), which also returns slower routes since it ignores weights
+ *
+ * Usage: taxi_routing_benchmark [queries]
+ */
+
+#include "../src/airport/TaxiwayGraph.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+static const int GRID_W = 50, GRID_H = 40;
+static const int GATES = 100, RUNWAY_EXITS = 8;
+static const int GATE_BASE = 10000, EXIT_BASE = 20000;
+
+// Unweighted BFS, as TaxiwayGraph::find_path was implemented before
+class LegacyRouter {
+    unordered_map<int, vector<int>> adjacency_list;
+public:
+    void add_edge(int from, int to) { adjacency_list[from].push_back(to); }
+    vector<int> find_path(int from, int to) {
+        vector<int> path;
+        if (from == to) { path.push_back(from); return path; }
+        queue<int> q;
+        unordered_map<int, int> parent;
+        unordered_set<int> visited;
+        q.push(from);
+        visited.insert(from);
+        parent[from] = -1;
+        bool found = false;
+        while (!q.empty() && !found) {
+            int current = q.front();
+            q.pop();
+            if (adjacency_list.find(current) != adjacency_list.end()) {
+                for (int neighbor : adjacency_list[current]) {
+                    if (visited.find(neighbor) == visited.end()) {
+                        visited.insert(neighbor);
+                        parent[neighbor] = current;
+                        q.push(neighbor);
+                        if (neighbor == to) { found = true; break; }
+                    }
+                }
+            }
+        }
+        if (found) {
+            for (int c = to; c != -1; c = parent[c]) path.push_back(c);
+            reverse(path.begin(), path.end());
+        }
+        return path;
+    }
+};
+
+static unordered_map<long long, int> edge_weight;
+
+static void connect(TaxiwayGraph& graph, LegacyRouter& legacy, int a, int b, int weight) {
+    graph.add_edge(a, b, weight);
+    graph.add_edge(b, a, weight);
+    legacy.add_edge(a, b);
+    legacy.add_edge(b, a);
+    edge_weight[(long long)a << 32 | b] = weight;
+    edge_weight[(long long)b << 32 | a] = weight;
+}
+
+static long long path_time(const vector<int>& path) {
+    long long total = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        total += edge_weight[(long long)path[i - 1] << 32 | path[i]];
+    }
+    return total;
+}
+
+static double elapsed_us(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int queries = argc > 1 ? atoi(argv[1]) : 20000;
+    if (queries <= 0) {
+        cerr << "Usage: taxi_routing_benchmark [queries]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║          Taxi Routing Benchmark - 2000-Node Airport           ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(2);
+
+    srand(11);
+    TaxiwayGraph graph;
+    LegacyRouter legacy;
+    for (int i = 0; i < GRID_W * GRID_H; i++) graph.add_node(i, "J" + to_string(i));
+    for (int y = 0; y < GRID_H; y++) {
+        for (int x = 0; x < GRID_W; x++) {
+            int node = y * GRID_W + x;
+            if (x + 1 < GRID_W) connect(graph, legacy, node, node + 1, 10 + rand() % 50);
+            if (y + 1 < GRID_H) connect(graph, legacy, node, node + GRID_W, 10 + rand() % 50);
+        }
+    }
+    vector<int> gates, exits;
+    for (int g = 0; g < GATES; g++) {
+        int stand = GATE_BASE + g;
+        graph.add_node(stand, "Gate" + to_string(g));
+        connect(graph, legacy, stand, (g % 2 ? GRID_H / 2 * GRID_W : 0) + g / 2, 15);
+        graph.mark_endpoint(stand);
+        gates.push_back(stand);
+    }
+    for (int r = 0; r < RUNWAY_EXITS; r++) {
+        int exit = EXIT_BASE + r;
+        graph.add_node(exit, "Exit" + to_string(r));
+        connect(graph, legacy, exit, (GRID_H - 1) * GRID_W + r * (GRID_W - 1) / (RUNWAY_EXITS - 1), 40);
+        graph.mark_endpoint(exit);
+        exits.push_back(exit);
+    }
+
+    auto start = chrono::steady_clock::now();
+    graph.build_routes();
+    double build_ms = elapsed_us(start) / 1000;
+    cout << graph.get_node_count() << " nodes, " << GATES + RUNWAY_EXITS << " endpoints\n";
+    cout << "Routing tables built in " << build_ms << " ms\n\n";
+
+    // Gate <-> runway queries
+    vector<pair<int, int>> gate_runway;
+    for (int q = 0; q < queries; q++) {
+        int gate = gates[rand() % GATES], exit = exits[rand() % RUNWAY_EXITS];
+        gate_runway.push_back(q % 2 ? make_pair(gate, exit) : make_pair(exit, gate));
+    }
+    size_t hops = 0;
+    start = chrono::steady_clock::now();
+    for (const auto& q : gate_runway) hops += graph.find_path(q.first, q.second).size();
+    double table_us = elapsed_us(start) / queries;
+
+    // Arbitrary junction pairs
+    vector<pair<int, int>> junctions;
+    for (int q = 0; q < queries; q++) {
+        junctions.push_back(make_pair(rand() % (GRID_W * GRID_H), rand() % (GRID_W * GRID_H)));
+    }
+    start = chrono::steady_clock::now();
+    for (const auto& q : junctions) graph.find_path(q.first, q.second);
+    double astar_us = elapsed_us(start) / queries;
+
+    // Old BFS on a sample (it is much slower)
+    int sample = min(queries, 2000);
+    long long bfs_time = 0, optimal_time = 0;
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < sample; q++) bfs_time += path_time(legacy.find_path(gate_runway[q].first, gate_runway[q].second));
+    double bfs_us = elapsed_us(start) / sample;
+    for (int q = 0; q < sample; q++) optimal_time += path_time(graph.find_path(gate_runway[q].first, gate_runway[q].second));
+
+    cout << "Gate <-> runway route:\n";
+    cout << "  next-hop table: " << table_us << " us\n";
+    cout << "  BFS (old):      " << bfs_us << " us\n";
+    cout << "  taxi time:      " << (double)optimal_time / sample << " s weighted vs "
+         << (double)bfs_time / sample << " s on BFS routes\n\n";
+    cout << "Junction -> junction route:\n";
+    cout << "  A* (landmarks): " << astar_us << " us\n";
+    cout << "  (gate routes average " << (double)hops / queries << " nodes)\n";
+
+    return 0;
+}
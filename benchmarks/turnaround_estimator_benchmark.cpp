@@ -0,0 +1,219 @@
+/**
+ * turnaround_estimator_benchmark.cpp
+ *
+ * Monte-Carlo turnaround estimation: sampling throughput and the predicted
+ * distribution per aircraft type.
+ *
+ * Throughput is compared two ways, on the same threads and sampling code:
+ *
+ *   - shared generator: every draw goes through one static mt19937 behind
+ *     a mutex (the old GroundService/Crew pattern)
+ *   - per-thread: TurnaroundEstimator, one generator per sampling thread
+ *
+ * Then prints P50/P90 per aircraft type and checks the estimate against
+ * turnarounds actually run on a ServiceScheduler with a crew pool and
+ * ample equipment.
+ *
+ * Usage: turnaround_estimator_benchmark [samples] [threads] [validation_turnarounds] [us_per_minute]
+ */
+
+#include "../src/services/TurnaroundEstimator.h"
+#include "../src/services/ServiceScheduler.h"
+#include "../src/crew/Crew.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <pthread.h>
+
+using namespace std;
+
+static int us_per_minute = 2000;
+
+static double elapsed_ms(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// ----- Shared generator behind a mutex -----
+
+static mt19937 shared_rng(7);
+static pthread_mutex_t shared_rng_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+struct LegacyBatch {
+    const TurnaroundTemplate* plan;
+    const bool* crewed;
+    int samples;
+    vector<float> durations;
+};
+
+static double legacy_draw_recovery() {
+    uniform_int_distribution<int> recovery(GroundService::MIN_RECOVERY_MINUTES, GroundService::MAX_RECOVERY_MINUTES);
+    pthread_mutex_lock(&shared_rng_mutex);
+    double minutes = recovery(shared_rng);
+    pthread_mutex_unlock(&shared_rng_mutex);
+    return minutes;
+}
+
+static bool legacy_draw_failure() {
+    uniform_real_distribution<double> dist(0.0, 1.0);
+    pthread_mutex_lock(&shared_rng_mutex);
+    double roll = dist(shared_rng);
+    pthread_mutex_unlock(&shared_rng_mutex);
+    return roll < GroundService::EQUIPMENT_FAILURE_PROBABILITY;
+}
+
+static double legacy_draw_multiplier() {
+    pthread_mutex_lock(&shared_rng_mutex);
+    SkillLevel level = Crew::draw_skill_level(shared_rng);
+    pthread_mutex_unlock(&shared_rng_mutex);
+    return Crew::multiplier_for(level);
+}
+
+static void* legacy_sample_func(void* arg) {
+    LegacyBatch* batch = static_cast<LegacyBatch*>(arg);
+    const TurnaroundTemplate& plan = *batch->plan;
+    for (int s = 0; s < batch->samples; s++) {
+        double finish[SERVICE_TYPE_COUNT];
+        double duration = 0;
+        bool failed = false;
+        for (int i = 0; i < plan.count && !failed; i++) {
+            double start = 0;
+            for (int p = 0; p < i; p++) {
+                if (plan.predecessors[i] & (1u << p)) start = max(start, finish[p]);
+            }
+            int failures = 0;
+            while (legacy_draw_failure()) {
+                start += legacy_draw_recovery();
+                if (++failures >= GroundService::MAX_RETRIES) {
+                    failed = true;
+                    break;
+                }
+            }
+            double work = GroundService::get_default_duration(plan.order[i]);
+            if (batch->crewed[plan.order[i]]) work /= legacy_draw_multiplier();
+            finish[i] = start + work;
+            duration = max(duration, finish[i]);
+        }
+        if (!failed) batch->durations.push_back((float)duration);
+    }
+    return nullptr;
+}
+
+static double legacy_run(const TurnaroundTemplate& plan, int samples, int threads) {
+    bool crewed[SERVICE_TYPE_COUNT];
+    for (int t = 0; t < SERVICE_TYPE_COUNT; t++) crewed[t] = ServiceScheduler::crew_role_for((ServiceType)t) >= 0;
+    vector<LegacyBatch> batches(threads);
+    vector<pthread_t> workers(threads);
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        batches[t] = {&plan, crewed, samples / threads, {}};
+        pthread_create(&workers[t], nullptr, legacy_sample_func, &batches[t]);
+    }
+    for (pthread_t worker : workers) pthread_join(worker, nullptr);
+    return elapsed_ms(start);
+}
+
+// ----- Validation on the real scheduler -----
+
+struct ValidationArgs {
+    ServiceScheduler* scheduler;
+    int flight_id;
+    TurnaroundCategory category;
+    long long minutes;
+};
+
+static void* validation_func(void* arg) {
+    ValidationArgs* a = static_cast<ValidationArgs*>(arg);
+    TurnaroundReport report = a->scheduler->run_turnaround(a->flight_id, 0, 50, 0, 1000, a->category);
+    a->minutes = report.failed > 0 ? -1 : report.finish_time - report.release_time;
+    return nullptr;
+}
+
+int main(int argc, char** argv) {
+    int samples = argc > 1 ? atoi(argv[1]) : 200000;
+    int threads = argc > 2 ? atoi(argv[2]) : 4;
+    int validation = argc > 3 ? atoi(argv[3]) : 40;
+    us_per_minute = argc > 4 ? atoi(argv[4]) : 2000;
+    if (samples <= 0 || threads <= 0 || validation < 0 || us_per_minute <= 0) {
+        cerr << "Usage: turnaround_estimator_benchmark [samples] [threads] [validation_turnarounds] [us_per_minute]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║    Turnaround Estimator Benchmark - Monte-Carlo P50 / P90     ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(1);
+
+    ServiceDependencyGraph graph;
+    graph.build_standard_turnaround();
+    TurnaroundEstimator estimator(&graph, threads);
+    estimator.set_seed(7);
+    const TurnaroundTemplate& passenger = estimator.get_template(TURNAROUND_PASSENGER);
+
+    // ----- Throughput -----
+    cout << samples << " passenger turnarounds on " << threads << " threads\n\n";
+    double legacy_ms = legacy_run(passenger, samples, threads);
+    auto start = chrono::steady_clock::now();
+    TurnaroundEstimate passenger_estimate = estimator.simulate(TURNAROUND_PASSENGER, samples);
+    double estimator_ms = elapsed_ms(start);
+
+    cout << "                       wall ms    samples/s\n";
+    cout << "  shared generator:" << setw(12) << legacy_ms << setw(13) << (long long)(samples / legacy_ms * 1000) << "\n";
+    cout << "  per-thread:      " << setw(12) << estimator_ms << setw(13) << (long long)(samples / estimator_ms * 1000) << "\n";
+    cout << "\nSpeedup: " << legacy_ms / estimator_ms << "x\n\n";
+
+    // ----- Per aircraft type -----
+    estimator.estimate_all(samples);
+    cout << "  aircraft     category     P50 min   P90 min   mean   crit path   failed %   plan units\n";
+    for (int t = 0; t < EMERGENCY; t++) {
+        const Aircraft* aircraft = Aircraft::get((AircraftType)t);
+        TurnaroundEstimate e = estimator.get_estimate((AircraftType)t);
+        cout << "  " << setw(10) << left << aircraft->get_type_name() << setw(12)
+             << TurnaroundTemplate::category_to_string(e.category) << right
+             << setw(9) << e.p50 << setw(10) << e.p90 << setw(8) << e.mean << setw(11) << e.critical_path
+             << setw(10) << setprecision(2) << e.failure_rate * 100 << setprecision(1)
+             << setw(12) << estimator.get_planning_time(aircraft) << "\n";
+    }
+
+    // ----- Validation -----
+    if (validation > 0) {
+        ResourceManager resources;
+        resources.initialize(validation, validation, 2 * validation, validation, 1, 1, validation);
+        CrewManager crew;
+        crew.initialize(0, 0, 0, 2 * validation, 2 * validation, 2 * validation, validation);
+        ServiceScheduler scheduler(&graph, &resources, &crew, 8 * validation);
+        scheduler.set_time_scale(us_per_minute);
+        scheduler.start();
+
+        vector<ValidationArgs> args(validation);
+        vector<pthread_t> flights(validation);
+        for (int f = 0; f < validation; f++) {
+            args[f] = {&scheduler, f, TURNAROUND_PASSENGER, 0};
+            pthread_create(&flights[f], nullptr, validation_func, &args[f]);
+        }
+        vector<long long> actual;
+        for (int f = 0; f < validation; f++) {
+            pthread_join(flights[f], nullptr);
+            if (args[f].minutes >= 0) actual.push_back(args[f].minutes);
+        }
+        ServiceSchedulerStats stats = scheduler.get_stats();
+        scheduler.stop();
+
+        sort(actual.begin(), actual.end());
+        if (!actual.empty()) {
+            int within = 0;
+            for (long long m : actual) {
+                if (m <= passenger_estimate.p90) within++;
+            }
+            cout << "\nScheduler run (" << actual.size() << " passenger turnarounds, " << us_per_minute << " us/min): P50 "
+                 << actual[(actual.size() - 1) / 2] << " min, P90 " << actual[(actual.size() - 1) * 9 / 10]
+                 << " min; " << 100.0 * within / actual.size() << "% within the estimated P90 of "
+                 << passenger_estimate.p90 << "\n";
+            cout << "(" << stats.crew_waits << " services waited for crew, " << stats.resource_waits
+                 << " for equipment)\n";
+        }
+    }
+    return 0;
+}
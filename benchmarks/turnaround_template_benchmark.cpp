@@ -0,0 +1,161 @@
+/**
+ * turnaround_template_benchmark.cpp
+ *
+ * Cost of setting up a turnaround's service DAG, compared two ways:
+ *
+ *   - graph walk: every turnaround runs get_execution_order over the
+ *     dependency graph, maps types to positions, copies each service's
+ *     dependency list and builds dependent lists (as ServiceScheduler and
+ *     ServiceExecutor did per flight)
+ *   - template: the graph is compiled once per aircraft category into a
+ *     TurnaroundTemplate; a turnaround copies in_degree into its counters
+ *
+ * Both then construct the same GroundService objects, so the "setup" column
+ * is the dependency state alone and "with services" includes allocation.
+ * Also prints each category's compiled template.
+ *
+ * Usage: turnaround_template_benchmark [turnarounds]
+ */
+
+#include "../src/services/TurnaroundTemplate.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static double elapsed_ms(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// ----- Per-flight graph walk -----
+
+struct LegacyTask {
+    int pending_dependencies;
+    vector<int> dependents;
+};
+
+static long long legacy_setup(ServiceDependencyGraph* graph, vector<LegacyTask>& tasks) {
+    vector<ServiceType> order = graph->get_execution_order();
+    vector<int> remaining_work = graph->get_remaining_work();
+    int position[SERVICE_TYPE_COUNT];
+    for (int i = 0; i < (int)order.size(); i++) position[order[i]] = i;
+    tasks.assign(order.size(), LegacyTask());
+    long long checksum = 0;
+    for (int i = 0; i < (int)order.size(); i++) {
+        vector<ServiceType> deps = graph->get_dependencies(order[i]);
+        tasks[i].pending_dependencies = deps.size();
+        for (ServiceType dep : deps) tasks[position[dep]].dependents.push_back(i);
+        checksum += remaining_work[order[i]];
+    }
+    return checksum;
+}
+
+static long long template_setup(const TurnaroundTemplate& plan, int* pending) {
+    memcpy(pending, plan.in_degree, sizeof(int) * SERVICE_TYPE_COUNT);
+    return plan.critical_path;
+}
+
+int main(int argc, char** argv) {
+    int turnarounds = argc > 1 ? atoi(argv[1]) : 200000;
+    if (turnarounds <= 0) {
+        cerr << "Usage: turnaround_template_benchmark [turnarounds]" << endl;
+        return 1;
+    }
+
+    cout << "╔═══════════════════════════════════════════════════════════════╗\n";
+    cout << "║     Turnaround Template Benchmark - Per-Flight DAG Setup      ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════╝\n\n";
+    cout << fixed << setprecision(1);
+
+    ServiceDependencyGraph graph;
+    graph.build_standard_turnaround();
+
+    TurnaroundTemplate templates[TURNAROUND_CATEGORY_COUNT];
+    for (int c = 0; c < TURNAROUND_CATEGORY_COUNT; c++) {
+        templates[c].compile(&graph, (TurnaroundCategory)c);
+    }
+
+    for (int c = 0; c < TURNAROUND_CATEGORY_COUNT; c++) {
+        const TurnaroundTemplate& plan = templates[c];
+        cout << TurnaroundTemplate::category_to_string(plan.category) << ": " << plan.count
+             << " services, critical path " << plan.critical_path << " min\n";
+        for (int i = 0; i < plan.count; i++) {
+            cout << "    " << setw(22) << left << GroundService::type_to_string(plan.order[i]) << right
+                 << " after";
+            for (int p = 0; p < plan.count; p++) {
+                if (plan.predecessors[i] & (1u << p)) {
+                    cout << " " << GroundService::type_to_string(plan.order[p]);
+                }
+            }
+            cout << "\n";
+        }
+    }
+    cout << "\n" << turnarounds << " turnarounds (passenger)\n\n";
+
+    const TurnaroundTemplate& passenger = templates[TURNAROUND_PASSENGER];
+    long long sink = 0;
+
+    // ----- Dependency state only -----
+    double legacy_setup_ms, template_setup_ms;
+    {
+        vector<LegacyTask> tasks;
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < turnarounds; t++) sink += legacy_setup(&graph, tasks);
+        legacy_setup_ms = elapsed_ms(start);
+    }
+    {
+        int pending[SERVICE_TYPE_COUNT];
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < turnarounds; t++) {
+            sink += template_setup(passenger, pending);
+            sink += pending[t % passenger.count];
+        }
+        template_setup_ms = elapsed_ms(start);
+    }
+
+    // ----- Including GroundService construction -----
+    double legacy_full_ms, template_full_ms;
+    {
+        vector<LegacyTask> tasks;
+        vector<GroundService*> services;
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < turnarounds; t++) {
+            sink += legacy_setup(&graph, tasks);
+            vector<ServiceType> order = graph.get_execution_order();
+            for (int i = 0; i < (int)order.size(); i++) {
+                GroundService* service = new GroundService(i, order[i], t, 0);
+                for (ServiceType dep : graph.get_dependencies(order[i])) service->add_dependency(dep);
+                services.push_back(service);
+            }
+            for (GroundService* service : services) delete service;
+            services.clear();
+        }
+        legacy_full_ms = elapsed_ms(start);
+    }
+    {
+        int pending[SERVICE_TYPE_COUNT];
+        vector<GroundService*> services;
+        auto start = chrono::steady_clock::now();
+        for (int t = 0; t < turnarounds; t++) {
+            sink += template_setup(passenger, pending);
+            for (int i = 0; i < passenger.count; i++) {
+                services.push_back(new GroundService(i, passenger.order[i], t, 0));
+            }
+            for (GroundService* service : services) delete service;
+            services.clear();
+        }
+        template_full_ms = elapsed_ms(start);
+    }
+
+    double scale = 1e6 / turnarounds;      // ms total -> ns per turnaround
+    cout << "                  setup ns/turnaround    with services ns/turnaround\n";
+    cout << "  graph walk:   " << setw(18) << legacy_setup_ms * scale << setw(26) << legacy_full_ms * scale << "\n";
+    cout << "  template:     " << setw(18) << template_setup_ms * scale << setw(26) << template_full_ms * scale << "\n";
+    cout << "\nSetup speedup: " << legacy_setup_ms / template_setup_ms << "x, with services: "
+         << legacy_full_ms / template_full_ms << "x   (checksum " << sink % 1000 << ")\n";
+    return 0;
+}
@@ -14,7 +14,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             cargo_capacity_kg = 25000;
             service_time_minutes = 90;
             break;
-            
+        
         case B777:
             type_name = "B777";
             weight_class = HEAVY;
@@ -23,7 +23,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             cargo_capacity_kg = 21000;
             service_time_minutes = 75;
             break;
-            
+        
         case B747F:
             type_name = "B747F";
             weight_class = HEAVY;
@@ -33,7 +33,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             service_time_minutes = 120;
             is_cargo = true;
             break;
-            
+        
         case B777F:
             type_name = "B777F";
             weight_class = HEAVY;
@@ -43,7 +43,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             service_time_minutes = 100;
             is_cargo = true;
             break;
-            
+        
         case B737:
             type_name = "B737";
             weight_class = MEDIUM;
@@ -52,7 +52,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             cargo_capacity_kg = 4000;
             service_time_minutes = 45;
             break;
-            
+        
         case A320:
             type_name = "A320";
             weight_class = MEDIUM;
@@ -61,7 +61,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             cargo_capacity_kg = 3500;
             service_time_minutes = 40;
             break;
-            
+        
         case G650:
             type_name = "G650";
             weight_class = LIGHT;
@@ -71,7 +71,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             service_time_minutes = 20;
             is_private = true;
             break;
-            
+        
         case FALCON_7X:
             type_name = "Falcon 7X";
             weight_class = LIGHT;
@@ -81,7 +81,7 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             service_time_minutes = 18;
             is_private = true;
             break;
-            
+        
         case EMERGENCY:
             type_name = "EMERGENCY";
             weight_class = MEDIUM;
@@ -93,3 +93,11 @@ Aircraft::Aircraft(AircraftType t) : type(t) {
             break;
     }
 }
+
+const Aircraft* Aircraft::get(AircraftType t) {
+    static const Aircraft table[] = {
+        Aircraft(A380), Aircraft(B777), Aircraft(B747F), Aircraft(B777F), Aircraft(B737),
+        Aircraft(A320), Aircraft(G650), Aircraft(FALCON_7X), Aircraft(EMERGENCY)
+    };
+    return &table[t];
+}
@@ -38,6 +38,10 @@ public:
     
     Aircraft(AircraftType t);
     
+    // Shared, immutable description of a type - flights point at these
+    // instead of allocating their own
+    static const Aircraft* get(AircraftType t);
+    
     std::string get_type_name() const { return type_name; }
     AircraftClass get_weight_class() const { return weight_class; }
 };
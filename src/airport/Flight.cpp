@@ -1,18 +1,23 @@
 #include "Flight.h"
+#include "FlightRegistry.h"
 
-Flight::Flight(const std::string& id, Aircraft* ac, FlightType ft,
+Flight::Flight(const std::string& id, const Aircraft* ac, FlightType ft,
                long long arr_time, long long dep_time)
-    : flight_id(id), aircraft(ac), flight_type(ft),
-      status(SCHEDULED),
+    : number(FlightRegistry::next_number()),
+      slot(-1),
+      flight_id(FlightRegistry::intern(id)),
+      aircraft(ac),
       scheduled_arrival_time(arr_time),
       actual_arrival_time(0),
       scheduled_departure_time(dep_time),
       actual_departure_time(0),
+      flight_type(ft),
+      status(SCHEDULED),
+      delay_minutes(0),
+      go_around_count(0),  // REQ-1: Initialize go-around counter
       assigned_runway_id(-1),
       assigned_gate_id(-1),
-      is_delayed(false),
-      delay_minutes(0),
-      go_around_count(0) {  // REQ-1: Initialize go-around counter
+      is_delayed(false) {
     
     // Set passenger count
     passenger_count = aircraft->passenger_capacity * (70 + rand() % 30) / 100; // 70-100% full
@@ -33,6 +38,10 @@ Flight::Flight(const std::string& id, Aircraft* ac, FlightType ft,
     }
 }
 
+Flight::~Flight() {
+    FlightRegistry::unintern(flight_id);
+}
+
 bool Flight::is_emergency() const {
     return aircraft->is_emergency || reserve_fuel_minutes < 15;
 }
@@ -25,22 +25,27 @@ enum FlightStatus {
     DEPARTED
 };
 
+// Flight fields are ordered so the object packs without alignment
+// padding. The id string is interned (FlightRegistry) and the aircraft is
+// the shared description of its type, so a flight owns no heap memory.
 class Flight {
 public:
-    std::string flight_id;
-    Aircraft* aircraft;
-    FlightType flight_type;
-    FlightStatus status;
+    int number;                     // Unique per constructed flight
+    int slot;                       // FlightRegistry slot, -1 if not registry-owned
+    const std::string& flight_id;   // Interned while the flight lives
+    const Aircraft* aircraft;       // Shared per type (Aircraft::get)
     
     long long scheduled_arrival_time;
     long long actual_arrival_time;
     long long scheduled_departure_time;
     long long actual_departure_time;
     
+    FlightType flight_type;
+    FlightStatus status;
+    
     int passenger_count;
     int connecting_passengers;
     int reserve_fuel_minutes;
-    bool is_delayed;
     int delay_minutes;
     int go_around_count;    // REQ-1: Track number of go-arounds (max 3)
     
@@ -50,9 +55,12 @@ public:
     
     // Priority (0=Emergency, 100=Low)
     int priority;
+    bool is_delayed;
     
-    Flight(const std::string& id, Aircraft* ac, FlightType ft, 
+    Flight(const std::string& id, const Aircraft* ac, FlightType ft, 
            long long arr_time, long long dep_time);
+    Flight(const Flight&) = delete;     // Holds one intern reference
+    ~Flight();
     
     bool is_emergency() const;
     bool needs_international_gate() const;
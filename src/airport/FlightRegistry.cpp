@@ -0,0 +1,146 @@
+#include "FlightRegistry.h"
+#include <atomic>
+#include <unordered_map>
+#include <new>
+
+using namespace std;
+
+// Process-wide id table: id -> live flights using it. Map keys do not
+// move on rehash, so flights keep references to them.
+struct InternTable {
+    pthread_mutex_t mutex;
+    unordered_map<string, int> references;
+    
+    InternTable() { pthread_mutex_init(&mutex, nullptr); }
+};
+
+static InternTable& intern_table() {
+    static InternTable table;
+    return table;
+}
+
+static atomic<int> flight_numbers(0);
+
+const string& FlightRegistry::intern(const string& id) {
+    InternTable& table = intern_table();
+    pthread_mutex_lock(&table.mutex);
+    auto it = table.references.emplace(id, 0).first;
+    it->second++;
+    const string& name = it->first;
+    pthread_mutex_unlock(&table.mutex);
+    return name;
+}
+
+void FlightRegistry::unintern(const string& id) {
+    InternTable& table = intern_table();
+    pthread_mutex_lock(&table.mutex);
+    auto it = table.references.find(id);
+    if (it != table.references.end() && --it->second == 0) {
+        table.references.erase(it);
+    }
+    pthread_mutex_unlock(&table.mutex);
+}
+
+int FlightRegistry::get_interned_count() {
+    InternTable& table = intern_table();
+    pthread_mutex_lock(&table.mutex);
+    int count = table.references.size();
+    pthread_mutex_unlock(&table.mutex);
+    return count;
+}
+
+int FlightRegistry::next_number() {
+    return flight_numbers.fetch_add(1);
+}
+
+FlightRegistry::FlightRegistry() : live_count(0) {
+    pthread_mutex_init(&registry_mutex, nullptr);
+}
+
+FlightRegistry::~FlightRegistry() {
+    // Odd generation = slot holds a live flight
+    for (size_t slot = 0; slot < generations.size(); slot++) {
+        if (generations[slot] & 1) {
+            slot_address(slot)->~Flight();
+        }
+    }
+    for (Flight* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+    pthread_mutex_destroy(&registry_mutex);
+}
+
+Flight* FlightRegistry::create(const string& id, AircraftType type, FlightType ft,
+                               long long arr_time, long long dep_time) {
+    pthread_mutex_lock(&registry_mutex);
+    
+    if (free_slots.empty()) {
+        // New chunk; slots are handed out lowest first
+        int base = chunks.size() * CHUNK_SIZE;
+        chunks.push_back(static_cast<Flight*>(::operator new(sizeof(Flight) * CHUNK_SIZE)));
+        generations.resize(base + CHUNK_SIZE, 0);
+        for (int slot = base + CHUNK_SIZE - 1; slot >= base; slot--) {
+            free_slots.push_back(slot);
+        }
+    }
+    int slot = free_slots.back();
+    free_slots.pop_back();
+    
+    Flight* flight = new (slot_address(slot)) Flight(id, Aircraft::get(type), ft, arr_time, dep_time);
+    flight->slot = slot;
+    generations[slot]++;
+    live_count++;
+    
+    pthread_mutex_unlock(&registry_mutex);
+    return flight;
+}
+
+void FlightRegistry::release(Flight* flight) {
+    if (flight == nullptr || flight->slot < 0) return;
+    
+    pthread_mutex_lock(&registry_mutex);
+    int slot = flight->slot;
+    if (slot < (int)generations.size() && (generations[slot] & 1) && slot_address(slot) == flight) {
+        flight->~Flight();
+        generations[slot]++;
+        free_slots.push_back(slot);
+        live_count--;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+FlightHandle FlightRegistry::handle_of(const Flight* flight) {
+    FlightHandle handle = {-1, 0};
+    if (flight == nullptr || flight->slot < 0) return handle;
+    
+    pthread_mutex_lock(&registry_mutex);
+    handle.slot = flight->slot;
+    handle.generation = generations[flight->slot];
+    pthread_mutex_unlock(&registry_mutex);
+    return handle;
+}
+
+Flight* FlightRegistry::get(FlightHandle handle) {
+    pthread_mutex_lock(&registry_mutex);
+    Flight* flight = nullptr;
+    if (handle.slot >= 0 && handle.slot < (int)generations.size() &&
+        generations[handle.slot] == handle.generation && (handle.generation & 1)) {
+        flight = slot_address(handle.slot);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    return flight;
+}
+
+int FlightRegistry::get_live_count() {
+    pthread_mutex_lock(&registry_mutex);
+    int count = live_count;
+    pthread_mutex_unlock(&registry_mutex);
+    return count;
+}
+
+int FlightRegistry::get_capacity() {
+    pthread_mutex_lock(&registry_mutex);
+    int capacity = generations.size();
+    pthread_mutex_unlock(&registry_mutex);
+    return capacity;
+}
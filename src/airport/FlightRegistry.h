@@ -0,0 +1,70 @@
+#ifndef FLIGHT_REGISTRY_H
+#define FLIGHT_REGISTRY_H
+
+#include "Flight.h"
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+using namespace std;
+
+// FlightRegistry owns the simulation's flights.
+//
+// Flights live in a slot map: fixed-size chunks of contiguous storage that
+// never move (other subsystems hold Flight*), a free list of slots, and a
+// generation counter per slot. A FlightHandle names one flight in one slot;
+// once the flight is released and the slot reused, get() on the old handle
+// returns nullptr instead of another flight. The registry frees everything
+// when it is destroyed, so no flight outlives the engine.
+//
+// Flight id strings are interned process-wide: live flights with the same
+// id share one stored copy, dropped when the last of them is destroyed.
+// Flight::number is handed out per construction, so it stays unique even
+// when two flights carry the same id.
+
+struct FlightHandle {
+    int slot;
+    unsigned generation;
+};
+
+class FlightRegistry {
+public:
+    static constexpr int CHUNK_SIZE = 64;   // Flights per storage chunk
+    
+private:
+    vector<Flight*> chunks;             // Raw storage, CHUNK_SIZE flights each
+    vector<unsigned> generations;       // Slot -> generation (odd while live)
+    vector<int> free_slots;
+    int live_count;
+    
+    pthread_mutex_t registry_mutex;
+    
+    Flight* slot_address(int slot) { return chunks[slot / CHUNK_SIZE] + slot % CHUNK_SIZE; }
+    
+public:
+    FlightRegistry();
+    ~FlightRegistry();
+    
+    // Construct a flight in a free slot, with the shared aircraft of its type
+    Flight* create(const string& id, AircraftType type, FlightType ft,
+                   long long arr_time, long long dep_time);
+    
+    // Destroy the flight and free its slot; its handles go stale
+    void release(Flight* flight);
+    
+    FlightHandle handle_of(const Flight* flight);
+    Flight* get(FlightHandle handle);     // nullptr if released
+    
+    int get_live_count();
+    int get_capacity();
+    
+    // Interned ids; each intern() is paired with one unintern()
+    static const string& intern(const string& id);
+    static void unintern(const string& id);
+    static int get_interned_count();
+    
+    // Next Flight::number
+    static int next_number();
+};
+
+#endif // FLIGHT_REGISTRY_H
@@ -20,9 +20,11 @@ bool Gate::is_compatible(Flight* flight) {
     }
     
     // Check size compatibility
-    AircraftType ac_type = flight->aircraft->type;
-    
-    switch(ac_type) {
+    return fits(flight->aircraft->type, size);
+}
+
+bool Gate::fits(AircraftType aircraft, GateSize size) {
+    switch(aircraft) {
         case A380:
             return size == GATE_LARGE;
             
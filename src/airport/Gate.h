@@ -44,11 +44,13 @@ public:
     
     // Check compatibility
     bool is_compatible(Flight* flight);
+    static bool fits(AircraftType aircraft, GateSize size);   // Size rule only
     
     // Getters
     int get_id() const { return id; }
     GateType get_type() const { return type; }
     GateSize get_size() const { return size; }
+    bool get_has_jetbridge() const { return has_jetbridge; }
     bool is_available();
     Flight* get_current_flight();
 };
@@ -2,15 +2,38 @@
 #include "../core/Logger.h"
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <ctime>
 
 using namespace std;
 
-GateManager::GateManager() {
+// Incompatible flight/gate pairs; any real cost is far below this
+static const long long INFEASIBLE_COST = 1000000000000LL;
+
+GateManager::GateManager() : next_booking_key(0), timeline_stats(), last_plan_cost(0), last_plan_us(0) {
     pthread_mutex_init(&manager_mutex, nullptr);
+    pthread_condattr_init(&wait_condattr);
+    pthread_condattr_setclock(&wait_condattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&gate_released, &wait_condattr);
+    
+    // Best-fit order: smallest fitting stand first; at each size a domestic
+    // flight tries domestic gates before international ones
+    for (int a = 0; a < AIRCRAFT_TYPES; a++) {
+        for (int intl = 0; intl < 2; intl++) {
+            for (int size = GATE_SIZES - 1; size >= 0; size--) {
+                if (!Gate::fits((AircraftType)a, (GateSize)size)) continue;
+                if (!intl) fit_order[a][intl].push_back(GATE_DOMESTIC * GATE_SIZES + size);
+                fit_order[a][intl].push_back(GATE_INTERNATIONAL * GATE_SIZES + size);
+            }
+        }
+    }
 }
 
 GateManager::~GateManager() {
     pthread_mutex_destroy(&manager_mutex);
+    pthread_cond_destroy(&gate_released);
+    pthread_condattr_destroy(&wait_condattr);
     
     for (Gate* gate : gates) {
         delete gate;
@@ -20,97 +43,567 @@ GateManager::~GateManager() {
 void GateManager::add_gate(Gate* gate) {
     pthread_mutex_lock(&manager_mutex);
     gates.push_back(gate);
+    
+    int id = gate->get_id();
+    if ((int)gate_by_id.size() <= id) {
+        gate_by_id.resize(id + 1, nullptr);
+        walk_distance.resize(id + 1, 0);
+        earmarked_for.resize(id + 1, nullptr);
+        listed.resize(id + 1, 0);
+        timeline.resize(id + 1);
+    }
+    gate_by_id[id] = gate;
+    cell_gates[cell_of(gate)].push_back(gate);
+    if (gate->is_available()) {
+        free_gates[cell_of(gate)].push_back(gate);
+        listed[id] = 1;
+    }
     pthread_mutex_unlock(&manager_mutex);
 }
 
-bool GateManager::is_safe_state(int flight_index, const std::vector<int>& request) {
-    // Simplified Banker's algorithm check
-    // In full implementation, would check if allocation leaves system in safe state
+void GateManager::set_walk_distance(int gate_id, int metres) {
+    pthread_mutex_lock(&manager_mutex);
+    if (gate_id >= 0 && gate_id < (int)walk_distance.size()) {
+        walk_distance[gate_id] = metres;
+    }
+    pthread_mutex_unlock(&manager_mutex);
+}
+
+void GateManager::remove_from(vector<Gate*>& list, Gate* gate) {
+    auto it = find(list.begin(), list.end(), gate);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+void GateManager::clear_plan_locked(Flight* flight) {
+    auto it = planned_gate.find(flight);
+    if (it == planned_gate.end()) return;
     
-    // For now, just check if gate is available and compatible
-    return true;
+    // Gate goes back to the free lists
+    Gate* gate = it->second;
+    remove_from(earmarked_gates[cell_of(gate)], gate);
+    free_gates[cell_of(gate)].push_back(gate);
+    earmarked_for[gate->get_id()] = nullptr;
+    planned_gate.erase(it);
 }
 
-Gate* GateManager::allocate_gate(Flight* flight) {
-    // CRITICAL SECTION: Search and allocate gate
-    pthread_mutex_lock(&manager_mutex);
+void GateManager::unlist_locked(Gate* gate) {
+    int id = gate->get_id();
+    remove_from(free_gates[cell_of(gate)], gate);
+    if (earmarked_for[id] != nullptr) {
+        remove_from(earmarked_gates[cell_of(gate)], gate);
+        planned_gate.erase(earmarked_for[id]);
+        earmarked_for[id] = nullptr;
+    }
+    listed[id] = 0;
+}
+
+Gate* GateManager::take_best_fit_locked(Flight* flight, vector<Gate*>* lists, long long start, long long end) {
+    const vector<int>& order = fit_order[flight->aircraft->type][flight->needs_international_gate()];
     
+    // With a stay window, prefer a gate nobody else has booked for it
+    if (start >= 0) {
+        for (int cell : order) {
+            vector<Gate*>& list = lists[cell];
+            for (size_t k = list.size(); k-- > 0;) {
+                Gate* gate = list[k];
+                if (timeline[gate->get_id()].is_free(start, end)) {
+                    list[k] = list.back();
+                    list.pop_back();
+                    return gate;
+                }
+            }
+        }
+    }
+    for (int cell : order) {
+        if (!lists[cell].empty()) {
+            Gate* gate = lists[cell].back();
+            lists[cell].pop_back();
+            return gate;
+        }
+    }
+    return nullptr;
+}
+
+Gate* GateManager::take_gate_locked(Flight* flight, long long current_time) {
     Gate* chosen_gate = nullptr;
     
-    // Priority order: exact match > larger gate
-    // First, try to find exact match
-    for (Gate* gate : gates) {
-        if (gate->is_available() && gate->is_compatible(flight)) {
-            // Banker's algorithm: check if allocation is safe
-            if (is_safe_state(0, {})) {
-                chosen_gate = gate;
-                break;
-            }
+    // The gate booked on the timeline, if nobody is on it
+    Gate* booked_gate = nullptr;
+    long long stay_end = flight->scheduled_departure_time + GATE_BUFFER;
+    auto booked = bookings.find(flight);
+    if (booked != bookings.end()) {
+        booked_gate = booked->second.gate;
+        stay_end = booked->second.end;
+        if (listed[booked_gate->get_id()]) {
+            unlist_locked(booked_gate);
+            clear_plan_locked(flight);
+            chosen_gate = booked_gate;
+            timeline_stats.booked_hits++;
         }
     }
+    stay_end = max(stay_end, current_time + 1);
     
-    pthread_mutex_unlock(&manager_mutex);
-    // END search phase
+    // The gate the bank optimizer planned for this flight
+    if (chosen_gate == nullptr) {
+        auto planned = planned_gate.find(flight);
+        if (planned != planned_gate.end()) {
+            chosen_gate = planned->second;
+            remove_from(earmarked_gates[cell_of(chosen_gate)], chosen_gate);
+            earmarked_for[chosen_gate->get_id()] = nullptr;
+            planned_gate.erase(planned);
+        }
+    }
     
+    // Otherwise best fit among unearmarked gates, and only then take a
+    // gate planned for another flight (it is re-planned next round)
+    if (chosen_gate == nullptr) {
+        chosen_gate = take_best_fit_locked(flight, free_gates, current_time, stay_end);
+    }
     if (chosen_gate == nullptr) {
+        chosen_gate = take_best_fit_locked(flight, earmarked_gates, current_time, stay_end);
+        if (chosen_gate != nullptr) {
+            planned_gate.erase(earmarked_for[chosen_gate->get_id()]);
+            earmarked_for[chosen_gate->get_id()] = nullptr;
+        }
+    }
+    
+    if (chosen_gate == nullptr) {
+        return nullptr;
+    }
+    listed[chosen_gate->get_id()] = 0;
+    auto it = find(pending.begin(), pending.end(), flight);
+    if (it != pending.end()) pending.erase(it);
+    
+    // Off the booked gate: book the stay here, moving whoever it displaces
+    if (current_time >= 0 && chosen_gate != booked_gate) {
+        unbook_locked(flight);
+        move_conflicts_locked(chosen_gate, current_time, stay_end);
+        record_booking_locked(flight, chosen_gate, current_time, stay_end);
+    }
+    return chosen_gate;
+}
+
+Gate* GateManager::reserve_taken(Flight* flight, Gate* gate) {
+    if (gate == nullptr) {
         return nullptr; // No compatible gate available
     }
     
     // Try to reserve (gate has its own fine-grained lock)
-    if (chosen_gate->try_reserve(flight)) {
+    if (gate->try_reserve(flight)) {
         std::ostringstream log_msg;
-        log_msg << "[GateManager] Flight " << flight->flight_id 
-                << " allocated gate " << chosen_gate->get_id();
+        log_msg << "[GateManager] Flight " << flight->flight_id
+                << " allocated gate " << gate->get_id();
         Logger::get_instance()->log_event(log_msg.str());
         
-        return chosen_gate;
+        return gate;
     }
     
+    // Held outside the manager - leave it listed as it was
+    pthread_mutex_lock(&manager_mutex);
+    free_gates[cell_of(gate)].push_back(gate);
+    listed[gate->get_id()] = 1;
+    pthread_mutex_unlock(&manager_mutex);
     return nullptr;
 }
 
+Gate* GateManager::allocate_gate(Flight* flight, long long current_time) {
+    // CRITICAL SECTION: Pick and unlist a gate
+    pthread_mutex_lock(&manager_mutex);
+    Gate* chosen_gate = take_gate_locked(flight, current_time);
+    pthread_mutex_unlock(&manager_mutex);
+    // END search phase
+    
+    return reserve_taken(flight, chosen_gate);
+}
+
+Gate* GateManager::wait_for_gate(Flight* flight, long long current_time, long long timeout_ms) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    
+    // Sleep until release_gate signals, then try again
+    pthread_mutex_lock(&manager_mutex);
+    Gate* chosen_gate = take_gate_locked(flight, current_time);
+    while (chosen_gate == nullptr) {
+        int rc = pthread_cond_timedwait(&gate_released, &manager_mutex, &deadline);
+        chosen_gate = take_gate_locked(flight, current_time);
+        if (rc == ETIMEDOUT) break;
+    }
+    pthread_mutex_unlock(&manager_mutex);
+    
+    return reserve_taken(flight, chosen_gate);
+}
+
 void GateManager::release_gate(int gate_id) {
+    Gate* gate = get_gate(gate_id);
+    if (gate == nullptr) {
+        return;
+    }
+    
+    // Free the gate before listing it, so whoever takes it can reserve it
+    Flight* flight = gate->get_current_flight();
+    gate->release();
+    
+    pthread_mutex_lock(&manager_mutex);
+    auto booked = bookings.find(flight);
+    if (booked != bookings.end() && booked->second.gate == gate) {
+        unbook_locked(flight);
+    }
+    if (!listed[gate_id]) {
+        free_gates[cell_of(gate)].push_back(gate);
+        listed[gate_id] = 1;
+    }
+    pthread_cond_broadcast(&gate_released);
+    pthread_mutex_unlock(&manager_mutex);
+    
+    std::ostringstream log_msg;
+    log_msg << "[GateManager] Gate " << gate_id << " released";
+    Logger::get_instance()->log_event(log_msg.str());
+}
+
+void GateManager::add_pending_arrival(Flight* flight) {
+    pthread_mutex_lock(&manager_mutex);
+    // Flights booked on the timeline already have their gate
+    if (bookings.find(flight) == bookings.end() &&
+        find(pending.begin(), pending.end(), flight) == pending.end()) {
+        pending.push_back(flight);
+    }
+    pthread_mutex_unlock(&manager_mutex);
+}
+
+void GateManager::remove_pending_arrival(Flight* flight) {
     pthread_mutex_lock(&manager_mutex);
+    auto it = find(pending.begin(), pending.end(), flight);
+    if (it != pending.end()) pending.erase(it);
+    clear_plan_locked(flight);
+    unbook_locked(flight);
+    pthread_mutex_unlock(&manager_mutex);
+}
+
+// ========== Arrival bank optimizer ==========
+
+bool GateManager::fits_flight(Flight* flight, Gate* gate) {
+    // Gate::is_compatible without the gate lock
+    if (flight->needs_international_gate() && gate->get_type() != GATE_INTERNATIONAL) return false;
+    return Gate::fits(flight->aircraft->type, gate->get_size());
+}
+
+long long GateManager::assignment_cost(Flight* flight, Gate* gate) const {
+    bool intl = flight->needs_international_gate();
+    AircraftType aircraft = flight->aircraft->type;
+    if (!fits_flight(flight, gate)) return INFEASIBLE_COST;
     
-    for (Gate* gate : gates) {
-        if (gate->get_id() == gate_id) {
-            pthread_mutex_unlock(&manager_mutex);
-            
-            gate->release();
-            
-            std::ostringstream log_msg;
-            log_msg << "[GateManager] Gate " << gate_id << " released";
-            Logger::get_instance()->log_event(log_msg.str());
-            
-            return;
+    // Bigger stands than needed are kept for the aircraft that need them
+    int best_size = fit_order[aircraft][intl][0] % GATE_SIZES;
+    long long c = (best_size - gate->get_size()) * UPSIZE_COST;
+    if (gate->get_size() == GATE_LARGE && aircraft != A380) c += LARGE_STAND_COST;
+    if (!intl && gate->get_type() == GATE_INTERNATIONAL) c += INTL_STAND_COST;
+    
+    // Passenger walking (per 100m), or a bus ride without a jetbridge
+    c += (long long)flight->passenger_count * walk_distance[gate->get_id()] / 100;
+    if (!gate->get_has_jetbridge()) c += (long long)flight->passenger_count * BUS_COST;
+    return c;
+}
+
+void GateManager::solve_assignment(int rows, int cols) {
+    // Hungarian algorithm (shortest augmenting paths with potentials),
+    // O(rows^2 * cols); rows <= cols. Indices are 1-based, column 0 is
+    // the virtual start. match[j] = row assigned to column j.
+    const long long INF = INFEASIBLE_COST * 4;
+    potential_row.assign(rows + 1, 0);
+    potential_col.assign(cols + 1, 0);
+    match.assign(cols + 1, 0);
+    way.assign(cols + 1, 0);
+    
+    for (int i = 1; i <= rows; i++) {
+        match[0] = i;
+        int j0 = 0;
+        min_slack.assign(cols + 1, INF);
+        used.assign(cols + 1, 0);
+        do {
+            used[j0] = 1;
+            int i0 = match[j0];
+            long long delta = INF;
+            int j1 = 0;
+            const long long* row = &cost[(size_t)(i0 - 1) * cols];
+            for (int j = 1; j <= cols; j++) {
+                if (used[j]) continue;
+                long long slack = row[j - 1] - potential_row[i0] - potential_col[j];
+                if (slack < min_slack[j]) {
+                    min_slack[j] = slack;
+                    way[j] = j0;
+                }
+                if (min_slack[j] < delta) {
+                    delta = min_slack[j];
+                    j1 = j;
+                }
+            }
+            for (int j = 0; j <= cols; j++) {
+                if (used[j]) {
+                    potential_row[match[j]] += delta;
+                    potential_col[j] -= delta;
+                } else {
+                    min_slack[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (match[j0] != 0);
+        
+        // Flip the augmenting path
+        do {
+            int j1 = way[j0];
+            match[j0] = match[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+}
+
+int GateManager::optimize_pending(long long current_time) {
+    auto start = chrono::steady_clock::now();
+    pthread_mutex_lock(&manager_mutex);
+    
+    // Re-plan from scratch: every earmark goes back to the free lists
+    for (int cell = 0; cell < GATE_TYPES * GATE_SIZES; cell++) {
+        for (Gate* gate : earmarked_gates[cell]) {
+            earmarked_for[gate->get_id()] = nullptr;
+            free_gates[cell].push_back(gate);
+        }
+        earmarked_gates[cell].clear();
+    }
+    planned_gate.clear();
+    
+    int rows = pending.size();
+    if (rows == 0) {
+        last_plan_cost = 0;
+        pthread_mutex_unlock(&manager_mutex);
+        return 0;
+    }
+    
+    vector<Gate*> candidates;
+    for (int cell = 0; cell < GATE_TYPES * GATE_SIZES; cell++) {
+        candidates.insert(candidates.end(), free_gates[cell].begin(), free_gates[cell].end());
+    }
+    
+    // One column per free gate plus one "no gate" column per flight, so
+    // every flight can be matched; higher priority pays more to go without
+    int gate_cols = candidates.size();
+    int cols = gate_cols + rows;
+    cost.assign((size_t)rows * cols, 0);
+    for (int i = 0; i < rows; i++) {
+        long long* row = &cost[(size_t)i * cols];
+        long long stay_end = max(current_time + 1, pending[i]->scheduled_departure_time + GATE_BUFFER);
+        for (int j = 0; j < gate_cols; j++) {
+            row[j] = assignment_cost(pending[i], candidates[j]);
+            // Free now, but booked by someone else during the stay
+            if (current_time >= 0 && row[j] < INFEASIBLE_COST &&
+                !timeline[candidates[j]->get_id()].is_free(current_time, stay_end)) {
+                row[j] += TIMELINE_CONFLICT_COST;
+            }
+        }
+        long long unassigned = UNASSIGNED_COST * (1 + (100 - pending[i]->priority) / 10);
+        for (int j = gate_cols; j < cols; j++) {
+            row[j] = unassigned;
         }
     }
+    solve_assignment(rows, cols);
+    
+    int assigned = 0;
+    long long total = 0;
+    for (int j = 1; j <= cols; j++) {
+        int i = match[j] - 1;
+        if (i < 0) continue;
+        long long c = cost[(size_t)i * cols + j - 1];
+        total += c;
+        if (j > gate_cols || c >= INFEASIBLE_COST) continue;
+        
+        Gate* gate = candidates[j - 1];
+        remove_from(free_gates[cell_of(gate)], gate);
+        earmarked_gates[cell_of(gate)].push_back(gate);
+        earmarked_for[gate->get_id()] = pending[i];
+        planned_gate[pending[i]] = gate;
+        assigned++;
+    }
+    last_plan_cost = total;
+    last_plan_us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
     
     pthread_mutex_unlock(&manager_mutex);
+    return assigned;
 }
 
-Gate* GateManager::get_gate(int id) {
+// ========== Occupancy timeline ==========
+
+void GateManager::record_booking_locked(Flight* flight, Gate* gate, long long start, long long end) {
+    int key = next_booking_key++;
+    timeline[gate->get_id()].book(start, end, key);
+    GateBooking booking;
+    booking.gate = gate;
+    booking.start = start;
+    booking.end = end;
+    booking.key = key;
+    bookings[flight] = booking;
+    booking_owner[key] = flight;
+}
+
+void GateManager::unbook_locked(Flight* flight) {
+    auto it = bookings.find(flight);
+    if (it == bookings.end()) return;
+    timeline[it->second.gate->get_id()].cancel(it->second.start, it->second.key);
+    booking_owner.erase(it->second.key);
+    bookings.erase(it);
+}
+
+bool GateManager::book_locked(Flight* flight, long long start, long long end, Gate* prefer, Gate* avoid) {
+    if (end <= start) end = start + 1;
+    if (prefer != nullptr && prefer != avoid && fits_flight(flight, prefer) &&
+        timeline[prefer->get_id()].is_free(start, end)) {
+        record_booking_locked(flight, prefer, start, end);
+        return true;
+    }
+    
+    // Best fit, as allocation would pick
+    for (int cell : fit_order[flight->aircraft->type][flight->needs_international_gate()]) {
+        for (Gate* gate : cell_gates[cell]) {
+            if (gate != avoid && timeline[gate->get_id()].is_free(start, end)) {
+                record_booking_locked(flight, gate, start, end);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int GateManager::move_conflicts_locked(Gate* gate, long long start, long long end) {
+    // Re-book every stay overlapping [start, end) on another gate; returns
+    // the number of conflicts found
+    ResourceCalendar& calendar = timeline[gate->get_id()];
+    int conflicts = 0;
+    const CalendarBooking* hit;
+    while ((hit = calendar.first_overlap(start, end)) != nullptr) {
+        conflicts++;
+        auto owner = booking_owner.find(hit->flight_id);
+        if (owner == booking_owner.end()) {
+            calendar.cancel(hit->start, hit->flight_id);
+            continue;
+        }
+        Flight* flight = owner->second;
+        GateBooking old = bookings[flight];
+        unbook_locked(flight);
+        if (book_locked(flight, old.start, old.end, nullptr, gate)) {
+            timeline_stats.moved++;
+        } else {
+            timeline_stats.unplanned++;
+        }
+    }
+    return conflicts;
+}
+
+bool GateManager::preassign_gate(Flight* flight, long long min_stay) {
     pthread_mutex_lock(&manager_mutex);
+    bool booked = bookings.find(flight) != bookings.end();
+    if (!booked) {
+        long long end = max(flight->scheduled_departure_time, flight->scheduled_arrival_time + min_stay);
+        booked = book_locked(flight, flight->scheduled_arrival_time, end + GATE_BUFFER, nullptr, nullptr);
+        if (booked) timeline_stats.preassigned++;
+        else timeline_stats.unplanned++;
+    }
+    pthread_mutex_unlock(&manager_mutex);
+    return booked;
+}
+
+bool GateManager::update_gate_times(Flight* flight, long long start, long long end) {
+    pthread_mutex_lock(&manager_mutex);
+    auto it = bookings.find(flight);
+    Gate* old_gate = it != bookings.end() ? it->second.gate : nullptr;
+    unbook_locked(flight);
     
-    for (Gate* gate : gates) {
-        if (gate->get_id() == id) {
-            pthread_mutex_unlock(&manager_mutex);
-            return gate;
+    // Keep the gate if the new window is still free there
+    bool booked = book_locked(flight, start, end, old_gate, nullptr);
+    if (!booked) {
+        timeline_stats.unplanned++;
+    } else if (bookings[flight].gate == old_gate) {
+        timeline_stats.rebooked++;
+    } else {
+        timeline_stats.moved++;
+    }
+    pthread_mutex_unlock(&manager_mutex);
+    return booked;
+}
+
+int GateManager::replan_gate_conflicts(long long current_time) {
+    pthread_mutex_lock(&manager_mutex);
+    
+    // Flights still on their gate past the end of their slot
+    vector<Flight*> overdue;
+    for (const auto& entry : bookings) {
+        const GateBooking& b = entry.second;
+        if (b.end <= current_time && !listed[b.gate->get_id()] &&
+            b.gate->get_current_flight() == entry.first) {
+            overdue.push_back(entry.first);
         }
     }
     
+    // Assume they stay a while longer and clear that time now, before the
+    // next flight booked there lands
+    long long moved_before = timeline_stats.moved;
+    long long until = current_time + OVERSTAY_MARGIN;
+    for (Flight* flight : overdue) {
+        GateBooking& b = bookings[flight];
+        timeline_stats.conflicts_predicted += move_conflicts_locked(b.gate, b.end, until);
+        ResourceCalendar& calendar = timeline[b.gate->get_id()];
+        calendar.cancel(b.start, b.key);
+        calendar.book(b.start, until, b.key);
+        b.end = until;
+    }
+    int moved = timeline_stats.moved - moved_before;
+    
     pthread_mutex_unlock(&manager_mutex);
-    return nullptr;
+    return moved;
+}
+
+Gate* GateManager::get_booked_gate(Flight* flight) {
+    pthread_mutex_lock(&manager_mutex);
+    auto it = bookings.find(flight);
+    Gate* gate = it != bookings.end() ? it->second.gate : nullptr;
+    pthread_mutex_unlock(&manager_mutex);
+    return gate;
+}
+
+GateTimelineStats GateManager::get_timeline_stats() {
+    pthread_mutex_lock(&manager_mutex);
+    GateTimelineStats stats = timeline_stats;
+    pthread_mutex_unlock(&manager_mutex);
+    return stats;
+}
+
+Gate* GateManager::get_planned_gate(Flight* flight) {
+    pthread_mutex_lock(&manager_mutex);
+    auto it = planned_gate.find(flight);
+    Gate* gate = it != planned_gate.end() ? it->second : nullptr;
+    pthread_mutex_unlock(&manager_mutex);
+    return gate;
+}
+
+Gate* GateManager::get_gate(int id) {
+    pthread_mutex_lock(&manager_mutex);
+    Gate* gate = (id >= 0 && id < (int)gate_by_id.size()) ? gate_by_id[id] : nullptr;
+    pthread_mutex_unlock(&manager_mutex);
+    return gate;
 }
 
 int GateManager::get_available_gate_count() {
     pthread_mutex_lock(&manager_mutex);
     
     int count = 0;
-    for (Gate* gate : gates) {
-        if (gate->is_available()) {
-            count++;
-        }
+    for (int cell = 0; cell < GATE_TYPES * GATE_SIZES; cell++) {
+        count += free_gates[cell].size() + earmarked_gates[cell].size();
     }
     
     pthread_mutex_unlock(&manager_mutex);
@@ -121,12 +614,32 @@ int GateManager::get_available_gate_count_by_type(GateType type) {
     pthread_mutex_lock(&manager_mutex);
     
     int count = 0;
-    for (Gate* gate : gates) {
-        if (gate->is_available() && gate->get_type() == type) {
-            count++;
-        }
+    for (int size = 0; size < GATE_SIZES; size++) {
+        int cell = type * GATE_SIZES + size;
+        count += free_gates[cell].size() + earmarked_gates[cell].size();
     }
     
     pthread_mutex_unlock(&manager_mutex);
     return count;
 }
+
+int GateManager::get_pending_count() {
+    pthread_mutex_lock(&manager_mutex);
+    int count = pending.size();
+    pthread_mutex_unlock(&manager_mutex);
+    return count;
+}
+
+long long GateManager::get_last_plan_cost() {
+    pthread_mutex_lock(&manager_mutex);
+    long long c = last_plan_cost;
+    pthread_mutex_unlock(&manager_mutex);
+    return c;
+}
+
+double GateManager::get_last_plan_us() {
+    pthread_mutex_lock(&manager_mutex);
+    double us = last_plan_us;
+    pthread_mutex_unlock(&manager_mutex);
+    return us;
+}
@@ -2,41 +2,178 @@
 #define GATE_MANAGER_H
 
 #include "Gate.h"
+#include "../resources/ResourceCalendar.h"
 #include <vector>
+#include <unordered_map>
 #include <pthread.h>
 
 using namespace std;
 
+// GateManager allocates gates best-fit from free lists indexed by
+// (GateType, GateSize). Each aircraft type and flight type has a
+// precomputed search order over those cells - smallest fitting stand
+// first, domestic before international - so allocation never scans gates
+// and small aircraft stay off heavy stands while smaller ones are free.
+//
+// Approaching flights form the arrival bank. optimize_pending() assigns
+// the whole bank to free gates at minimum total cost (Hungarian
+// algorithm) and earmarks the chosen gates; allocate_gate() then takes
+// the earmarked gate. Earmarked gates are kept out of the free lists and
+// only taken from their flight when nothing else fits.
+//
+// Every gate also has an occupancy timeline. Flights are booked onto it
+// from their schedule when their arrival is created (preassign_gate), so
+// conflicts are visible before anyone lands: a delayed flight is re-booked
+// on its own (update_gate_times), and a flight overstaying its slot moves
+// the bookings it would collide with to other gates ahead of time
+// (replan_gate_conflicts). Allocation takes the booked gate when it is
+// free; flights that must wait block on a condition signalled by
+// release_gate instead of polling.
+//
+// A flight only ever holds one gate, so gate allocation cannot deadlock
+// and needs no Banker's check.
+
+// A flight's slot on a gate timeline (time units)
+struct GateBooking {
+    Gate* gate;
+    long long start;
+    long long end;          // Exclusive
+    int key;                // Calendar booking id
+};
+
+// Timeline statistics
+struct GateTimelineStats {
+    long long preassigned;          // Booked from the schedule
+    long long unplanned;            // No gate free for a flight's window
+    long long rebooked;             // Delayed flight kept its gate
+    long long moved;                // Booking moved to another gate
+    long long conflicts_predicted;  // Bookings in the way of an overstaying flight
+    long long booked_hits;          // Flights that found their booked gate free
+};
+
 class GateManager {
+public:
+    static constexpr int GATE_TYPES = 2;
+    static constexpr int GATE_SIZES = 5;
+    static constexpr int AIRCRAFT_TYPES = EMERGENCY + 1;
+    
+    // Assignment costs (per arrival)
+    static constexpr long long UPSIZE_COST = 400;        // Per stand size above best fit
+    static constexpr long long LARGE_STAND_COST = 800;   // A380 stand used by anything else
+    static constexpr long long INTL_STAND_COST = 300;    // Domestic flight on an international gate
+    static constexpr long long BUS_COST = 2;             // Per passenger without a jetbridge
+    static constexpr long long UNASSIGNED_COST = 100000; // Per flight left without a gate
+    static constexpr long long TIMELINE_CONFLICT_COST = 5000;  // Gate booked by another flight
+    
+    // Timeline
+    static constexpr long long GATE_BUFFER = 10;         // Kept free after each departure
+    static constexpr long long OVERSTAY_MARGIN = 60;     // Assumed further stay once overdue
+    
 private:
     vector<Gate*> gates;
+    vector<Gate*> gate_by_id;
+    vector<int> walk_distance;          // Gate id -> metres from the terminal centre
+    
+    // Free, unearmarked gates per cell (cell = type * GATE_SIZES + size)
+    vector<Gate*> free_gates[GATE_TYPES * GATE_SIZES];
+    // Free gates earmarked for a pending flight, per cell
+    vector<Gate*> earmarked_gates[GATE_TYPES * GATE_SIZES];
+    vector<Flight*> earmarked_for;      // Gate id -> flight (nullptr if none)
+    vector<char> listed;                // Gate id -> in a free or earmarked list
+    
+    // Best-fit cell order per [aircraft type][international]
+    vector<int> fit_order[AIRCRAFT_TYPES][2];
+    vector<Gate*> cell_gates[GATE_TYPES * GATE_SIZES];  // All gates per cell
+    
+    // Occupancy timelines
+    vector<ResourceCalendar> timeline;                  // Gate id -> bookings
+    unordered_map<Flight*, GateBooking> bookings;
+    unordered_map<int, Flight*> booking_owner;          // Booking key -> flight
+    int next_booking_key;
+    GateTimelineStats timeline_stats;
+    
+    // Arrival bank
+    vector<Flight*> pending;
+    unordered_map<Flight*, Gate*> planned_gate;
+    
+    // Optimizer scratch
+    vector<long long> cost;
+    vector<long long> potential_row, potential_col, min_slack;
+    vector<int> match, way;
+    vector<char> used;
+    long long last_plan_cost;
+    double last_plan_us;
+    
     pthread_mutex_t manager_mutex;
+    pthread_condattr_t wait_condattr;   // CLOCK_MONOTONIC
+    pthread_cond_t gate_released;
     
-    // Banker's algorithm data structures
-    vector<int> available;    // Available resources per gate type
-    vector<vector<int>> allocation;  // Current allocation
-    vector<vector<int>> maximum;     // Maximum need
+    static int cell_of(const Gate* gate) { return gate->get_type() * GATE_SIZES + gate->get_size(); }
     
-    bool is_safe_state(int flight_index, const vector<int>& request);
+    // Caller holds manager_mutex
+    void remove_from(vector<Gate*>& list, Gate* gate);
+    void clear_plan_locked(Flight* flight);
+    void unlist_locked(Gate* gate);
+    Gate* take_best_fit_locked(Flight* flight, vector<Gate*>* lists, long long start, long long end);
+    Gate* take_gate_locked(Flight* flight, long long current_time);
+    Gate* reserve_taken(Flight* flight, Gate* gate);
+    static bool fits_flight(Flight* flight, Gate* gate);
+    long long assignment_cost(Flight* flight, Gate* gate) const;
+    
+    // Timeline helpers (caller holds manager_mutex)
+    void record_booking_locked(Flight* flight, Gate* gate, long long start, long long end);
+    bool book_locked(Flight* flight, long long start, long long end, Gate* prefer, Gate* avoid);
+    void unbook_locked(Flight* flight);
+    int move_conflicts_locked(Gate* gate, long long start, long long end);
+    void solve_assignment(int rows, int cols);
     
 public:
     GateManager();
     ~GateManager();
     
     void add_gate(Gate* gate);
+    void set_walk_distance(int gate_id, int metres);
     
-    // Allocate gate using Banker's algorithm
-    Gate* allocate_gate(Flight* flight);
+    // Allocate the flight's booked or earmarked gate, else the best-fitting
+    // free gate (with current_time, one not booked by others if possible)
+    Gate* allocate_gate(Flight* flight, long long current_time = -1);
+    // As allocate_gate, but sleep until a gate is released if none fits.
+    // Returns nullptr after timeout_ms.
+    Gate* wait_for_gate(Flight* flight, long long current_time, long long timeout_ms);
     
     // Release gate
     void release_gate(int gate_id);
     
+    // Arrival bank: flights on approach that will need a gate
+    void add_pending_arrival(Flight* flight);
+    void remove_pending_arrival(Flight* flight);
+    
+    // Assign the bank to free gates at minimum total cost and earmark
+    // them. Returns the number of flights given a gate.
+    int optimize_pending(long long current_time = -1);
+    Gate* get_planned_gate(Flight* flight);
+    
+    // Timeline: book [scheduled arrival, scheduled departure + buffer),
+    // held for at least min_stay (e.g. the predicted turnaround)
+    bool preassign_gate(Flight* flight, long long min_stay = 0);
+    // Re-plan one flight's window (e.g. after a delay); the same gate is
+    // kept if still free. False if no gate is free for the new window.
+    bool update_gate_times(Flight* flight, long long start, long long end);
+    // Extend overdue stays by OVERSTAY_MARGIN and move bookings they would
+    // collide with. Returns the number of bookings moved.
+    int replan_gate_conflicts(long long current_time);
+    Gate* get_booked_gate(Flight* flight);
+    GateTimelineStats get_timeline_stats();
+    
     // Get gate by ID
     Gate* get_gate(int id);
     
     // Statistics
     int get_available_gate_count();
     int get_available_gate_count_by_type(GateType type);
+    int get_pending_count();
+    long long get_last_plan_cost();
+    double get_last_plan_us();
 };
 
 #endif // GATE_MANAGER_H
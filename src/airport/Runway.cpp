@@ -38,17 +38,10 @@ bool Runway::try_reserve(Flight* flight, long long current_time) {
     long long time_since_last = current_time - last_departure_time;
     
     if (time_since_last < required_separation) {
-        // Must wait for wake turbulence to dissipate
-        struct timespec timeout;
-        timeout.tv_sec = (required_separation - time_since_last) / 1000;
-        timeout.tv_nsec = ((required_separation - time_since_last) % 1000) * 1000000;
-        
-        int result = pthread_cond_timedwait(&runway_clear, &runway_mutex, &timeout);
-        
-        if (result != 0 || !available) {
-            pthread_mutex_unlock(&runway_mutex);
-            return false;
-        }
+        // Wake turbulence has not dissipated - the sequencer decides when
+        // to come back, so do not sit on the lock waiting
+        pthread_mutex_unlock(&runway_mutex);
+        return false;
     }
     
     // Reserve runway
@@ -85,6 +78,10 @@ int Runway::get_wake_separation_time(AircraftClass trailing_class) {
     return WAKE_SEPARATION[last_aircraft_class][trailing_class];
 }
 
+int Runway::wake_separation(AircraftClass leading_class, AircraftClass trailing_class) {
+    return WAKE_SEPARATION[leading_class][trailing_class];
+}
+
 bool Runway::is_available() {
     pthread_mutex_lock(&runway_mutex);
     bool avail = available;
@@ -98,3 +95,17 @@ Flight* Runway::get_current_flight() {
     pthread_mutex_unlock(&runway_mutex);
     return flight;
 }
+
+long long Runway::get_last_release_time() {
+    pthread_mutex_lock(&runway_mutex);
+    long long time = last_departure_time;
+    pthread_mutex_unlock(&runway_mutex);
+    return time;
+}
+
+AircraftClass Runway::get_last_aircraft_class() {
+    pthread_mutex_lock(&runway_mutex);
+    AircraftClass last = last_aircraft_class;
+    pthread_mutex_unlock(&runway_mutex);
+    return last;
+}
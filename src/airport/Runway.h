@@ -34,12 +34,15 @@ public:
     
     // Check wake turbulence separation requirement
     int get_wake_separation_time(AircraftClass trailing_class);
+    static int wake_separation(AircraftClass leading_class, AircraftClass trailing_class);
     
     // Getters
     int get_id() const { return id; }
     string get_name() const { return name; }
     bool is_available();
     Flight* get_current_flight();
+    long long get_last_release_time();
+    AircraftClass get_last_aircraft_class();
 };
 
 #endif // RUNWAY_H
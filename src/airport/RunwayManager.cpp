@@ -1,115 +1,243 @@
 #include "RunwayManager.h"
 #include "../core/Logger.h"
 #include <sstream>
+#include <algorithm>
 
 using namespace std;
 
 RunwayManager::RunwayManager() {
+    runway_count = 0;
+    available_mask = 0;
+    approach_count = 0;
+    for (int i = 0; i < MAX_RUNWAYS; i++) {
+        runways[i] = nullptr;
+        busy_until[i] = 0;
+    }
     pthread_mutex_init(&manager_mutex, nullptr);
 }
 
 RunwayManager::~RunwayManager() {
     pthread_mutex_destroy(&manager_mutex);
     
-    for (Runway* runway : runways) {
-        delete runway;
+    for (int i = 0; i < runway_count; i++) {
+        delete runways[i];
     }
 }
 
 void RunwayManager::add_runway(Runway* runway) {
     pthread_mutex_lock(&manager_mutex);
-    runways.push_back(runway);
+    
+    int index = runway_count.load();
+    if (index >= MAX_RUNWAYS) {
+        pthread_mutex_unlock(&manager_mutex);
+        Logger::get_instance()->log_event("[RunwayManager] Runway limit reached - " + runway->get_name() + " not added");
+        delete runway;
+        return;
+    }
+    
+    runways[index] = runway;
+    busy_until[index] = 0;
+    runway_count.store(index + 1, memory_order_release);
+    if (runway->is_available()) {
+        available_mask.fetch_or(1ULL << index);
+    }
+    
     pthread_mutex_unlock(&manager_mutex);
 }
 
-Runway* RunwayManager::allocate_runway(Flight* flight, long long current_time) {
-    // Phase 1: Find available runway (coarse-grained lock for search)
+bool RunwayManager::claim(int index, Flight* flight, long long current_time) {
+    uint64_t bit = 1ULL << index;
+    if (!(available_mask.fetch_and(~bit) & bit)) {
+        return false;  // Someone else cleared it first
+    }
+    if (runways[index]->try_reserve(flight, current_time)) {
+        busy_until[index].store(current_time + LANDING_OCCUPANCY, memory_order_relaxed);
+        return true;
+    }
+    available_mask.fetch_or(bit);
+    return false;
+}
+
+int RunwayManager::index_of(int runway_id) {
+    int count = runway_count.load(memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        if (runways[i]->get_id() == runway_id) return i;
+    }
+    return -1;
+}
+
+void RunwayManager::resequence_locked(long long current_time) {
+    if (approach_queue.empty()) return;
+    
+    vector<Flight*> waiting;
+    vector<SequenceRequest> requests;
+    for (auto& pair : approach_queue) {
+        SequenceRequest request;
+        request.key = waiting.size();
+        request.weight_class = pair.first->aircraft->weight_class;
+        request.earliest_time = max(current_time, pair.second.requested_time);
+        request.priority = pair.first->priority;
+        waiting.push_back(pair.first);
+        requests.push_back(request);
+    }
+    
+    int count = runway_count.load();
+    uint64_t mask = available_mask.load();
+    vector<RunwayState> states;
+    for (int i = 0; i < count; i++) {
+        RunwayState state;
+        state.free_at = (mask >> i) & 1 ? current_time : max(current_time, busy_until[i].load());
+        state.last_release = runways[i]->get_last_release_time();
+        state.last_class = runways[i]->get_last_aircraft_class();
+        states.push_back(state);
+    }
+    
+    vector<SequenceSlot> slots;
+    sequencer.sequence(requests, states, slots);
+    
+    // Slots come back in landing order
+    vector<int> next_position(count, 0);
+    for (const SequenceSlot& s : slots) {
+        RunwaySlot& slot = approach_queue[waiting[s.key]].slot;
+        slot.runway = runways[s.runway_index];
+        slot.slot_time = s.slot_time;
+        slot.delay = s.slot_time - approach_queue[waiting[s.key]].requested_time;
+        slot.position = next_position[s.runway_index]++;
+    }
+}
+
+RunwaySlot RunwayManager::request_landing_slot(Flight* flight, long long current_time) {
     pthread_mutex_lock(&manager_mutex);
     
+    ApproachEntry& entry = approach_queue[flight];
+    approach_count = approach_queue.size();
+    entry.requested_time = current_time;
+    entry.slot.runway = nullptr;
+    resequence_locked(current_time);
+    RunwaySlot slot = entry.slot;
+    
+    pthread_mutex_unlock(&manager_mutex);
+    return slot;
+}
+
+void RunwayManager::cancel_landing_slot(Flight* flight) {
+    pthread_mutex_lock(&manager_mutex);
+    approach_queue.erase(flight);
+    approach_count = approach_queue.size();
+    pthread_mutex_unlock(&manager_mutex);
+}
+
+RunwaySlot RunwayManager::get_landing_slot(Flight* flight) {
+    RunwaySlot slot = {nullptr, 0, 0, 0};
+    pthread_mutex_lock(&manager_mutex);
+    auto it = approach_queue.find(flight);
+    if (it != approach_queue.end()) {
+        slot = it->second.slot;
+    }
+    pthread_mutex_unlock(&manager_mutex);
+    return slot;
+}
+
+Runway* RunwayManager::allocate_runway(Flight* flight, long long current_time) {
     Runway* chosen_runway = nullptr;
     
-    // Try to find an available runway
-    for (Runway* runway : runways) {
-        if (runway->is_available()) {
-            chosen_runway = runway;
-            break;
+    if (approach_count.load() > 0) {
+        pthread_mutex_lock(&manager_mutex);
+        auto it = approach_queue.find(flight);
+        if (it != approach_queue.end()) {
+            // Sequenced: own runway only, and only when next in line there
+            const RunwaySlot& slot = it->second.slot;
+            int index = slot.runway ? index_of(slot.runway->get_id()) : -1;
+            if (index >= 0 && slot.position == 0 && claim(index, flight, current_time)) {
+                chosen_runway = slot.runway;
+                approach_queue.erase(it);
+                approach_count = approach_queue.size();
+                resequence_locked(current_time);
+            }
+            pthread_mutex_unlock(&manager_mutex);
+            
+            if (chosen_runway) {
+                std::ostringstream log_msg;
+                log_msg << "[RunwayManager] Flight " << flight->flight_id 
+                        << " allocated runway " << chosen_runway->get_name();
+                Logger::get_instance()->log_event(log_msg.str());
+            }
+            return chosen_runway;
         }
+        pthread_mutex_unlock(&manager_mutex);
     }
     
-    pthread_mutex_unlock(&manager_mutex);
-    // END search phase
-    
-    if (chosen_runway == nullptr) {
-        return nullptr; // No runway available
+    // Unsequenced: lowest free bit first; runways still in wake
+    // turbulence are skipped for the rest of this call
+    uint64_t refused = 0;
+    uint64_t mask = available_mask.load();
+    while ((mask & ~refused) != 0) {
+        int index = __builtin_ctzll(mask & ~refused);
+        if (claim(index, flight, current_time)) {
+            chosen_runway = runways[index];
+            break;
+        }
+        refused |= 1ULL << index;
+        mask = available_mask.load();
     }
     
-    // Phase 2: Try to reserve chosen runway (fine-grained lock in Runway class)
-    if (chosen_runway->try_reserve(flight, current_time)) {
+    if (chosen_runway) {
         // Log allocation
         std::ostringstream log_msg;
         log_msg << "[RunwayManager] Flight " << flight->flight_id 
                 << " allocated runway " << chosen_runway->get_name();
         Logger::get_instance()->log_event(log_msg.str());
-        
-        return chosen_runway;
     }
     
-    // Runway became unavailable or wake turbulence wait failed
-    return nullptr;
+    // nullptr: no runway free or wake turbulence not yet clear
+    return chosen_runway;
 }
 
 void RunwayManager::release_runway(int runway_id, long long current_time) {
-    pthread_mutex_lock(&manager_mutex);
+    int index = index_of(runway_id);
+    if (index < 0) return;
+    Runway* runway = runways[index];
     
-    for (Runway* runway : runways) {
-        if (runway->get_id() == runway_id) {
-            pthread_mutex_unlock(&manager_mutex);
-            
-            // Release with runway's fine-grained lock
-            runway->release(current_time);
-            
-            std::ostringstream log_msg;
-            log_msg << "[RunwayManager] Runway " << runway->get_name() << " released";
-            Logger::get_instance()->log_event(log_msg.str());
-            
-            return;
-        }
+    // Release with runway's fine-grained lock, then publish the free bit
+    runway->release(current_time);
+    available_mask.fetch_or(1ULL << index);
+    
+    // Real clearing time may differ from the plan
+    if (approach_count.load() > 0) {
+        pthread_mutex_lock(&manager_mutex);
+        resequence_locked(current_time);
+        pthread_mutex_unlock(&manager_mutex);
     }
     
-    pthread_mutex_unlock(&manager_mutex);
+    std::ostringstream log_msg;
+    log_msg << "[RunwayManager] Runway " << runway->get_name() << " released";
+    Logger::get_instance()->log_event(log_msg.str());
 }
 
 Runway* RunwayManager::get_runway(int id) {
-    pthread_mutex_lock(&manager_mutex);
-    
-    for (Runway* runway : runways) {
-        if (runway->get_id() == id) {
-            pthread_mutex_unlock(&manager_mutex);
-            return runway;
-        }
-    }
-    
-    pthread_mutex_unlock(&manager_mutex);
-    return nullptr;
+    int index = index_of(id);
+    return index >= 0 ? runways[index] : nullptr;
 }
 
 std::vector<Runway*> RunwayManager::get_all_runways() {
-    pthread_mutex_lock(&manager_mutex);
-    std::vector<Runway*> copy = runways;
-    pthread_mutex_unlock(&manager_mutex);
-    return copy;
+    int count = runway_count.load(memory_order_acquire);
+    return std::vector<Runway*>(runways, runways + count);
 }
 
 int RunwayManager::get_available_runway_count() {
+    return __builtin_popcountll(available_mask.load(memory_order_relaxed));
+}
+
+int RunwayManager::get_approach_queue_length() {
     pthread_mutex_lock(&manager_mutex);
-    
-    int count = 0;
-    for (Runway* runway : runways) {
-        if (runway->is_available()) {
-            count++;
-        }
-    }
-    
+    int count = approach_queue.size();
     pthread_mutex_unlock(&manager_mutex);
     return count;
 }
+
+double RunwayManager::get_average_sequencing_us() {
+    pthread_mutex_lock(&manager_mutex);
+    double us = sequencer.get_average_decision_us();
+    pthread_mutex_unlock(&manager_mutex);
+    return us;
+}
@@ -2,23 +2,79 @@
 #define RUNWAY_MANAGER_H
 
 #include "Runway.h"
+#include "RunwaySequencer.h"
 #include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
 #include <pthread.h>
 
 using namespace std;
 
+// Landing slot planned by the sequencer
+struct RunwaySlot {
+    Runway* runway;         // nullptr if the flight is not sequenced
+    long long slot_time;
+    long long delay;        // Planned wait past the flight's request time
+    int position;           // Place in the runway's landing order (0 = next)
+};
+
+// Approaching flights are sequenced together: each gets a runway and a
+// landing slot from RunwaySequencer, re-planned whenever a flight joins,
+// lands or leaves the queue. allocate_runway only lets a sequenced flight
+// take its own runway once every flight planned ahead of it there has
+// landed, so the plan - not polling order - decides who lands next.
+//
+// Availability is one atomic bitmask (bit i = runways[i] is free).
+// Claiming a runway clears its bit with a single atomic op before the
+// runway's own lock is touched, release sets it again, and the free count
+// is a popcount - neither takes manager_mutex, which only guards the
+// approach queue. Runways are added before flights start and never removed.
+
 class RunwayManager {
 private:
-    vector<Runway*> runways;
+    static constexpr long long LANDING_OCCUPANCY = 30;  // 3s landing roll
+    
+public:
+    static constexpr int MAX_RUNWAYS = 64;  // One bit each in available_mask
+    
+private:
+    Runway* runways[MAX_RUNWAYS];
+    atomic<int> runway_count;
+    atomic<uint64_t> available_mask;
+    atomic<long long> busy_until[MAX_RUNWAYS];  // Planned end of each runway's current landing
+    
+    struct ApproachEntry {
+        long long requested_time;
+        RunwaySlot slot;
+    };
+    unordered_map<Flight*, ApproachEntry> approach_queue;
+    atomic<int> approach_count;         // approach_queue.size(), readable without the lock
+    RunwaySequencer sequencer;
+    
     pthread_mutex_t manager_mutex;
     
+    // Re-plan every approaching flight (caller holds manager_mutex)
+    void resequence_locked(long long current_time);
+    
+    // Clear runway index's bit and reserve it; the bit is restored if the
+    // runway refuses (wake turbulence)
+    bool claim(int index, Flight* flight, long long current_time);
+    int index_of(int runway_id);
+
 public:
     RunwayManager();
     ~RunwayManager();
     
     void add_runway(Runway* runway);
     
-    // Allocate runway for flight
+    // Join the approach sequence (or re-plan an existing entry)
+    RunwaySlot request_landing_slot(Flight* flight, long long current_time);
+    void cancel_landing_slot(Flight* flight);
+    RunwaySlot get_landing_slot(Flight* flight);
+    
+    // Allocate runway for flight (a sequenced flight only gets its slot's
+    // runway, and only when it is next in line there)
     Runway* allocate_runway(Flight* flight, long long current_time);
     
     // Release runway
@@ -32,6 +88,8 @@ public:
     
     // Statistics
     int get_available_runway_count();
+    int get_approach_queue_length();
+    double get_average_sequencing_us();
 };
 
 #endif // RUNWAY_MANAGER_H
@@ -0,0 +1,136 @@
+#include "RunwaySequencer.h"
+#include "Runway.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+using namespace std;
+
+RunwaySequencer::RunwaySequencer(int max_shift, int lookahead, long long occupancy)
+    : max_shift(min(max(max_shift, 0), 31)), lookahead(max(lookahead, 1)), occupancy(occupancy),
+      decisions(0), total_ns(0) {
+}
+
+long long RunwaySequencer::weight(int priority) {
+    // Emergency delay costs 11x a low-priority flight's
+    int p = min(max(priority, 0), 100);
+    return 1 + (100 - p) / 10;
+}
+
+long long RunwaySequencer::slot_on(const SequenceRequest& f, const RunwayState& r) const {
+    long long t = max(f.earliest_time, r.free_at);
+    return max(t, r.last_release + Runway::wake_separation(r.last_class, f.weight_class));
+}
+
+long long RunwaySequencer::place(const SequenceRequest& f, const vector<RunwayState>& runways) const {
+    long long best = LLONG_MAX;
+    for (const RunwayState& r : runways) {
+        best = min(best, slot_on(f, r));
+    }
+    return best;
+}
+
+void RunwaySequencer::land(RunwayState& state, const SequenceRequest& f, long long slot_time) const {
+    state.free_at = slot_time + occupancy;
+    state.last_release = slot_time + occupancy;
+    state.last_class = f.weight_class;
+}
+
+int RunwaySequencer::candidates(int position, int* out) const {
+    int n = flights.size();
+    int first = max(0, position - max_shift);
+    int last = min(n - 1, position + max_shift);
+    
+    // A flight already shifted max_shift places must go now
+    if (position - max_shift >= 0 && !done[position - max_shift]) {
+        out[0] = position - max_shift;
+        return 1;
+    }
+    
+    int count = 0;
+    for (int i = first; i <= last; i++) {
+        if (!done[i]) out[count++] = i;
+    }
+    return count;
+}
+
+long long RunwaySequencer::search(int position, int depth, vector<RunwayState>& runways,
+                                  int* best_flight, int* best_runway) {
+    if (position == (int)flights.size()) return 0;
+    
+    int options[64];
+    int count = candidates(position, options);
+    
+    if (depth == 0) {
+        // Horizon reached: flights still waiting in the window are charged
+        // at least the delay they would get if placed next
+        long long pending = 0;
+        for (int k = 0; k < count; k++) {
+            const SequenceRequest& f = flights[options[k]];
+            pending += weight(f.priority) * (place(f, runways) - f.earliest_time);
+        }
+        return pending;
+    }
+    
+    long long best = LLONG_MAX;
+    for (int k = 0; k < count; k++) {
+        const SequenceRequest& f = flights[options[k]];
+        for (size_t r = 0; r < runways.size(); r++) {
+            long long t = slot_on(f, runways[r]);
+            long long cost = weight(f.priority) * (t - f.earliest_time);
+            if (cost >= best) continue;  // Cannot beat the best plan so far
+            
+            RunwayState saved = runways[r];
+            land(runways[r], f, t);
+            done[options[k]] = 1;
+            cost += search(position + 1, depth - 1, runways, nullptr, nullptr);
+            done[options[k]] = 0;
+            runways[r] = saved;
+            
+            if (cost < best) {
+                best = cost;
+                if (best_flight) {
+                    *best_flight = options[k];
+                    *best_runway = r;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+void RunwaySequencer::sequence(const vector<SequenceRequest>& requests, const vector<RunwayState>& runways,
+                               vector<SequenceSlot>& slots) {
+    slots.clear();
+    if (requests.empty() || runways.empty()) return;
+    
+    auto start = chrono::steady_clock::now();
+    
+    // FCFS reference order (emergencies win through their weight)
+    flights = requests;
+    stable_sort(flights.begin(), flights.end(), [](const SequenceRequest& a, const SequenceRequest& b) {
+        return a.earliest_time < b.earliest_time;
+    });
+    done.assign(flights.size(), 0);
+    
+    vector<RunwayState> state = runways;
+    
+    for (int position = 0; position < (int)flights.size(); position++) {
+        int chosen = -1, runway = 0;
+        search(position, lookahead, state, &chosen, &runway);
+        
+        // Commit the first step of the best plan
+        const SequenceRequest& f = flights[chosen];
+        SequenceSlot slot;
+        slot.key = f.key;
+        slot.runway_index = runway;
+        slot.slot_time = slot_on(f, state[runway]);
+        slot.delay = slot.slot_time - f.earliest_time;
+        land(state[runway], f, slot.slot_time);
+        done[chosen] = 1;
+        slots.push_back(slot);
+    }
+    
+    decisions += flights.size();
+    total_ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+}
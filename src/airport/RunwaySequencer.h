@@ -0,0 +1,80 @@
+#ifndef RUNWAY_SEQUENCER_H
+#define RUNWAY_SEQUENCER_H
+
+#include "Aircraft.h"
+#include <vector>
+
+using namespace std;
+
+// RunwaySequencer assigns runways and landing slots to a queue of
+// approaching flights, minimizing total priority-weighted delay subject to
+// wake-turbulence separation.
+//
+// Constrained position shifting: flights start in first-come-first-served
+// order (by earliest landing time) and no flight lands more than max_shift
+// positions away from it. Each position is decided by a rolling-horizon
+// search: every allowed candidate is tried on every runway, with an
+// exhaustive search over the next lookahead positions; flights still
+// waiting at the horizon are charged the delay they would get next. The
+// first step of the cheapest plan is committed and the horizon slides on,
+// so one decision costs at most ((2*max_shift+1) * runways)^lookahead
+// placements. Deeper lookahead pays off more than wider shifting (see
+// benchmarks/runway_sequencing_benchmark.cpp).
+//
+// Pure computation - the caller serializes access.
+
+struct SequenceRequest {
+    int key;                    // Caller's identifier, echoed in the slot
+    AircraftClass weight_class;
+    long long earliest_time;    // Cannot land before this
+    int priority;               // 0 = Emergency .. 100 = Low
+};
+
+struct RunwayState {
+    long long free_at;          // Current operation clears the runway
+    long long last_release;     // When the last flight cleared it
+    AircraftClass last_class;   // Class of that flight (wake leader)
+};
+
+struct SequenceSlot {
+    int key;
+    int runway_index;
+    long long slot_time;
+    long long delay;            // slot_time - earliest_time
+};
+
+class RunwaySequencer {
+private:
+    int max_shift;
+    int lookahead;
+    long long occupancy;        // Time a landing keeps the runway busy
+    
+    // Scratch for the current run
+    vector<SequenceRequest> flights;    // In FCFS order
+    vector<char> done;
+    
+    long long decisions;
+    long long total_ns;
+    
+    long long slot_on(const SequenceRequest& f, const RunwayState& runway) const;
+    long long place(const SequenceRequest& f, const vector<RunwayState>& runways) const;
+    void land(RunwayState& state, const SequenceRequest& f, long long slot_time) const;
+    int candidates(int position, int* out) const;
+    long long search(int position, int depth, vector<RunwayState>& runways,
+                     int* best_flight, int* best_runway);
+    
+public:
+    RunwaySequencer(int max_shift = 1, int lookahead = 3, long long occupancy = 30);
+    
+    // Plan every flight; slots come back in landing order
+    void sequence(const vector<SequenceRequest>& requests, const vector<RunwayState>& runways,
+                  vector<SequenceSlot>& slots);
+    
+    static long long weight(int priority);
+    
+    long long get_decisions() const { return decisions; }
+    double get_average_decision_us() const { return decisions > 0 ? total_ns / 1000.0 / decisions : 0.0; }
+    long long get_occupancy() const { return occupancy; }
+};
+
+#endif // RUNWAY_SEQUENCER_H
@@ -1,11 +1,11 @@
 #include "TaxiwayGraph.h"
-#include <queue>
-#include <unordered_set>
 #include <algorithm>
+#include <functional>
+#include <climits>
 
 using namespace std;
 
-TaxiwayGraph::TaxiwayGraph() : gridlock_threshold_seconds(300) {
+TaxiwayGraph::TaxiwayGraph() : routes_dirty(true), gridlock_threshold_seconds(300) {
     pthread_mutex_init(&graph_mutex, nullptr);
 }
 
@@ -22,7 +22,10 @@ void TaxiwayGraph::add_node(int id, const string& name) {
     node.occupied = false;
     node.occupying_flight_id = -1;
     
+    node_index[id] = nodes.size();
     nodes.push_back(node);
+    schedule.push_back(ResourceCalendar());
+    routes_dirty = true;
     
     pthread_mutex_unlock(&graph_mutex);
 }
@@ -37,129 +40,553 @@ void TaxiwayGraph::add_edge(int from, int to, int weight) {
     edge.to_node = to;
     edge.weight = weight;
     edges.push_back(edge);
+    routes_dirty = true;
     
     pthread_mutex_unlock(&graph_mutex);
 }
 
-vector<int> TaxiwayGraph::find_path(int from, int to) {
+void TaxiwayGraph::mark_endpoint(int node_id) {
+    pthread_mutex_lock(&graph_mutex);
+    if (find(endpoints.begin(), endpoints.end(), node_id) == endpoints.end()) {
+        endpoints.push_back(node_id);
+        routes_dirty = true;
+    }
+    pthread_mutex_unlock(&graph_mutex);
+}
+
+void TaxiwayGraph::build_routes() {
+    get_routes();
+}
+
+shared_ptr<const TaxiRoutes> TaxiwayGraph::get_routes() {
     pthread_mutex_lock(&graph_mutex);
+    if (routes_dirty || !routes) {
+        routes = compile_locked();
+        routes_dirty = false;
+    }
+    shared_ptr<const TaxiRoutes> snapshot = routes;
+    pthread_mutex_unlock(&graph_mutex);
+    return snapshot;
+}
+
+shared_ptr<const TaxiRoutes> TaxiwayGraph::compile_locked() const {
+    shared_ptr<TaxiRoutes> r = make_shared<TaxiRoutes>();
+    int n = nodes.size();
+    for (int i = 0; i < n; i++) {
+        r->node_ids.push_back(nodes[i].id);
+        r->index_of[nodes[i].id] = i;
+    }
     
-    vector<int> path;
+    // CSR adjacency, plus its reverse for the endpoint trees
+    r->offsets.assign(n + 1, 0);
+    vector<int> rev_offsets(n + 1, 0);
+    vector<pair<int, int>> valid;   // (from, to) indices
+    vector<int> valid_weight;
+    for (const TaxiwayEdge& e : edges) {
+        auto from = r->index_of.find(e.from_node);
+        auto to = r->index_of.find(e.to_node);
+        if (from == r->index_of.end() || to == r->index_of.end()) continue;
+        valid.push_back(make_pair(from->second, to->second));
+        valid_weight.push_back(e.weight);
+        r->offsets[from->second + 1]++;
+        rev_offsets[to->second + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        r->offsets[v + 1] += r->offsets[v];
+        rev_offsets[v + 1] += rev_offsets[v];
+    }
     
-    if (from == to) {
-        path.push_back(from);
-        pthread_mutex_unlock(&graph_mutex);
-        return path;
+    r->targets.resize(valid.size());
+    r->weights.resize(valid.size());
+    vector<int> rev_sources(valid.size()), rev_weights(valid.size());
+    vector<int> cursor(r->offsets.begin(), r->offsets.end() - 1);
+    vector<int> rev_cursor(rev_offsets.begin(), rev_offsets.end() - 1);
+    for (size_t k = 0; k < valid.size(); k++) {
+        int at = cursor[valid[k].first]++;
+        r->targets[at] = valid[k].second;
+        r->weights[at] = valid_weight[k];
+        int rev_at = rev_cursor[valid[k].second]++;
+        rev_sources[rev_at] = valid[k].first;
+        rev_weights[rev_at] = valid_weight[k];
     }
     
-    // BFS for shortest path
-    queue<int> q;
-    unordered_map<int, int> parent;
-    unordered_set<int> visited;
+    // One reverse Dijkstra per endpoint
+    r->endpoint_slot.assign(n, -1);
+    r->endpoint_count = 0;
+    vector<int> endpoint_index;
+    for (int id : endpoints) {
+        auto it = r->index_of.find(id);
+        if (it == r->index_of.end()) continue;
+        r->endpoint_slot[it->second] = r->endpoint_count++;
+        endpoint_index.push_back(it->second);
+    }
+    r->next_hop.assign((size_t)r->endpoint_count * n, -1);
+    r->dist_to.assign((size_t)r->endpoint_count * n, INT_MAX);
     
-    q.push(from);
-    visited.insert(from);
+    vector<pair<int, int>> heap;
+    for (int slot = 0; slot < r->endpoint_count; slot++) {
+        int* dist = &r->dist_to[(size_t)slot * n];
+        int* next = &r->next_hop[(size_t)slot * n];
+        int target = endpoint_index[slot];
+        dist[target] = 0;
+        next[target] = target;
+        heap.clear();
+        heap.push_back(make_pair(0, target));
+        
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+            pair<int, int> top = heap.back();
+            heap.pop_back();
+            int u = top.second;
+            if (top.first > dist[u]) continue;  // Stale entry
+            
+            for (int k = rev_offsets[u]; k < rev_offsets[u + 1]; k++) {
+                int w = rev_sources[k];
+                int candidate = dist[u] + rev_weights[k];
+                if (candidate < dist[w]) {
+                    dist[w] = candidate;
+                    next[w] = u;
+                    heap.push_back(make_pair(candidate, w));
+                    push_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+                }
+            }
+        }
+    }
+    
+    // Landmarks spread evenly over the endpoints
+    int landmark_count = min(r->endpoint_count, MAX_LANDMARKS);
+    for (int k = 0; k < landmark_count; k++) {
+        r->landmarks.push_back(k * r->endpoint_count / landmark_count);
+    }
+    
+    return r;
+}
+
+int TaxiwayGraph::lower_bound_time(const TaxiRoutes& r, int v, int to) {
+    size_t n = r.node_ids.size();
+    int slot = r.endpoint_slot[to];
+    if (slot >= 0) {
+        return r.dist_to[slot * n + v];     // Exact (INT_MAX if unreachable)
+    }
+    
+    // Landmark (ALT) bound: d(v, to) >= d(v, L) - d(to, L)
+    int bound = 0;
+    for (int l : r.landmarks) {
+        int dv = r.dist_to[l * n + v];
+        int dt = r.dist_to[l * n + to];
+        if (dv != INT_MAX && dt != INT_MAX && dv - dt > bound) bound = dv - dt;
+    }
+    return bound;
+}
+
+vector<int> TaxiwayGraph::search(const TaxiRoutes& r, int from, int to, int* cost) {
+    int n = r.node_ids.size();
+    
+    // Per-thread scratch; generation stamps avoid clearing it per query
+    static thread_local vector<int> dist, parent;
+    static thread_local vector<unsigned> seen, closed;
+    static thread_local unsigned generation = 0;
+    static thread_local vector<pair<int, int>> heap;
+    if ((int)dist.size() < n) {
+        dist.resize(n);
+        parent.resize(n);
+        seen.resize(n, 0);
+        closed.resize(n, 0);
+    }
+    if (++generation == 0) {
+        fill(seen.begin(), seen.end(), 0);
+        fill(closed.begin(), closed.end(), 0);
+        generation = 1;
+    }
+    
+    auto estimate = [&](int v) { return lower_bound_time(r, v, to); };
+    
+    heap.clear();
+    dist[from] = 0;
     parent[from] = -1;
+    seen[from] = generation;
+    heap.push_back(make_pair(estimate(from), from));
     
     bool found = false;
-    
-    while (!q.empty() && !found) {
-        int current = q.front();
-        q.pop();
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+        int u = heap.back().second;
+        heap.pop_back();
+        if (closed[u] == generation) continue;
+        closed[u] = generation;
+        if (u == to) {
+            found = true;
+            break;
+        }
         
-        if (adjacency_list.find(current) != adjacency_list.end()) {
-            for (int neighbor : adjacency_list[current]) {
-                if (visited.find(neighbor) == visited.end()) {
-                    visited.insert(neighbor);
-                    parent[neighbor] = current;
-                    q.push(neighbor);
-                    
-                    if (neighbor == to) {
-                        found = true;
-                        break;
-                    }
-                }
+        for (int k = r.offsets[u]; k < r.offsets[u + 1]; k++) {
+            int v = r.targets[k];
+            int candidate = dist[u] + r.weights[k];
+            if (closed[v] != generation && (seen[v] != generation || candidate < dist[v])) {
+                seen[v] = generation;
+                dist[v] = candidate;
+                parent[v] = u;
+                heap.push_back(make_pair(candidate + estimate(v), v));
+                push_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
             }
         }
     }
     
-    // Reconstruct path
-    if (found) {
-        int current = to;
-        while (current != -1) {
-            path.push_back(current);
-            current = parent[current];
+    vector<int> path;
+    if (!found) {
+        *cost = -1;
+        return path;
+    }
+    *cost = dist[to];
+    for (int v = to; v != -1; v = parent[v]) {
+        path.push_back(r.node_ids[v]);
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+vector<int> TaxiwayGraph::find_path(int from, int to) {
+    shared_ptr<const TaxiRoutes> r = get_routes();
+    vector<int> path;
+    
+    auto from_it = r->index_of.find(from);
+    auto to_it = r->index_of.find(to);
+    if (from_it == r->index_of.end() || to_it == r->index_of.end()) {
+        return path;
+    }
+    int s = from_it->second, t = to_it->second;
+    
+    int slot = r->endpoint_slot[t];
+    if (slot >= 0) {
+        // Gate/runway target: follow the precomputed tree
+        int n = r->node_ids.size();
+        const int* next = &r->next_hop[(size_t)slot * n];
+        if (next[s] < 0) return path;
+        for (int v = s; ; v = next[v]) {
+            path.push_back(r->node_ids[v]);
+            if (v == t) break;
         }
-        reverse(path.begin(), path.end());
+        return path;
     }
     
-    pthread_mutex_unlock(&graph_mutex);
-    return path;
+    int cost;
+    return search(*r, s, t, &cost);
+}
+
+int TaxiwayGraph::get_path_time(int from, int to) {
+    shared_ptr<const TaxiRoutes> r = get_routes();
+    auto from_it = r->index_of.find(from);
+    auto to_it = r->index_of.find(to);
+    if (from_it == r->index_of.end() || to_it == r->index_of.end()) {
+        return -1;
+    }
+    int s = from_it->second, t = to_it->second;
+    
+    int slot = r->endpoint_slot[t];
+    if (slot >= 0) {
+        int d = r->dist_to[(size_t)slot * r->node_ids.size() + s];
+        return d == INT_MAX ? -1 : d;
+    }
+    
+    int cost;
+    search(*r, s, t, &cost);
+    return cost;
 }
 
 bool TaxiwayGraph::try_reserve_path(const vector<int>& path, int flight_id) {
     pthread_mutex_lock(&graph_mutex);
-    
+
     // Check if all nodes in path are free
     for (int node_id : path) {
-        for (TaxiwayNode& node : nodes) {
-            if (node.id == node_id && node.occupied) {
-                pthread_mutex_unlock(&graph_mutex);
-                return false; // Path blocked
-            }
+        auto it = node_index.find(node_id);
+        if (it != node_index.end() && nodes[it->second].occupied) {
+            pthread_mutex_unlock(&graph_mutex);
+            return false; // Path blocked
         }
     }
-    
+
     // Reserve all nodes in path
     for (int node_id : path) {
-        for (TaxiwayNode& node : nodes) {
-            if (node.id == node_id) {
-                node.occupied = true;
-                node.occupying_flight_id = flight_id;
-            }
+        auto it = node_index.find(node_id);
+        if (it != node_index.end()) {
+            nodes[it->second].occupied = true;
+            nodes[it->second].occupying_flight_id = flight_id;
         }
     }
-    
+
     pthread_mutex_unlock(&graph_mutex);
     return true;
 }
 
 void TaxiwayGraph::release_path(const vector<int>& path) {
     pthread_mutex_lock(&graph_mutex);
-    
+
     for (int node_id : path) {
-        for (TaxiwayNode& node : nodes) {
-            if (node.id == node_id) {
-                node.occupied = false;
-                node.occupying_flight_id = -1;
+        auto it = node_index.find(node_id);
+        if (it != node_index.end()) {
+            nodes[it->second].occupied = false;
+            nodes[it->second].occupying_flight_id = -1;
+        }
+    }
+
+    pthread_mutex_unlock(&graph_mutex);
+}
+
+// ========== Space-time reservations ==========
+
+bool TaxiwayGraph::plan_locked(const TaxiRoutes& r, int from, int to, int flight_id,
+                               long long start_time, TaxiPlan& plan) {
+    int n = r.node_ids.size();
+
+    // Labels are earliest arrival per node; waiting is folded into moves.
+    // Not exact with holds (see plan_route)
+    static thread_local vector<long long> arrive, enter;
+    static thread_local vector<int> parent;
+    static thread_local vector<unsigned> seen, closed;
+    static thread_local unsigned generation = 0;
+    static thread_local vector<pair<long long, int>> heap;
+    if ((int)arrive.size() < n) {
+        arrive.resize(n);
+        enter.resize(n);
+        parent.resize(n);
+        seen.resize(n, 0);
+        closed.resize(n, 0);
+    }
+    if (++generation == 0) {
+        fill(seen.begin(), seen.end(), 0);
+        fill(closed.begin(), closed.end(), 0);
+        generation = 1;
+    }
+
+    int free_flow = lower_bound_time(r, from, to);
+    if (free_flow == INT_MAX) return false;
+    long long deadline = start_time + free_flow + MAX_PLAN_DELAY;
+
+    heap.clear();
+    arrive[from] = start_time;
+    enter[from] = start_time;
+    parent[from] = -1;
+    seen[from] = generation;
+    heap.push_back(make_pair(start_time + free_flow, from));
+
+    bool found = false;
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<pair<long long, int>>());
+        int u = heap.back().second;
+        heap.pop_back();
+        if (closed[u] == generation) continue;
+        closed[u] = generation;
+        if (u == to) {
+            found = true;
+            break;
+        }
+
+        for (int k = r.offsets[u]; k < r.offsets[u + 1]; k++) {
+            int v = r.targets[k];
+            int w = r.weights[k];
+            if (closed[v] == generation) continue;
+            if (nodes[v].occupied && nodes[v].occupying_flight_id != flight_id) continue;
+
+            // Earliest departure with v free for the whole move (and the
+            // clearance at the destination); u stays held until arrival
+            long long extra = (v == to) ? NODE_CLEARANCE : 1;
+            long long depart = schedule[v].earliest_free(arrive[u], w + extra);
+            if (!schedule[u].is_free(arrive[u], depart + w)) continue;  // Someone needs u first
+
+            long long at = depart + w;
+            int h = lower_bound_time(r, v, to);
+            if (h == INT_MAX || at + h > deadline) continue;
+            if (seen[v] != generation || at < arrive[v]) {
+                seen[v] = generation;
+                arrive[v] = at;
+                enter[v] = depart;
+                parent[v] = u;
+                heap.push_back(make_pair(at + h, v));
+                push_heap(heap.begin(), heap.end(), greater<pair<long long, int>>());
             }
         }
     }
-    
+    if (!found) return false;
+
+    vector<int> route;
+    for (int v = to; v != -1; v = parent[v]) {
+        route.push_back(v);
+    }
+    reverse(route.begin(), route.end());
+
+    plan.flight_id = flight_id;
+    plan.nodes.clear();
+    plan.enter.clear();
+    plan.arrive.clear();
+    plan.leave.clear();
+    plan.start = start_time;
+    plan.end = arrive[to];
+    plan.delay = plan.end - start_time;
+    for (size_t i = 0; i < route.size(); i++) {
+        int v = route[i];
+        plan.nodes.push_back(r.node_ids[v]);
+        plan.enter.push_back(enter[v]);
+        plan.arrive.push_back(arrive[v]);
+        plan.leave.push_back(i + 1 < route.size() ? arrive[route[i + 1]] : arrive[v] + NODE_CLEARANCE);
+        plan.delay -= arrive[v] - enter[v];     // Minus time spent moving
+    }
+    return true;
+}
+
+void TaxiwayGraph::hold_locked(const TaxiRoutes& r, int from, int to, int flight_id, long long since) {
+    // Waits for the next node of the fastest route
+    int next = -1;
+    int slot = r.endpoint_slot[to];
+    if (slot >= 0) {
+        next = r.next_hop[(size_t)slot * r.node_ids.size() + from];
+    } else {
+        int cost;
+        vector<int> path = search(r, from, to, &cost);
+        if (path.size() > 1) next = r.index_of.at(path[1]);
+    }
+
+    TaxiHold hold;
+    hold.node = from;
+    hold.waiting_for = next;
+    hold.since = since;
+    auto it = holds.find(flight_id);
+    if (it != holds.end()) {
+        hold.since = it->second.since;
+        if (it->second.node != from) release_hold_locked(flight_id);
+    }
+    holds[flight_id] = hold;
+
+    if (!nodes[from].occupied) {
+        nodes[from].occupied = true;
+        nodes[from].occupying_flight_id = flight_id;
+    }
+}
+
+void TaxiwayGraph::release_hold_locked(int flight_id) {
+    auto it = holds.find(flight_id);
+    if (it == holds.end()) return;
+    TaxiwayNode& node = nodes[it->second.node];
+    if (node.occupied && node.occupying_flight_id == flight_id) {
+        node.occupied = false;
+        node.occupying_flight_id = -1;
+    }
+    holds.erase(it);
+}
+
+bool TaxiwayGraph::plan_route(int from, int to, int flight_id, long long start_time,
+                              TaxiPlan& plan, bool reserve) {
+    shared_ptr<const TaxiRoutes> r = get_routes();
+    auto from_it = r->index_of.find(from);
+    auto to_it = r->index_of.find(to);
+    if (from_it == r->index_of.end() || to_it == r->index_of.end()) {
+        return false;
+    }
+
+    pthread_mutex_lock(&graph_mutex);
+
+    bool found = plan_locked(*r, from_it->second, to_it->second, flight_id, start_time, plan);
+    if (reserve) {
+        if (found) {
+            release_hold_locked(flight_id);
+            for (size_t i = 0; i < plan.nodes.size(); i++) {
+                schedule[node_index[plan.nodes[i]]].book(plan.enter[i], plan.leave[i], flight_id);
+            }
+        } else {
+            hold_locked(*r, from_it->second, to_it->second, flight_id, start_time);
+        }
+    }
+
     pthread_mutex_unlock(&graph_mutex);
+    return found;
 }
 
-bool TaxiwayGraph::detect_gridlock() {
+void TaxiwayGraph::release_plan(const TaxiPlan& plan) {
     pthread_mutex_lock(&graph_mutex);
-    
-    // Simple gridlock detection: check if any cycles exist in wait-for graph
-    // In production, would implement more sophisticated cycle detection
-    
-    bool gridlock = false;
-    
-    // Count occupied nodes
-    int occupied_count = 0;
-    for (const TaxiwayNode& node : nodes) {
-        if (node.occupied) {
-            occupied_count++;
+    for (size_t i = 0; i < plan.nodes.size(); i++) {
+        auto it = node_index.find(plan.nodes[i]);
+        if (it != node_index.end()) {
+            schedule[it->second].cancel(plan.enter[i], plan.flight_id);
         }
     }
-    
-    // If more than 80% occupied, potential gridlock
-    if (nodes.size() > 0 && occupied_count > (nodes.size() * 80 / 100)) {
-        gridlock = true;
+    pthread_mutex_unlock(&graph_mutex);
+}
+
+void TaxiwayGraph::release_hold(int flight_id) {
+    pthread_mutex_lock(&graph_mutex);
+    release_hold_locked(flight_id);
+    pthread_mutex_unlock(&graph_mutex);
+}
+
+int TaxiwayGraph::holder_of_locked(int index, long long at, int flight_id) {
+    if (index < 0) return -1;
+    const TaxiwayNode& node = nodes[index];
+    if (node.occupied && node.occupying_flight_id != flight_id) {
+        return node.occupying_flight_id;
     }
-    
+    // Otherwise whoever has it booked at or next after that time
+    const CalendarBooking* booking = schedule[index].first_overlap(at, LLONG_MAX);
+    if (booking && booking->flight_id != flight_id) {
+        return booking->flight_id;
+    }
+    return -1;
+}
+
+vector<int> TaxiwayGraph::gridlock_cycles_locked() {
+    // Each holding flight waits for one node, so the wait-for graph has at
+    // most one edge per flight: follow chains, and a chain that comes back
+    // to a flight on it is a cycle. Booked (moving) flights end chains.
+    vector<int> gridlocked;
+    unordered_map<int, int> state;      // Flight -> 1 on current chain, 2 done
+    vector<int> chain;
+
+    for (const auto& entry : holds) {
+        int f = entry.first;
+        chain.clear();
+        while (f >= 0 && state[f] == 0) {
+            auto it = holds.find(f);
+            if (it == holds.end()) break;
+            state[f] = 1;
+            chain.push_back(f);
+            f = holder_of_locked(it->second.waiting_for, it->second.since, f);
+        }
+        if (f >= 0 && state[f] == 1) {
+            auto first = find(chain.begin(), chain.end(), f);
+            gridlocked.insert(gridlocked.end(), first, chain.end());
+        }
+        for (int c : chain) {
+            state[c] = 2;
+        }
+    }
+    return gridlocked;
+}
+
+bool TaxiwayGraph::detect_gridlock() {
+    pthread_mutex_lock(&graph_mutex);
+    bool gridlock = !holds.empty() && !gridlock_cycles_locked().empty();
     pthread_mutex_unlock(&graph_mutex);
     return gridlock;
 }
+
+vector<int> TaxiwayGraph::get_gridlocked_flights() {
+    pthread_mutex_lock(&graph_mutex);
+    vector<int> gridlocked = gridlock_cycles_locked();
+    pthread_mutex_unlock(&graph_mutex);
+    return gridlocked;
+}
+
+int TaxiwayGraph::get_reservation_count() {
+    pthread_mutex_lock(&graph_mutex);
+    int count = 0;
+    for (const ResourceCalendar& calendar : schedule) {
+        count += calendar.get_booking_count();
+    }
+    pthread_mutex_unlock(&graph_mutex);
+    return count;
+}
+
+int TaxiwayGraph::get_node_count() {
+    pthread_mutex_lock(&graph_mutex);
+    int count = nodes.size();
+    pthread_mutex_unlock(&graph_mutex);
+    return count;
+}
@@ -4,7 +4,9 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <memory>
 #include <pthread.h>
+#include "../resources/ResourceCalendar.h"
 
 using namespace std;
 
@@ -21,17 +23,90 @@ struct TaxiwayEdge {
     int weight;  // Time to traverse
 };
 
+// Routing tables compiled from the graph (immutable once built).
+// Nodes are renumbered 0..n-1 and adjacency is stored CSR-style.
+// Endpoints (gates, runway exits) get a reverse shortest-path tree each:
+// next_hop/dist_to hold, for every node, the next node and the remaining
+// time toward that endpoint, so gate<->runway routes are a table walk.
+// A few endpoint trees double as A* landmarks for other queries.
+struct TaxiRoutes {
+    vector<int> node_ids;               // Index -> node id
+    unordered_map<int, int> index_of;   // Node id -> index
+    
+    vector<int> offsets;                // CSR: edges of v are [offsets[v], offsets[v+1])
+    vector<int> targets;
+    vector<int> weights;
+    
+    vector<int> endpoint_slot;          // Index -> endpoint slot, -1 if not an endpoint
+    int endpoint_count;
+    vector<int> next_hop;               // [slot * n + v] -> next index, -1 if unreachable
+    vector<int> dist_to;                // [slot * n + v] -> time to the endpoint
+    vector<int> landmarks;              // Endpoint slots used for A* lower bounds
+};
+
+// A conflict-free taxi route booked in the space-time reservation table.
+// Times are taxi seconds, the unit of edge weights. A flight holds each
+// node from the moment it starts moving onto it until it reaches the next
+// node, so two flights never share a node or pass on a segment.
+struct TaxiPlan {
+    int flight_id;
+    vector<int> nodes;              // Node ids, from -> to
+    vector<long long> enter;        // Node held from
+    vector<long long> arrive;       // Arrival at the node
+    vector<long long> leave;        // Node released (exclusive)
+    long long start;
+    long long end;                  // Arrival at the destination
+    long long delay;                // Waiting on top of the free-flow time
+};
+
+// A flight that found no conflict-free route holds its position and waits
+// for the next node of its fastest route
+struct TaxiHold {
+    int node;                       // Held node (index)
+    int waiting_for;                // Node index it needs next
+    long long since;
+};
+
 class TaxiwayGraph {
 private:
+    static constexpr int MAX_LANDMARKS = 8;
+    static constexpr long long NODE_CLEARANCE = 10;     // Destination held after arrival
+    static constexpr long long MAX_PLAN_DELAY = 600;    // Longest wait a plan may include
+    
     vector<TaxiwayNode> nodes;
+    unordered_map<int, int> node_index;     // Node id -> position (= routes index)
     unordered_map<int, vector<int>> adjacency_list;
     vector<TaxiwayEdge> edges;
+    vector<int> endpoints;              // Node ids routed to by table
+    
+    // Rebuilt on first query after the graph changes; searches run on a
+    // snapshot, outside graph_mutex
+    shared_ptr<const TaxiRoutes> routes;
+    bool routes_dirty;
+    
+    // Space-time reservation table: future bookings per node (by index)
+    vector<ResourceCalendar> schedule;
+    unordered_map<int, TaxiHold> holds;     // Flight id -> position held
     
     pthread_mutex_t graph_mutex;
     
     // Gridlock detection
     long long gridlock_threshold_seconds;
     
+    shared_ptr<const TaxiRoutes> get_routes();
+    shared_ptr<const TaxiRoutes> compile_locked() const;
+    
+    static vector<int> search(const TaxiRoutes& r, int from, int to, int* cost);
+    static int lower_bound_time(const TaxiRoutes& r, int v, int to);
+    
+    // Cooperative A* over (node, time); caller holds graph_mutex
+    bool plan_locked(const TaxiRoutes& r, int from, int to, int flight_id,
+                     long long start_time, TaxiPlan& plan);
+    void hold_locked(const TaxiRoutes& r, int from, int to, int flight_id, long long since);
+    void release_hold_locked(int flight_id);
+    int holder_of_locked(int index, long long at, int flight_id);
+    vector<int> gridlock_cycles_locked();
+    
 public:
     TaxiwayGraph();
     ~TaxiwayGraph();
@@ -39,17 +114,45 @@ public:
     void add_node(int id, const string& name);
     void add_edge(int from, int to, int weight);
     
-    // Find path between two nodes (simple BFS)
+    // Keep a next-hop table toward this node (gate or runway exit)
+    void mark_endpoint(int node_id);
+    
+    // Compile routing tables now instead of on the first query
+    void build_routes();
+    
+    // Fastest path between two nodes by edge weight (empty if unreachable)
     vector<int> find_path(int from, int to);
     
+    // Total traverse time of the fastest path, -1 if unreachable
+    int get_path_time(int from, int to);
+    
     // Reserve path segments
     bool try_reserve_path(const vector<int>& path, int flight_id);
     
     // Release path
     void release_path(const vector<int>& path);
     
-    // Gridlock detection
+    // Plan the earliest conflict-free route from start_time around every
+    // booked plan, waiting at nodes where needed. With reserve the plan is
+    // booked; if none exists within MAX_PLAN_DELAY the flight holds from
+    // (see TaxiHold) until a later plan_route succeeds or release_hold.
+    // The search keeps one label per node, its earliest arrival. Holding
+    // nodes makes the graph non-FIFO: arriving earlier can mean waiting on
+    // a node somebody needs first, so a route only a later arrival admits
+    // may be missed. The plan then waits longer or fails and holds, which
+    // costs delay but never a conflict.
+    bool plan_route(int from, int to, int flight_id, long long start_time,
+                    TaxiPlan& plan, bool reserve = true);
+    void release_plan(const TaxiPlan& plan);
+    void release_hold(int flight_id);
+    
+    // Gridlock: holding flights waiting for each other in a cycle
     bool detect_gridlock();
+    vector<int> get_gridlocked_flights();
+    
+    int get_reservation_count();
+    
+    int get_node_count();
 };
 
 #endif // TAXIWAY_GRAPH_H
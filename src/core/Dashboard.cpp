@@ -1,4 +1,5 @@
 #include "Dashboard.h"
+#include "../resources/Resource.h"
 #include <iostream>
 #include <iomanip>
 #include <cstring>
@@ -42,6 +43,12 @@ Dashboard::Dashboard() {
     metrics.page_fault_count = 0;
     metrics.page_fault_rate = 0.0;
     metrics.current_sim_time = 0;
+    for (int t = 0; t < 7; t++) {
+        metrics.service_utilization[t] = 0.0;
+        metrics.service_queue[t] = 0.0;
+        metrics.service_wait_us[t] = 0.0;
+    }
+    metrics.bottleneck_service = -1;
 }
 
 Dashboard::~Dashboard() {
@@ -172,6 +179,26 @@ void Dashboard::display() {
     
     std::cout << BOLD << MAGENTA << "  └────────────────────────────────────────────────────────────────┘\n\n" << RESET;
     
+    // Ground Services Section
+    std::cout << BOLD << CYAN << "  ┌─────────────────────── Ground Services ────────────────────────┐\n" << RESET;
+    
+    for (int t = 0; t < 7; t++) {
+        double pct = metrics.service_utilization[t] * 100;
+        bool bottleneck = (t == metrics.bottleneck_service);
+        std::cout << "  │  " << (bottleneck ? RED : "") << BOLD << std::left << std::setw(18)
+                  << Resource::type_to_string((ResourceType)t) << RESET << std::right
+                  << create_progress_bar(pct, 10) << " "
+                  << std::fixed << std::setprecision(1) << std::setw(5) << pct << "%"
+                  << "  queue " << std::setprecision(1) << std::setw(4) << metrics.service_queue[t]
+                  << "  wait " << std::setprecision(0) << std::setw(7) << metrics.service_wait_us[t] / 1000.0 << "ms";
+        if (bottleneck) {
+            std::cout << "  " << RED << BOLD << "◀ bottleneck" << RESET;
+        }
+        std::cout << "\n";
+    }
+    
+    std::cout << BOLD << CYAN << "  └────────────────────────────────────────────────────────────────┘\n\n" << RESET;
+    
     // Performance Metrics Section
     std::cout << BOLD << GREEN << "  ┌─────────────────────── Performance Metrics ────────────────────┐\n" << RESET;
     
@@ -26,6 +26,12 @@ struct DashboardMetrics {
     double page_fault_rate;
     
     long long current_sim_time;
+    
+    // Ground-service pools by ResourceType (recent profiler buckets)
+    double service_utilization[7];
+    double service_queue[7];
+    double service_wait_us[7];
+    int bottleneck_service;     // ResourceType, -1 if all idle
 };
 
 class Dashboard {
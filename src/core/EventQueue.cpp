@@ -1,8 +1,7 @@
 #include "EventQueue.h"
 #include <functional>
 
-EventQueue::EventQueue() 
-    : queue(compare) {
+EventQueue::EventQueue() {
     pthread_mutex_init(&queue_mutex, nullptr);
     pthread_cond_init(&event_available, nullptr);
 }
@@ -14,21 +13,42 @@ EventQueue::~EventQueue() {
 
 void EventQueue::push(Event* event) {
     pthread_mutex_lock(&queue_mutex);
-    queue.push(event);
+    heap.push_back(event);
+    push_heap(heap.begin(), heap.end(), compare);
     pthread_cond_signal(&event_available);
     pthread_mutex_unlock(&queue_mutex);
 }
 
+void EventQueue::push_bulk(const vector<Event*>& events) {
+    if (events.empty()) return;
+    
+    pthread_mutex_lock(&queue_mutex);
+    // Sifting each one up costs O(k log n); rebuilding is O(n + k) and
+    // wins once the batch is a sizeable part of the queue
+    if (events.size() * 4 >= heap.size()) {
+        heap.insert(heap.end(), events.begin(), events.end());
+        make_heap(heap.begin(), heap.end(), compare);
+    } else {
+        for (Event* event : events) {
+            heap.push_back(event);
+            push_heap(heap.begin(), heap.end(), compare);
+        }
+    }
+    pthread_cond_broadcast(&event_available);
+    pthread_mutex_unlock(&queue_mutex);
+}
+
 Event* EventQueue::pop() {
     pthread_mutex_lock(&queue_mutex);
     
-    if (queue.empty()) {
+    if (heap.empty()) {
         pthread_mutex_unlock(&queue_mutex);
         return nullptr;
     }
     
-    Event* event = queue.top();
-    queue.pop();
+    pop_heap(heap.begin(), heap.end(), compare);
+    Event* event = heap.back();
+    heap.pop_back();
     pthread_mutex_unlock(&queue_mutex);
     
     return event;
@@ -37,7 +57,7 @@ Event* EventQueue::pop() {
 Event* EventQueue::peek() {
     pthread_mutex_lock(&queue_mutex);
     
-    Event* event = queue.empty() ? nullptr : queue.top();
+    Event* event = heap.empty() ? nullptr : heap.front();
     
     pthread_mutex_unlock(&queue_mutex);
     return event;
@@ -45,14 +65,14 @@ Event* EventQueue::peek() {
 
 bool EventQueue::empty() {
     pthread_mutex_lock(&queue_mutex);
-    bool is_empty = queue.empty();
+    bool is_empty = heap.empty();
     pthread_mutex_unlock(&queue_mutex);
     return is_empty;
 }
 
 size_t EventQueue::size() {
     pthread_mutex_lock(&queue_mutex);
-    size_t s = queue.size();
+    size_t s = heap.size();
     pthread_mutex_unlock(&queue_mutex);
     return s;
 }
@@ -60,12 +80,13 @@ size_t EventQueue::size() {
 Event* EventQueue::wait_for_event() {
     pthread_mutex_lock(&queue_mutex);
     
-    while (queue.empty()) {
+    while (heap.empty()) {
         pthread_cond_wait(&event_available, &queue_mutex);
     }
     
-    Event* event = queue.top();
-    queue.pop();
+    pop_heap(heap.begin(), heap.end(), compare);
+    Event* event = heap.back();
+    heap.pop_back();
     
     pthread_mutex_unlock(&queue_mutex);
     return event;
@@ -2,17 +2,19 @@
 #define EVENT_QUEUE_H
 
 #include "Event.h"
-#include <queue>
+#include <algorithm>
 #include <vector>
 #include <functional>
 #include <pthread.h>
 
 using namespace std;
 
+// Binary min-heap of events by time. Kept as a plain vector (rather than
+// priority_queue) so push_bulk can append a whole schedule and heapify it
+// in O(n) under one lock.
 class EventQueue {
 private:
-    priority_queue<Event*, vector<Event*>, 
-                        function<bool(Event*, Event*)>> queue;
+    vector<Event*> heap;
     pthread_mutex_t queue_mutex;
     pthread_cond_t event_available;
     
@@ -26,6 +28,8 @@ public:
     ~EventQueue();
     
     void push(Event* event);
+    // Insert many events at once (e.g. a loaded schedule)
+    void push_bulk(const vector<Event*>& events);
     Event* pop();
     Event* peek();
     bool empty();
@@ -7,6 +7,7 @@
 #include "../memory/Prefetcher.h"
 #include "../memory/WorkingSetManager.h"
 #include "../memory/ThrashingDetector.h"
+#include "../memory/PageTrace.h"
 #include "../resources/ResourceManager.h"
 #include "../resources/Resource.h"
 #include "../crew/CrewManager.h"
@@ -23,6 +24,57 @@ using namespace std;
 
 // ========== Flight Lifecycle pthread Handler ==========
 
+// Drop a finished flight's TLB entries and prefetch history, so the next
+// flight given the same number starts cold
+static void release_flight_memory(SimulationEngine* engine, int process_id) {
+    engine->get_tlb()->flush_process(process_id);
+    engine->get_prefetcher()->forget_process(process_id);
+}
+
+static void mark_touched(vector<bool>& touched, int page) {
+    if (page < 0) return;
+    if (page >= (int)touched.size()) touched.resize(page + 1, false);
+    touched[page] = true;
+}
+
+bool touch_page(TLB* tlb, ThrashingDetector* detector, int process_id, int page, vector<bool>& touched) {
+    if (tlb->lookup(process_id, page) >= 0) {
+        detector->record_hit();
+        return false;
+    }
+    bool seen = page >= 0 && page < (int)touched.size() && touched[page];
+    if (seen) {
+        detector->record_fault();       // Displaced since last use
+    } else {
+        detector->record_compulsory_fault();
+        mark_touched(touched, page);
+    }
+    tlb->insert(process_id, page, page + process_id % 100);
+    return true;
+}
+
+// Each flight works on ~5 data pages (passenger manifest, baggage, etc.)
+static const int FLIGHT_DATA_PAGES = 5;
+
+static void access_flight_data(SimulationEngine* engine, Flight* flight, vector<bool>& touched) {
+    PageTrace* page_trace = engine->get_page_trace();
+    Prefetcher* prefetcher = engine->get_prefetcher();
+    long long access_time = engine->get_time_manager()->get_current_time();
+    
+    for (int page = 0; page < FLIGHT_DATA_PAGES; page++) {
+        page_trace->record(flight->number, page, access_time, false);
+        
+        // Record access for prefetcher pattern detection
+        prefetcher->record_access(flight->number, page);
+        
+        if (touch_page(engine->get_tlb(), engine->get_thrashing_detector(), flight->number, page, touched)) {
+            ostringstream log_msg;
+            log_msg << "[MEMORY] Flight " << flight->flight_id << " TLB miss on page " << page;
+            Logger::get_instance()->log_memory(log_msg.str());
+        }
+    }
+}
+
 void* flight_lifecycle_handler(void* arg) {
     FlightThreadData* data = static_cast<FlightThreadData*>(arg);
     Flight* flight = data->flight;
@@ -40,44 +92,29 @@ void* flight_lifecycle_handler(void* arg) {
     engine->increment_active_flights();
     
     // ===== AWSC-PPC Memory Simulation =====
-    int flight_id_hash = abs((int)(flight->flight_id[0] + flight->flight_id[1] * 256));
+    int flight_id_hash = flight->number;   // Interned id, unique per flight
     Prefetcher* prefetcher = engine->get_prefetcher();
     ThrashingDetector* thrash_detector = engine->get_thrashing_detector();
     WorkingSetManager* ws_manager = engine->get_working_set_manager();
     
     // Calculate working set window based on phase (initialization)
-    double fault_rate = thrash_detector->is_in_thrashing_state() ? 0.25 : 0.05;
+    double fault_rate = thrash_detector->get_current_fault_rate();
     int ws_window = ws_manager->calculate_window(PHASE_INIT, fault_rate);
     
     log_msg.str("");
     log_msg << "[MEMORY] Flight " << flight->flight_id << " working set window: " << ws_window;
     logger->log_memory(log_msg.str());
     
-    // Simulate memory access for flight data (passenger manifest, baggage, etc.)
-    for (int page = 0; page < 5; page++) {  // Each flight accesses ~5 pages
-        // Record access for prefetcher pattern detection
-        prefetcher->record_access(flight_id_hash, page);
-        
-        int frame = tlb->lookup(flight_id_hash, page);
-        if (frame < 0) {
-            // TLB miss - simulate page fault
-            thrash_detector->record_fault();
-            tlb->insert(flight_id_hash, page, page + flight_id_hash % 100);
-            
-            log_msg.str("");
-            log_msg << "[MEMORY] Flight " << flight->flight_id << " TLB miss on page " << page;
-            logger->log_memory(log_msg.str());
-        } else {
-            // TLB hit
-            thrash_detector->record_hit();
-        }
-    }
+    // First touches: every miss here is compulsory
+    vector<bool> touched_pages;
+    access_flight_data(engine, flight, touched_pages);
     
     // Prefetch predicted pages
     vector<int> prefetch_candidates = prefetcher->get_prefetch_candidates(flight_id_hash);
     for (int pred_page : prefetch_candidates) {
         if (tlb->lookup(flight_id_hash, pred_page) < 0) {
             tlb->insert(flight_id_hash, pred_page, pred_page + flight_id_hash % 100);
+            mark_touched(touched_pages, pred_page);
             log_msg.str("");
             log_msg << "[MEMORY] Flight " << flight->flight_id << " prefetched page " << pred_page;
             logger->log_memory(log_msg.str());
@@ -89,6 +126,9 @@ void* flight_lifecycle_handler(void* arg) {
     Operation* landing_op = scheduler->create_operation(flight, OP_LANDING, arrival_time);
     scheduler->enqueue(landing_op);
     
+    // Join the arrival bank so a gate is planned while on approach
+    engine->get_gate_manager()->add_pending_arrival(flight);
+    
     // ===== PHASE 1: ARRIVAL & RUNWAY REQUEST WITH GO-AROUND =====
     // REQ-1: Go-around procedure implementation
     static const int GO_AROUND_DELAY_SECONDS = 2;  // Reduced delay for faster turnaround
@@ -136,6 +176,19 @@ go_around_retry:
     int attempts = 0;
     const int MAX_ATTEMPTS = 30;
     
+    // Join the landing sequence: runway and slot are planned with every
+    // other approaching flight, and the runway is only granted in that order
+    if (!weather_unsafe) {
+        RunwaySlot slot = engine->get_runway_manager()->request_landing_slot(
+            flight, engine->get_time_manager()->get_current_time());
+        if (slot.runway) {
+            log_msg.str("");
+            log_msg << "[FLIGHT] " << flight->flight_id << " sequenced on runway " << slot.runway->get_name()
+                    << " slot t=" << slot.slot_time << " (planned delay " << slot.delay << ")";
+            logger->log_event(log_msg.str());
+        }
+    }
+    
     while (runway == nullptr && attempts < MAX_ATTEMPTS && !weather_unsafe) {
         runway = engine->get_runway_manager()->allocate_runway(
             flight, 
@@ -154,6 +207,7 @@ go_around_retry:
     
     // REQ-1: Trigger go-around if runway unavailable or weather unsafe
     if (runway == nullptr || weather_unsafe) {
+        engine->get_runway_manager()->cancel_landing_slot(flight);  // Re-sequenced on retry
         if (flight->go_around_count < MAX_GO_AROUNDS) {
             flight->go_around_count++;
             flight->status = GO_AROUND;
@@ -183,7 +237,11 @@ go_around_retry:
             log_msg << "[DIVERSION] Flight " << flight->flight_id 
                     << " diverted after " << MAX_GO_AROUNDS << " go-arounds";
             logger->log_event(log_msg.str());
+            engine->get_gate_manager()->remove_pending_arrival(flight);
             engine->decrement_active_flights();
+            scheduler->complete(landing_op);
+            release_flight_memory(engine, flight_id_hash);
+            engine->get_flight_registry()->release(flight);
             delete data;
             return nullptr;
         }
@@ -202,6 +260,15 @@ go_around_retry:
     
     flight->actual_arrival_time = engine->get_time_manager()->get_current_time();
     
+    // Landed late: move the gate booking now, ahead of the taxi-in, for at
+    // least the predicted (P90) turnaround
+    if (flight->actual_arrival_time > flight->scheduled_arrival_time) {
+        long long stay = max(flight->scheduled_departure_time - flight->scheduled_arrival_time,
+                             engine->get_turnaround_estimator()->get_planning_time(flight->aircraft));
+        engine->get_gate_manager()->update_gate_times(flight, flight->actual_arrival_time,
+            flight->actual_arrival_time + stay + GateManager::GATE_BUFFER);
+    }
+    
     // ===== PHASE 3: RELEASE RUNWAY =====
     engine->get_runway_manager()->release_runway(
         runway->get_id(),
@@ -216,37 +283,76 @@ go_around_retry:
     engine->release_atc_clearance();      // REQ-5: Release ATC after landing
     
     // ===== PHASE 4: TAXIING TO GATE =====
+    // Route is known once a gate is assigned; the flight holds on the
+    // exit taxiway until then
     flight->status = TAXIING_TO_GATE;
-    usleep(300000); // 0.3s taxi time - faster turnaround
     
     // ===== PHASE 5: GATE REQUEST =====
-    Gate* gate = nullptr;
-    attempts = 0;
-    
-    while (gate == nullptr && attempts < MAX_ATTEMPTS) {
-        gate = engine->get_gate_manager()->allocate_gate(flight);
-        
-        if (gate == nullptr) {
-            log_msg.str("");
-            log_msg << "[FLIGHT] " << flight->flight_id << " waiting for gate (attempt " 
-                    << (attempts + 1) << ")";
-            logger->log_event(log_msg.str());
-            sleep(1);
-            attempts++;
-        }
+    // The booked gate is normally free; otherwise sleep until a gate is
+    // released rather than polling
+    const long long GATE_WAIT_MS = MAX_ATTEMPTS * 1000LL;  // As long as the old polling loop
+    long long gate_request_time = engine->get_time_manager()->get_current_time();
+    Gate* gate = engine->get_gate_manager()->allocate_gate(flight, gate_request_time);
+    if (gate == nullptr) {
+        log_msg.str("");
+        log_msg << "[FLIGHT] " << flight->flight_id << " waiting for gate";
+        logger->log_event(log_msg.str());
+        gate = engine->get_gate_manager()->wait_for_gate(flight, gate_request_time, GATE_WAIT_MS);
     }
     
     if (gate == nullptr) {
         log_msg.str("");
         log_msg << "[FLIGHT] " << flight->flight_id << " FAILED to get gate";
         logger->log_event(log_msg.str());
+        engine->get_gate_manager()->remove_pending_arrival(flight);
         engine->decrement_active_flights();
+        scheduler->complete(landing_op);
+        release_flight_memory(engine, flight_id_hash);
+        engine->get_flight_registry()->release(flight);
         delete data;
         return nullptr;
     }
     
     flight->assigned_gate_id = gate->get_id();
     
+    // Taxi from the runway exit to the gate on a route booked in the
+    // taxiway reservation table, so it never meets another taxiing flight.
+    // Taxi seconds are compressed like every other phase (2ms each, 50 per
+    // time unit). Hold at the exit while no conflict-free route exists.
+    static const int TAXI_US_PER_SECOND = 2000;
+    static const long long TAXI_SECONDS_PER_UNIT = 50;
+    TaxiwayGraph* taxiways = engine->get_taxiway_graph();
+    int taxi_id = flight->number;   // Taxiway reservations are keyed by int
+    int gate_node = SimulationEngine::gate_node(gate->get_id());
+    TaxiPlan taxi_in;
+    bool planned = false;
+    for (attempts = 0; attempts < MAX_ATTEMPTS && !planned; attempts++) {
+        long long taxi_clock = engine->get_time_manager()->get_current_time() * TAXI_SECONDS_PER_UNIT;
+        planned = taxiways->plan_route(SimulationEngine::runway_exit_node(runway->get_id()), gate_node,
+                                       taxi_id, taxi_clock, taxi_in);
+        if (!planned) {
+            log_msg.str("");
+            log_msg << "[FLIGHT] " << flight->flight_id << " holding at runway exit for taxi route";
+            if (taxiways->detect_gridlock()) log_msg << " (taxiway gridlock)";
+            logger->log_event(log_msg.str());
+            usleep(200000);
+        }
+    }
+    long long taxi_in_time = planned ? taxi_in.end - taxi_in.start : 150;  // No route - nominal taxi
+    log_msg.str("");
+    log_msg << "[FLIGHT] " << flight->flight_id << " taxiing to gate " << gate->get_id();
+    if (planned) log_msg << " via " << taxi_in.nodes.size() << " nodes";
+    log_msg << " (" << taxi_in_time << "s";
+    if (planned && taxi_in.delay > 0) log_msg << ", " << taxi_in.delay << "s holding";
+    log_msg << ")";
+    logger->log_event(log_msg.str());
+    usleep(taxi_in_time * TAXI_US_PER_SECOND);
+    if (planned) {
+        taxiways->release_plan(taxi_in);
+    } else {
+        taxiways->release_hold(taxi_id);
+    }
+    
     // ===== PHASE 6: AT GATE & SERVICING WITH RESOURCE ALLOCATION =====
     flight->status = AT_GATE;
     engine->increment_flights_at_gates();  // Track at gate
@@ -254,128 +360,87 @@ go_around_retry:
     log_msg << "[FLIGHT] " << flight->flight_id << " at gate " << gate->get_id();
     logger->log_event(log_msg.str());
     
+    // Servicing works on the flight's data again; pages other flights
+    // displaced since landing fault back in
+    ws_window = ws_manager->calculate_window(PHASE_COMPUTATION, thrash_detector->get_current_fault_rate());
+    log_msg.str("");
+    log_msg << "[MEMORY] Flight " << flight->flight_id << " working set window: " << ws_window;
+    logger->log_memory(log_msg.str());
+    access_flight_data(engine, flight, touched_pages);
+    
     flight->status = SERVICING;
     ResourceManager* res_mgr = engine->get_resource_manager();
     long long current_time = engine->get_time_manager()->get_current_time();
     
-    // ===== GROUND SERVICE: GPU (Ground Power Unit) =====
-    log_msg.str("");
-    log_msg << "[RESOURCE] " << flight->flight_id << " requesting GPU";
-    logger->log_resource(log_msg.str());
-    
-    Resource* gpu = res_mgr->allocate_resource(RES_GROUND_POWER_UNIT, gate->get_id(), current_time, 30);
-    if (gpu) {
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " acquired " << gpu->get_name();
-        logger->log_resource(log_msg.str());
-    }
-    
-    // ===== GROUND SERVICE: FUEL TRUCK =====
-    log_msg.str("");
-    log_msg << "[RESOURCE] " << flight->flight_id << " requesting fuel truck";
-    logger->log_resource(log_msg.str());
-    
-    Resource* fuel_truck = nullptr;
-    attempts = 0;
-    while (fuel_truck == nullptr && attempts < 10) {
-        fuel_truck = res_mgr->allocate_resource(RES_FUEL_TRUCK, gate->get_id(), current_time, 15);
-        if (fuel_truck == nullptr) {
-            usleep(500000); // Wait 500ms before retry
-            attempts++;
-        }
-    }
-    
-    if (fuel_truck) {
+    // Ground services queue by flight priority and are handed over as soon
+    // as the previous flight releases them; give up after the timeout
+    static const long long SERVICE_WAIT_TIMEOUT_MS = 5000;
+    
+    // Book the pushback tug on arrival for when servicing should end (the
+    // aircraft's P90 turnaround, plus room for equipment waits), so it is
+    // planned ahead instead of found by queueing at the end
+    static const long long PUSHBACK_WAIT_MARGIN = 5;
+    static const long long PUSHBACK_WINDOW = 5;
+    static const long long PUSHBACK_SLACK = 50;    // Latest acceptable delay
+    long long pushback_lead = engine->get_turnaround_estimator()->get_planning_time(flight->aircraft) +
+                              PUSHBACK_WAIT_MARGIN;
+    ResourceBooking tug_booking;
+    if (res_mgr->book_resource(RES_AIRCRAFT_TUG, flight->number, current_time,
+                               current_time + pushback_lead, PUSHBACK_WINDOW,
+                               current_time + pushback_lead + PUSHBACK_SLACK, tug_booking)) {
         log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " acquired " << fuel_truck->get_name() << " - refueling";
-        logger->log_resource(log_msg.str());
-        sleep(2); // 2s refueling - realistic timing
-        res_mgr->release_resource(fuel_truck);
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " released fuel truck - refueling complete";
+        log_msg << "[RESOURCE] " << flight->flight_id << " booked " << tug_booking.resource->get_name()
+                << " for pushback at t=" << tug_booking.start;
         logger->log_resource(log_msg.str());
     }
     
-    // ===== GROUND SERVICE: CATERING =====
+    // ===== GROUND SERVICES: TURNAROUND DAG ON THE SHARED SCHEDULER =====
+    // All turnaround services run on the airport-wide pool as their
+    // dependencies allow; fuel trucks, carts and crews go to the services
+    // with the earliest deadline across gates (1 time unit = 10 service minutes)
+    static const long long SERVICE_MINUTES_PER_UNIT = 10;
+    long long due_in = (flight->scheduled_departure_time - current_time) * SERVICE_MINUTES_PER_UNIT;
+    TurnaroundCategory category = TurnaroundTemplate::category_of(flight->aircraft);
     log_msg.str("");
-    log_msg << "[RESOURCE] " << flight->flight_id << " requesting catering vehicle";
+    log_msg << "[SERVICE] " << flight->flight_id << " " << TurnaroundTemplate::category_to_string(category)
+            << " turnaround services started at gate " << gate->get_id()
+            << " (departure due in " << due_in << " min)";
     logger->log_resource(log_msg.str());
     
-    Resource* catering = res_mgr->allocate_resource(RES_CATERING_VEHICLE, gate->get_id(), current_time, 10);
-    if (catering) {
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " acquired " << catering->get_name() << " - catering";
-        logger->log_resource(log_msg.str());
-        usleep(100000); // 0.1s catering
-        res_mgr->release_resource(catering);
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " released catering - complete";
-        logger->log_resource(log_msg.str());
-    }
+    TurnaroundReport services = engine->get_service_scheduler()->run_turnaround(
+        flight->number, gate->get_id(), flight->priority, current_time, due_in, category);
     
-    // ===== GROUND SERVICE: CLEANING CREW =====
     log_msg.str("");
-    log_msg << "[RESOURCE] " << flight->flight_id << " requesting cleaning crew";
+    log_msg << "[SERVICE] " << flight->flight_id << " turnaround: " << services.completed << " services done";
+    if (services.failed > 0) log_msg << ", " << services.failed << " failed";
+    log_msg << " in " << services.finish_time - services.release_time << " min, slack "
+            << services.slack << " min";
     logger->log_resource(log_msg.str());
     
-    Resource* cleaning = res_mgr->allocate_resource(RES_CLEANING_CREW, gate->get_id(), current_time, 20);
-    if (cleaning) {
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " acquired " << cleaning->get_name() << " - cleaning";
-        logger->log_resource(log_msg.str());
-        sleep(1); // 1s cleaning
-        res_mgr->release_resource(cleaning);
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " released cleaning crew - complete";
-        logger->log_resource(log_msg.str());
-    }
-    
-    // ===== GROUND SERVICE: BAGGAGE HANDLING =====
-    log_msg.str("");
-    log_msg << "[RESOURCE] " << flight->flight_id << " requesting baggage cart";
-    logger->log_resource(log_msg.str());
-    
-    Resource* baggage = res_mgr->allocate_resource(RES_BAGGAGE_CART, gate->get_id(), current_time, 15);
-    if (baggage) {
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " acquired " << baggage->get_name() << " - loading baggage";
-        logger->log_resource(log_msg.str());
-        usleep(100000); // 0.1s baggage
-        res_mgr->release_resource(baggage);
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " released baggage cart - complete";
-        logger->log_resource(log_msg.str());
-    }
-    
     // ===== GROUND SERVICE: TUG FOR PUSHBACK =====
     log_msg.str("");
     log_msg << "[RESOURCE] " << flight->flight_id << " requesting aircraft tug for pushback";
     logger->log_resource(log_msg.str());
     
-    Resource* tug = res_mgr->allocate_resource(RES_AIRCRAFT_TUG, gate->get_id(), current_time, 5);
-    
-    // Release GPU before departure
-    if (gpu) {
-        res_mgr->release_resource(gpu);
-        log_msg.str("");
-        log_msg << "[RESOURCE] " << flight->flight_id << " released GPU";
-        logger->log_resource(log_msg.str());
-    }
+    long long pushback_time = engine->get_time_manager()->get_current_time();
+    Resource* tug = tug_booking.resource
+        ? res_mgr->claim_booking(tug_booking, pushback_time, PUSHBACK_WINDOW,
+                                 flight->priority, SERVICE_WAIT_TIMEOUT_MS)
+        : res_mgr->acquire_resource(RES_AIRCRAFT_TUG, flight->number, pushback_time, PUSHBACK_WINDOW,
+                                    flight->priority, SERVICE_WAIT_TIMEOUT_MS);
     
     log_msg.str("");
     log_msg << "[FLIGHT] " << flight->flight_id << " servicing complete";
     logger->log_event(log_msg.str());
+    access_flight_data(engine, flight, touched_pages);     // Departure paperwork
     
-    // ===== PHASE 7: RELEASE TUG, GATE & DEPARTURE =====
+    // ===== PHASE 7: PUSHBACK, TAXI-OUT ROUTE, GATE RELEASE =====
     if (tug) {
         log_msg.str("");
         log_msg << "[RESOURCE] " << flight->flight_id << " using " << tug->get_name() << " for pushback";
         logger->log_resource(log_msg.str());
     }
     
-    engine->get_gate_manager()->release_gate(gate->get_id());
-    engine->decrement_flights_at_gates();  // No longer at gate
-    
     // Release tug after pushback
     if (tug) {
         usleep(100000); // 0.1s pushback
@@ -385,6 +450,56 @@ go_around_retry:
         logger->log_resource(log_msg.str());
     }
     
+    // Book the taxi-out to the runway reached first (the closest one unless
+    // others' routes are in the way) while the gate is still ours, so the
+    // next arrival is not given a gate this flight is still holding at
+    flight->status = TAXIING_TO_RUNWAY;
+    vector<Runway*> runways = engine->get_runway_manager()->get_all_runways();
+    int departure_runway = runways.empty() ? -1 : runways[0]->get_id();
+    TaxiPlan taxi_out;
+    planned = false;
+    for (attempts = 0; attempts < MAX_ATTEMPTS && !planned && departure_runway >= 0; attempts++) {
+        long long taxi_clock = engine->get_time_manager()->get_current_time() * TAXI_SECONDS_PER_UNIT;
+        long long best_end = -1;
+        for (Runway* candidate_runway : runways) {
+            TaxiPlan candidate;
+            if (taxiways->plan_route(gate_node, SimulationEngine::runway_exit_node(candidate_runway->get_id()),
+                                     taxi_id, taxi_clock, candidate, false) &&
+                (best_end < 0 || candidate.end < best_end)) {
+                best_end = candidate.end;
+                departure_runway = candidate_runway->get_id();
+            }
+        }
+        planned = taxiways->plan_route(gate_node, SimulationEngine::runway_exit_node(departure_runway),
+                                       taxi_id, taxi_clock, taxi_out);
+        if (!planned) {
+            log_msg.str("");
+            log_msg << "[FLIGHT] " << flight->flight_id << " holding at gate " << gate->get_id()
+                    << " for taxi route";
+            if (taxiways->detect_gridlock()) log_msg << " (taxiway gridlock)";
+            logger->log_event(log_msg.str());
+            usleep(200000);
+        }
+    }
+    
+    engine->get_gate_manager()->release_gate(gate->get_id());
+    engine->decrement_flights_at_gates();  // No longer at gate
+    
+    long long taxi_out_time = planned ? taxi_out.end - taxi_out.start : 150;
+    log_msg.str("");
+    Runway* departure = engine->get_runway_manager()->get_runway(departure_runway);
+    log_msg << "[FLIGHT] " << flight->flight_id << " taxiing to runway "
+            << (departure ? departure->get_name() : "N/A") << " (" << taxi_out_time << "s";
+    if (planned && taxi_out.delay > 0) log_msg << ", " << taxi_out.delay << "s holding";
+    log_msg << ")";
+    logger->log_event(log_msg.str());
+    usleep(taxi_out_time * TAXI_US_PER_SECOND);
+    if (planned) {
+        taxiways->release_plan(taxi_out);
+    } else {
+        taxiways->release_hold(taxi_id);
+    }
+    
     flight->status = DEPARTING;
     engine->increment_flights_departing();  // Track departing
     flight->actual_departure_time = engine->get_time_manager()->get_current_time();
@@ -441,6 +556,9 @@ go_around_retry:
     engine->decrement_active_flights();
     engine->increment_total_handled();
     
+    // Lifecycle over: the flight's slot goes back to the registry
+    release_flight_memory(engine, flight_id_hash);
+    engine->get_flight_registry()->release(flight);
     delete data;
     return nullptr;
 }
@@ -478,6 +596,7 @@ void FlightArrivalEvent::process() {
         log_msg << "[EVENT] ERROR: Failed to create thread for flight " << flight->flight_id;
         logger->log_event(log_msg.str());
         delete thread_data;
+        engine->get_flight_registry()->release(flight);
         return;
     }
     
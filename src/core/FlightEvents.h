@@ -4,6 +4,7 @@
 #include "Event.h"
 #include "../airport/Flight.h"
 #include "SimulationEngine.h"
+#include <vector>
 #include <pthread.h>
 
 // Forward declaration
@@ -19,6 +20,12 @@ struct FlightThreadData {
 // Thread function for flight lifecycle
 void* flight_lifecycle_handler(void* arg);
 
+// Access one of a process's pages through the TLB, filling it on a miss.
+// touched holds the pages the process has used or prefetched: a miss on
+// one of them is a capacity fault and counts toward the PFF rate, a miss
+// on any other page is a compulsory first touch. Returns true on a miss.
+bool touch_page(TLB* tlb, ThrashingDetector* detector, int process_id, int page, vector<bool>& touched);
+
 // ========== Concrete Event Classes ==========
 
 class FlightArrivalEvent : public Event {
@@ -1,10 +1,14 @@
 #include "SimulationEngine.h"
+#include "../data/ScheduleReader.h"
 #include <unistd.h>
 #include <fstream>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
 
 using namespace std;
 
@@ -17,6 +21,7 @@ SimulationEngine::SimulationEngine() {
     runway_manager = new RunwayManager();
     gate_manager = new GateManager();
     taxiway_graph = new TaxiwayGraph();
+    flight_registry = new FlightRegistry();
     scheduler = new HMFQQueue();  // HMFQ-PPRA Scheduler
     
     // Initialize memory manager components
@@ -29,18 +34,29 @@ SimulationEngine::SimulationEngine() {
     resource_manager = new ResourceManager();
     // Resource pool sizes: 8 fuel trucks, 6 catering, 10 baggage, 4 cleaning, 5 buses, 6 tugs, 8 GPUs
     resource_manager->initialize(8, 6, 10, 4, 5, 6, 8);
+    resource_profiler = new ResourceProfiler(7, 10);  // 1s buckets (10 time units)
+    resource_manager->attach_profiler(resource_profiler);
     
     // Initialize crisis manager for weather and emergencies
     crisis_manager = new CrisisManager();
     
     // Initialize prefetcher for predictive memory access
     prefetcher = new Prefetcher();
+    page_trace = new PageTrace();
     
     // Initialize crew manager with LRU assignment
     crew_manager = new CrewManager();
     // Crew pool: 20 pilots, 20 co-pilots, 60 attendants, 15 technicians, 30 handlers, 10 agents, 10 fuel techs
     crew_manager->initialize(20, 20, 60, 15, 30, 10, 10);
     
+    // Turnaround services run against the resource pools and crew above
+    service_graph = new ServiceDependencyGraph();
+    service_graph->build_standard_turnaround();
+    service_scheduler = new ServiceScheduler(service_graph, resource_manager, crew_manager);
+    // Predicted turnaround lengths for gate and pushback planning
+    turnaround_estimator = new TurnaroundEstimator(service_graph);
+    turnaround_estimator->estimate_all();
+    
     // Initialize finance tracking
     cost_model = new CostModel();
     revenue_model = new RevenueModel();
@@ -60,6 +76,7 @@ SimulationEngine::SimulationEngine() {
     on_time_flights = 0;
     delayed_flights = 0;
     next_flight_id = 100;  // Start flight IDs at 100
+    schedule_loaded = false;
     available_atc = TOTAL_ATC;  // REQ-5: Initialize ATC count
 }
 
@@ -79,12 +96,18 @@ SimulationEngine::~SimulationEngine() {
     delete working_set_manager;
     delete clock_replacer;
     delete thrashing_detector;
+    delete service_scheduler;   // Before the pools and crew it uses
+    delete turnaround_estimator;
+    delete service_graph;
     delete resource_manager;
+    delete resource_profiler;
     delete crisis_manager;
     delete prefetcher;
+    delete page_trace;
     delete crew_manager;
     delete cost_model;
     delete revenue_model;
+    delete flight_registry;     // Last: the managers above held Flight*
 }
 
 void SimulationEngine::load_configuration() {
@@ -116,17 +139,53 @@ void SimulationEngine::initialize_airport() {
     gate_manager->add_gate(new Gate(6, GATE_DOMESTIC, GATE_MEDIUM, true));
     gate_manager->add_gate(new Gate(7, GATE_DOMESTIC, GATE_SMALL, false));
     
+    // Walking distance from the terminal centre (international pier is further)
+    const int gate_walk_metres[8] = {450, 400, 350, 300, 250, 150, 100, 200};
+    for (int g = 0; g < 8; g++) {
+        gate_manager->set_walk_distance(g, gate_walk_metres[g]);
+    }
+    
     logger->log_event("[SimulationEngine] Created 8 gates");
     
-    // Create taxiway graph (simplified)
-    for (int i = 0; i < 10; i++) {
+    // Create taxiway graph: a 6x3 grid of taxiway junctions, runway exits
+    // at the four corners and gates along the terminal (top) row.
+    // Weights are taxi times in seconds; every segment is two-way.
+    static const int GRID_W = 6, GRID_H = 3;
+    for (int i = 0; i < GRID_W * GRID_H; i++) {
         taxiway_graph->add_node(i, "Taxiway_" + std::to_string(i));
     }
+    for (int y = 0; y < GRID_H; y++) {
+        for (int x = 0; x < GRID_W; x++) {
+            int node = y * GRID_W + x;
+            if (x + 1 < GRID_W) {
+                int weight = (y == GRID_H - 1) ? 20 : 30;  // Parallel taxiway is fastest
+                taxiway_graph->add_edge(node, node + 1, weight);
+                taxiway_graph->add_edge(node + 1, node, weight);
+            }
+            if (y + 1 < GRID_H) {
+                taxiway_graph->add_edge(node, node + GRID_W, 25);
+                taxiway_graph->add_edge(node + GRID_W, node, 25);
+            }
+        }
+    }
     
-    // Add edges (simplified network)
-    for (int i = 0; i < 9; i++) {
-        taxiway_graph->add_edge(i, i + 1, 60); // 60 seconds per segment
+    const int runway_corner[4] = {GRID_W * (GRID_H - 1), GRID_W * GRID_H - 1, 0, GRID_W - 1};
+    for (int r = 0; r < 4; r++) {
+        int exit = runway_exit_node(r);
+        taxiway_graph->add_node(exit, "RunwayExit_" + std::to_string(r));
+        taxiway_graph->add_edge(exit, runway_corner[r], 40);
+        taxiway_graph->add_edge(runway_corner[r], exit, 40);
+        taxiway_graph->mark_endpoint(exit);
+    }
+    for (int g = 0; g < 8; g++) {
+        int stand = gate_node(g);
+        int junction = g % GRID_W;  // Terminal row
+        taxiway_graph->add_node(stand, "Gate_" + std::to_string(g));
+        taxiway_graph->add_edge(stand, junction, 15);
+        taxiway_graph->add_edge(junction, stand, 15);
+        taxiway_graph->mark_endpoint(stand);
     }
+    taxiway_graph->build_routes();
     
     logger->log_event("[SimulationEngine] Created taxiway graph");
 }
@@ -134,26 +193,18 @@ void SimulationEngine::initialize_airport() {
 void SimulationEngine::generate_initial_flights() {
     logger->log_event("[SimulationEngine] Generating initial flights...");
     
-    // Create some initial aircraft
-    vector<Aircraft*> aircraft = {
-        new Aircraft(B777),      // Heavy international
-        new Aircraft(A320),      // Medium domestic
-        new Aircraft(B737),      // Medium domestic
-        new Aircraft(G650),      // Private jet
-        new Aircraft(A380)       // Heavy international
-    };
-    
     // Create initial flights - arrival times in near future (5-25 seconds)
     vector<Flight*> flights = {
-        new Flight("AA100", aircraft[0], INTERNATIONAL, 5, 300),    // Arrive at 5s, depart at 5min
-        new Flight("UA200", aircraft[1], DOMESTIC, 10, 360),        // Arrive at 10s, depart at 6min
-        new Flight("DL300", aircraft[2], DOMESTIC, 15, 420),        // Arrive at 15s, depart at 7min
-        new Flight("PVT500", aircraft[3], DOMESTIC, 20, 480),       // Arrive at 20s, depart at 8min
-        new Flight("BA400", aircraft[4], INTERNATIONAL, 25, 540)    // Arrive at 25s, depart at 9min
+        flight_registry->create("AA100", B777, INTERNATIONAL, 5, 300),   // Heavy, arrive at 5s, depart at 5min
+        flight_registry->create("UA200", A320, DOMESTIC, 10, 360),       // Medium, arrive at 10s, depart at 6min
+        flight_registry->create("DL300", B737, DOMESTIC, 15, 420),       // Medium, arrive at 15s, depart at 7min
+        flight_registry->create("PVT500", G650, DOMESTIC, 20, 480),      // Private jet, arrive at 20s, depart at 8min
+        flight_registry->create("BA400", A380, INTERNATIONAL, 25, 540)   // Heavy, arrive at 25s, depart at 9min
     };
     
     // Schedule arrival events
     for (Flight* flight : flights) {
+        gate_manager->preassign_gate(flight, turnaround_estimator->get_planning_time(flight->aircraft));
         FlightArrivalEvent* arrival_event = new FlightArrivalEvent(flight, this, flight->scheduled_arrival_time);
         event_queue->push(arrival_event);
         
@@ -213,6 +264,7 @@ void* SimulationEngine::dashboard_updater_func(void* arg) {
     // Track last logged times to prevent duplicates
     long long last_memory_log_time = -1;
     long long last_perf_log_time = -1;
+    long long last_gate_plan_time = -1;
     
     while (engine->simulation_running) {
         // Collect metrics from atomic counters
@@ -241,13 +293,61 @@ void* SimulationEngine::dashboard_updater_func(void* arg) {
         metrics.page_fault_rate = total_accesses > 0 ? 
             ((double)engine->tlb->get_misses() / total_accesses) : 0.0;
         
+        // Ground-service pools over the last 5 profiler buckets
+        ResourceProfiler* profiler = engine->resource_profiler;
+        profiler->sample(engine->resource_manager, metrics.current_sim_time);
+        for (int t = 0; t < 7; t++) {
+            ResourceProfileSummary s = profiler->get_summary((ResourceType)t, 5);
+            metrics.service_utilization[t] = s.utilization;
+            metrics.service_queue[t] = s.average_queue;
+            metrics.service_wait_us[t] = s.average_wait_us;
+        }
+        metrics.bottleneck_service = profiler->get_bottleneck(5);
+        
+        // Re-plan gates for the arrival bank and clear the timeline ahead
+        // of overstaying flights every 2 seconds
+        long long gate_plan_interval = metrics.current_sim_time / 20;
+        if (gate_plan_interval > last_gate_plan_time) {
+            last_gate_plan_time = gate_plan_interval;
+            GateManager* gates = engine->gate_manager;
+            int moved = gates->replan_gate_conflicts(metrics.current_sim_time);
+            if (moved > 0) {
+                GateTimelineStats ts = gates->get_timeline_stats();
+                ostringstream gate_msg;
+                gate_msg << "[GateManager] Timeline: " << moved << " bookings moved ahead of overstays ("
+                         << ts.preassigned << " preassigned, " << ts.booked_hits << " booked gates taken, "
+                         << ts.unplanned << " unplanned)";
+                engine->logger->log_event(gate_msg.str());
+            }
+            int bank = gates->get_pending_count();
+            if (bank > 0) {
+                int planned = gates->optimize_pending(metrics.current_sim_time);
+                ostringstream gate_msg;
+                gate_msg << "[GateManager] Arrival bank: " << planned << "/" << bank
+                         << " flights planned, cost " << gates->get_last_plan_cost()
+                         << " (" << fixed << setprecision(1) << gates->get_last_plan_us() << " us)";
+                engine->logger->log_event(gate_msg.str());
+            }
+        }
+        
+        // Sample fault rate for thrashing detection
+        ThrashingDetector* detector = engine->thrashing_detector;
+        detector->check_thrashing();
+        
         // Log memory stats every 10 seconds (only once per interval)
         long long memory_interval = metrics.current_sim_time / 10;
         if (memory_interval > last_memory_log_time) {
             last_memory_log_time = memory_interval;
             ostringstream mem_msg;
             mem_msg << "[MEMORY] TLB Hit Rate: " << (engine->tlb->get_hit_rate() * 100.0) << "%"
-                    << " | Thrashing: " << (engine->thrashing_detector->is_in_thrashing_state() ? "YES" : "NO");
+                    << " | TLB Reach: " << engine->tlb->get_reach_pages() << " pages"
+                    << " | Thrashing: " << (detector->is_in_thrashing_state() ? "YES" : "NO")
+                    << " | Fault Rate:";
+            for (int w = 0; w < detector->get_window_count(); w++) {
+                mem_msg << " " << detector->get_window_size(w) << "=" 
+                        << (detector->get_fault_rate(w) * 100.0) << "%";
+            }
+            mem_msg << " | PFF: " << ThrashingDetector::pff_signal_to_string(detector->get_pff_signal());
             engine->logger->log_memory(mem_msg.str());
         }
         
@@ -260,6 +360,16 @@ void* SimulationEngine::dashboard_updater_func(void* arg) {
                      << " | Avg Turnaround: " << fixed << setprecision(2) << metrics.average_turnaround_time << " min"
                      << " | On-Time: " << fixed << setprecision(1) << (metrics.on_time_performance * 100) << "%";
             engine->logger->log_performance(perf_msg.str());
+            
+            ServiceSchedulerStats ss = engine->service_scheduler->get_stats();
+            if (ss.turnarounds > 0) {
+                ostringstream svc_msg;
+                svc_msg << "[ServiceScheduler] " << ss.turnarounds << " turnarounds, " << ss.services
+                        << " services | Avg slack: " << fixed << setprecision(1) << ss.average_slack
+                        << " min | Worst: " << ss.worst_slack << " min | Late: " << ss.late
+                        << " | Waited for equipment: " << ss.resource_waits << ", crew: " << ss.crew_waits;
+                engine->logger->log_performance(svc_msg.str());
+            }
         }
         
         engine->dashboard->update_metrics(metrics);
@@ -361,6 +471,12 @@ void* SimulationEngine::flight_generator_func(void* arg) {
     
     logger->log_event("[FlightGenerator] Flight generation thread started");
     
+    // A loaded timetable is the whole day's traffic
+    if (engine->schedule_loaded) {
+        logger->log_event("[FlightGenerator] Schedule loaded - random flight generation disabled");
+        return nullptr;
+    }
+    
     // Aircraft types for random selection
     AircraftType aircraft_types[] = {A380, B777, B737, A320, B777F, G650, FALCON_7X};
     const char* airlines[] = {"AA", "UA", "DL", "BA", "LH", "AF", "EK", "SQ", "QF", "CX"};
@@ -378,6 +494,13 @@ void* SimulationEngine::flight_generator_func(void* arg) {
             continue;
         }
         
+        // Page-fault-frequency control: hold off new flights while faulting heavily
+        // (cold misses are not counted, so a new flight cannot throttle itself)
+        if (engine->thrashing_detector->get_pff_signal() == PFF_THROTTLE) {
+            logger->log_memory("[FlightGenerator] PFF throttle - flight admission deferred");
+            continue;
+        }
+        
         // Generate flight ID
         int flight_num = engine->next_flight_id++;
         string airline = airlines[rand() % 10];
@@ -385,7 +508,6 @@ void* SimulationEngine::flight_generator_func(void* arg) {
         
         // Random aircraft type
         AircraftType type = aircraft_types[rand() % 7];
-        Aircraft* aircraft = new Aircraft(type);
         
         // Random flight type
         FlightType ftype = (rand() % 2 == 0) ? DOMESTIC : INTERNATIONAL;
@@ -396,15 +518,17 @@ void* SimulationEngine::flight_generator_func(void* arg) {
         long long departure_time = arrival_time + 120 + (rand() % 180);  // 2-5 min turnaround
         
         // Create flight
-        Flight* flight = new Flight(flight_id, aircraft, ftype, arrival_time, departure_time);
+        Flight* flight = engine->flight_registry->create(flight_id, type, ftype, arrival_time, departure_time);
         
-        // Schedule arrival event
+        // Book a gate from the schedule, then schedule the arrival event
+        engine->gate_manager->preassign_gate(flight,
+            engine->turnaround_estimator->get_planning_time(flight->aircraft));
         FlightArrivalEvent* arrival_event = new FlightArrivalEvent(flight, engine, arrival_time);
         engine->get_event_queue()->push(arrival_event);
         
         ostringstream log_msg;
         log_msg << "[FlightGenerator] Created flight " << flight_id 
-                << " (" << aircraft->get_type_name() << ")"
+                << " (" << flight->aircraft->get_type_name() << ")"
                 << " arriving at T+" << arrival_time;
         logger->log_event(log_msg.str());
     }
@@ -413,12 +537,65 @@ void* SimulationEngine::flight_generator_func(void* arg) {
     return nullptr;
 }
 
+bool SimulationEngine::load_schedule(const string& path) {
+    auto start = chrono::steady_clock::now();
+    ScheduleReader reader;
+    if (!reader.open(path)) {
+        logger->log_event("[SimulationEngine] Could not open schedule " + path);
+        return false;
+    }
+    
+    // Create every flight first, then rebase the timetable so its first
+    // arrival comes SCHEDULE_START units into the run
+    vector<Flight*> flights;
+    ScheduleRow row;
+    long long first_arrival = LLONG_MAX;
+    while (reader.next(row)) {
+        flights.push_back(flight_registry->create(row.flight_id, row.aircraft_type, row.flight_type,
+                                                  row.arrival_time, row.departure_time));
+        first_arrival = min(first_arrival, row.arrival_time);
+    }
+    for (const string& error : reader.get_errors()) {
+        logger->log_event("[SimulationEngine] Schedule " + path + " " + error);
+    }
+    if (flights.empty()) {
+        logger->log_event("[SimulationEngine] Schedule " + path + " has no valid flights");
+        return false;
+    }
+    
+    // Gates are booked as the arrivals are created; all events go into the
+    // queue in one heapify
+    long long shift = SCHEDULE_START - first_arrival;
+    vector<Event*> arrivals;
+    arrivals.reserve(flights.size());
+    for (Flight* flight : flights) {
+        flight->scheduled_arrival_time += shift;
+        flight->scheduled_departure_time += shift;
+        gate_manager->preassign_gate(flight, turnaround_estimator->get_planning_time(flight->aircraft));
+        arrivals.push_back(new FlightArrivalEvent(flight, this, flight->scheduled_arrival_time));
+    }
+    event_queue->push_bulk(arrivals);
+    schedule_loaded = true;
+    
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    ostringstream log_msg;
+    log_msg << "[SimulationEngine] Loaded " << flights.size() << " flights from " << path
+            << " (" << reader.get_size() / 1024 << " KB, " << reader.get_error_count() << " rows skipped) in "
+            << fixed << setprecision(1) << ms << " ms; times shifted by " << shift << " units";
+    logger->log_event(log_msg.str());
+    return true;
+}
+
 void SimulationEngine::initialize() {
     logger->log_event("[SimulationEngine] Initializing simulation...");
     
     load_configuration();
     initialize_airport();
-    generate_initial_flights();
+    if (schedule_path.empty()) {
+        generate_initial_flights();
+    } else if (!load_schedule(schedule_path)) {
+        throw runtime_error("could not load flight schedule " + schedule_path);
+    }
     
     logger->log_event("[SimulationEngine] Initialization complete");
 }
@@ -428,6 +605,7 @@ void SimulationEngine::run() {
     
     logger->log_event("[SimulationEngine] Starting simulation threads...");
     
+    service_scheduler->start();
     // Create control threads
     pthread_create(&event_dispatcher_thread, nullptr, event_dispatcher_func, this);
     pthread_create(&dashboard_updater_thread, nullptr, dashboard_updater_func, this);
@@ -490,10 +668,26 @@ void SimulationEngine::stop() {
     pthread_join(flight_generator_thread, nullptr);
     #endif
     
+    // Flights still being serviced get their reports and move on
+    service_scheduler->stop();
+    
     logger->log_event("[SimulationEngine] All threads stopped");
+    page_trace->close();
+    if (resource_profiler->export_csv("logs/resource_profile.csv")) {
+        logger->log_resource("[SimulationEngine] Resource profile written to logs/resource_profile.csv");
+    }
     logger->flush_all();
 }
 
+bool SimulationEngine::enable_page_trace(const string& path) {
+    if (!page_trace->open(path)) {
+        logger->log_memory("[SimulationEngine] Could not open page trace file " + path);
+        return false;
+    }
+    logger->log_memory("[SimulationEngine] Capturing page references to " + path);
+    return true;
+}
+
 // REQ-5: ATC clearance system implementation
 bool SimulationEngine::acquire_atc_clearance() {
     int current = available_atc.load();
@@ -15,11 +15,16 @@
 #include "../memory/ClockReplacer.h"
 #include "../memory/ThrashingDetector.h"
 #include "../resources/ResourceManager.h"
+#include "../resources/ResourceProfiler.h"
 #include "../crisis/CrisisManager.h"
 #include "../memory/Prefetcher.h"
+#include "../memory/PageTrace.h"
 #include "../crew/CrewManager.h"
+#include "../services/ServiceScheduler.h"
+#include "../services/TurnaroundEstimator.h"
 #include "../airport/Aircraft.h"
 #include "../airport/Flight.h"
+#include "../airport/FlightRegistry.h"
 #include "FlightEvents.h"
 #include "../finance/CostModel.h"
 #include "../finance/RevenueModel.h"
@@ -50,6 +55,7 @@ private:
     RunwayManager* runway_manager;
     GateManager* gate_manager;
     TaxiwayGraph* taxiway_graph;
+    FlightRegistry* flight_registry;    // Owns every flight
     HMFQQueue* scheduler;  // HMFQ-PPRA Scheduler
     
     // Memory Manager components
@@ -60,6 +66,7 @@ private:
     
     // Resource Manager (Banker's Algorithm)
     ResourceManager* resource_manager;
+    ResourceProfiler* resource_profiler;   // Pool utilization/wait time series
     
     // Crisis Manager (Weather and Emergencies)
     CrisisManager* crisis_manager;
@@ -67,9 +74,17 @@ private:
     // Prefetcher for predictive memory access
     Prefetcher* prefetcher;
     
+    // Page-reference trace capture (disabled unless a trace file is set)
+    PageTrace* page_trace;
+    
     // Crew Manager (LRU assignment with fatigue)
     CrewManager* crew_manager;
     
+    // Ground services of every flight at a gate, on one shared pool
+    ServiceDependencyGraph* service_graph;
+    ServiceScheduler* service_scheduler;
+    TurnaroundEstimator* turnaround_estimator;  // P50/P90 per category, sampled at startup
+    
     // Finance tracking
     CostModel* cost_model;
     RevenueModel* revenue_model;
@@ -88,6 +103,11 @@ private:
     // Flight generation
     atomic<int> next_flight_id;
     
+    // Timetable from a CSV file replaces the generated flights
+    static constexpr long long SCHEDULE_START = 5;    // First scheduled arrival (time units)
+    string schedule_path;
+    bool schedule_loaded;
+    
     atomic<bool> simulation_running;
     long long simulation_duration;
     
@@ -108,6 +128,7 @@ private:
     void load_configuration();
     void initialize_airport();
     void generate_initial_flights();
+    bool load_schedule(const string& path);
     
 public:
     SimulationEngine();
@@ -117,20 +138,36 @@ public:
     void run();
     void stop();
     
+    // Capture every simulated page reference to a trace file
+    bool enable_page_trace(const string& path);
+    
+    // Run a CSV timetable (see ScheduleReader) instead of random flights;
+    // loaded by initialize()
+    void set_schedule_file(const string& path) { schedule_path = path; }
+    
+    // Taxiway graph nodes of runway exits and gate stands
+    static int runway_exit_node(int runway_id) { return 100 + runway_id; }
+    static int gate_node(int gate_id) { return 200 + gate_id; }
+    
     // Getters
     TimeManager* get_time_manager() { return time_manager; }
     EventQueue* get_event_queue() { return event_queue; }
     RunwayManager* get_runway_manager() { return runway_manager; }
     GateManager* get_gate_manager() { return gate_manager; }
     TaxiwayGraph* get_taxiway_graph() { return taxiway_graph; }
+    FlightRegistry* get_flight_registry() { return flight_registry; }
     HMFQQueue* get_scheduler() { return scheduler; }
     TLB* get_tlb() { return tlb; }
     ThrashingDetector* get_thrashing_detector() { return thrashing_detector; }
     ResourceManager* get_resource_manager() { return resource_manager; }
+    ResourceProfiler* get_resource_profiler() { return resource_profiler; }
     CrisisManager* get_crisis_manager() { return crisis_manager; }
     Prefetcher* get_prefetcher() { return prefetcher; }
+    PageTrace* get_page_trace() { return page_trace; }
     WorkingSetManager* get_working_set_manager() { return working_set_manager; }
     CrewManager* get_crew_manager() { return crew_manager; }
+    ServiceScheduler* get_service_scheduler() { return service_scheduler; }
+    TurnaroundEstimator* get_turnaround_estimator() { return turnaround_estimator; }
     CostModel* get_cost_model() { return cost_model; }
     RevenueModel* get_revenue_model() { return revenue_model; }
     
@@ -26,23 +26,8 @@ Crew::Crew(int id, const string& n, CrewRole r) {
     }
     
     // Randomly assign skill level (weighted distribution)
-    // 30% Novice, 40% Standard, 20% Experienced, 10% Expert
-    uniform_int_distribution<int> dist(1, 100);
-    int roll = dist(rng);
-    
-    if (roll <= 30) {
-        skill_level = SKILL_NOVICE;
-        skill_multiplier = 0.80;  // -20% efficiency
-    } else if (roll <= 70) {
-        skill_level = SKILL_STANDARD;
-        skill_multiplier = 1.00;  // Normal efficiency
-    } else if (roll <= 90) {
-        skill_level = SKILL_EXPERIENCED;
-        skill_multiplier = 1.10;  // +10% efficiency
-    } else {
-        skill_level = SKILL_EXPERT;
-        skill_multiplier = 1.20;  // +20% efficiency
-    }
+    skill_level = draw_skill_level(rng);
+    skill_multiplier = multiplier_for(skill_level);
     
     experience_points = 0;
     
@@ -153,23 +138,29 @@ void Crew::set_skill_level(SkillLevel level) {
     pthread_mutex_lock(&crew_mutex);
     
     skill_level = level;
+    skill_multiplier = multiplier_for(level);
     
+    pthread_mutex_unlock(&crew_mutex);
+}
+
+SkillLevel Crew::draw_skill_level(mt19937& generator) {
+    // 30% Novice, 40% Standard, 20% Experienced, 10% Expert
+    uniform_int_distribution<int> dist(1, 100);
+    int roll = dist(generator);
+    if (roll <= 30) return SKILL_NOVICE;
+    if (roll <= 70) return SKILL_STANDARD;
+    if (roll <= 90) return SKILL_EXPERIENCED;
+    return SKILL_EXPERT;
+}
+
+double Crew::multiplier_for(SkillLevel level) {
     switch (level) {
-        case SKILL_NOVICE:
-            skill_multiplier = 0.80;
-            break;
-        case SKILL_STANDARD:
-            skill_multiplier = 1.00;
-            break;
-        case SKILL_EXPERIENCED:
-            skill_multiplier = 1.10;
-            break;
-        case SKILL_EXPERT:
-            skill_multiplier = 1.20;
-            break;
+        case SKILL_NOVICE: return 0.80;         // -20% efficiency
+        case SKILL_STANDARD: return 1.00;       // Normal efficiency
+        case SKILL_EXPERIENCED: return 1.10;    // +10% efficiency
+        case SKILL_EXPERT: return 1.20;         // +20% efficiency
+        default: return 1.00;
     }
-    
-    pthread_mutex_unlock(&crew_mutex);
 }
 
 double Crew::calculate_service_duration(int base_duration) const {
@@ -79,6 +79,10 @@ public:
     double calculate_service_duration(int base_duration) const;
     static const char* skill_level_to_string(SkillLevel level);
     
+    // Hiring mix: 30% novice, 40% standard, 20% experienced, 10% expert
+    static SkillLevel draw_skill_level(mt19937& generator);
+    static double multiplier_for(SkillLevel level);
+    
     // Getters
     int get_id() const { return crew_id; }
     string get_name() const { return name; }
@@ -0,0 +1,238 @@
+#include "ScheduleReader.h"
+#include <fstream>
+#include <cstring>
+#include <cctype>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static void trim(const char*& begin, const char*& end) {
+    while (begin < end && isspace((unsigned char)*begin)) begin++;
+    while (end > begin && isspace((unsigned char)end[-1])) end--;
+}
+
+// Case-insensitive, with '_' matching ' ' ("FALCON_7X" == "Falcon 7X")
+static bool field_equals(const char* begin, const char* end, const char* name) {
+    size_t length = strlen(name);
+    if ((size_t)(end - begin) != length) return false;
+    for (size_t i = 0; i < length; i++) {
+        char a = toupper((unsigned char)begin[i]);
+        char b = toupper((unsigned char)name[i]);
+        if (a == '_') a = ' ';
+        if (b == '_') b = ' ';
+        if (a != b) return false;
+    }
+    return true;
+}
+
+ScheduleReader::ScheduleReader()
+    : data(nullptr), size(0), position(0), line(0), first_row(true), mapped(false), error_count(0) {
+}
+
+ScheduleReader::~ScheduleReader() {
+    close();
+}
+
+bool ScheduleReader::open(const string& path) {
+    close();
+    
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size = info.st_size;
+    if (size > 0) {
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            size = 0;
+            return false;
+        }
+        madvise(map, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(map);
+        mapped = true;
+    }
+    ::close(fd);     // The mapping stays valid
+#else
+    ifstream file(path, ios::binary);
+    if (!file) return false;
+    owned_data.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    data = owned_data.data();
+    size = owned_data.size();
+#endif
+    return true;
+}
+
+void ScheduleReader::close() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+    mapped = false;
+    owned_data.clear();
+    data = nullptr;
+    size = 0;
+    position = 0;
+    line = 0;
+    first_row = true;
+    error_count = 0;
+    errors.clear();
+    seen_ids.clear();
+}
+
+void ScheduleReader::record_error(const string& message) {
+    error_count++;
+    if ((int)errors.size() < MAX_REPORTED_ERRORS) {
+        errors.push_back("line " + to_string(line) + ": " + message);
+    }
+}
+
+bool ScheduleReader::next(ScheduleRow& row) {
+    while (position < size) {
+        const char* begin = data + position;
+        const char* newline = static_cast<const char*>(memchr(begin, '\n', size - position));
+        const char* end = newline ? newline : data + size;
+        position = newline ? (newline - data) + 1 : size;
+        line++;
+        
+        trim(begin, end);
+        if (begin == end || *begin == '#') continue;
+        bool header = first_row && is_header(begin, end);
+        first_row = false;
+        if (!header && parse_row(begin, end, row)) {
+            row.line = line;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ScheduleReader::parse_row(const char* begin, const char* end, ScheduleRow& row) {
+    // Split into exactly five comma-separated fields
+    const char* field_begin[5];
+    const char* field_end[5];
+    int fields = 0;
+    const char* p = begin;
+    while (fields < 5) {
+        const char* comma = static_cast<const char*>(memchr(p, ',', end - p));
+        field_begin[fields] = p;
+        field_end[fields] = comma ? comma : end;
+        trim(field_begin[fields], field_end[fields]);
+        fields++;
+        if (!comma) break;
+        p = comma + 1;
+        if (fields == 5) {
+            record_error("more than 5 fields");
+            return false;
+        }
+    }
+    if (fields < 5) {
+        record_error("expected 5 fields, got " + to_string(fields));
+        return false;
+    }
+    
+    if (field_begin[0] == field_end[0]) {
+        record_error("empty flight id");
+        return false;
+    }
+    if (!parse_aircraft(field_begin[1], field_end[1], row.aircraft_type) ||
+        !parse_flight_type(field_begin[2], field_end[2], row.flight_type) ||
+        !parse_time(field_begin[3], field_end[3], row.arrival_time) ||
+        !parse_time(field_begin[4], field_end[4], row.departure_time)) {
+        record_error("bad aircraft type, flight type or time");
+        return false;
+    }
+    if (row.departure_time <= row.arrival_time) {
+        record_error("departure not after arrival");
+        return false;
+    }
+    row.flight_id.assign(field_begin[0], field_end[0] - field_begin[0]);
+    if (!seen_ids.insert(row.flight_id).second) {
+        record_error("duplicate flight id " + row.flight_id);
+        return false;
+    }
+    return true;
+}
+
+bool ScheduleReader::is_header(const char* begin, const char* end) {
+    static const char* COLUMNS[5] = {"flight_id", "aircraft_type", "flight_type", "arrival", "departure"};
+    const char* p = begin;
+    for (int f = 0; f < 5; f++) {
+        const char* comma = static_cast<const char*>(memchr(p, ',', end - p));
+        if ((comma == nullptr) != (f == 4)) return false;
+        const char* field_begin = p;
+        const char* field_end = comma ? comma : end;
+        trim(field_begin, field_end);
+        if (!field_equals(field_begin, field_end, COLUMNS[f])) return false;
+        if (comma) p = comma + 1;
+    }
+    return true;
+}
+
+bool ScheduleReader::parse_aircraft(const char* begin, const char* end, AircraftType& type) {
+    static const AircraftType TYPES[] = {A380, B777, B747F, B777F, B737, A320, G650, FALCON_7X, EMERGENCY};
+    for (AircraftType t : TYPES) {
+        if (field_equals(begin, end, Aircraft::get(t)->type_name.c_str())) {
+            type = t;
+            return true;
+        }
+    }
+    if (field_equals(begin, end, "FALCON_7X")) {
+        type = FALCON_7X;
+        return true;
+    }
+    return false;
+}
+
+bool ScheduleReader::parse_flight_type(const char* begin, const char* end, FlightType& type) {
+    if (field_equals(begin, end, "D") || field_equals(begin, end, "DOMESTIC")) {
+        type = DOMESTIC;
+        return true;
+    }
+    if (field_equals(begin, end, "I") || field_equals(begin, end, "INTERNATIONAL")) {
+        type = INTERNATIONAL;
+        return true;
+    }
+    return false;
+}
+
+bool ScheduleReader::parse_time(const char* begin, const char* end, long long& time) {
+    // Units, or HH:MM[:SS] -> seconds
+    if (begin == end) return false;
+    long long parts[3] = {0, 0, 0};
+    int count = 0;
+    const char* p = begin;
+    while (count < 3) {
+        if (p == end || !isdigit((unsigned char)*p)) return false;
+        long long value = 0;
+        while (p < end && isdigit((unsigned char)*p)) {
+            value = value * 10 + (*p - '0');
+            if (value > 1000000000LL) return false;
+            p++;
+        }
+        parts[count++] = value;
+        if (p == end) break;
+        if (*p != ':') return false;
+        p++;
+    }
+    if (p != end) return false;
+    
+    if (count == 1) {
+        time = parts[0];
+    } else {
+        if (parts[1] >= 60 || parts[2] >= 60) return false;
+        time = parts[0] * 3600 + parts[1] * 60 + parts[2];
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef SCHEDULE_READER_H
+#define SCHEDULE_READER_H
+
+#include "../airport/Flight.h"
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+using namespace std;
+
+// ScheduleReader streams flight schedule rows from a CSV file:
+//
+//   flight_id,aircraft_type,flight_type,arrival,departure
+//   EK201,A380,INTERNATIONAL,06:05,08:40
+//   UA88,B737,D,3600,5400
+//
+// The file is memory-mapped and parsed in place, one row per next() call,
+// so a day's timetable is never copied or held as strings. Aircraft types
+// are the Aircraft type names (A380, B777, B747F, B777F, B737, A320, G650,
+// Falcon 7X / FALCON_7X, EMERGENCY); flight type is DOMESTIC/INTERNATIONAL
+// or D/I; times are simulation units or HH:MM[:SS] (seconds since
+// midnight). Blank lines, '#' comments and a first row naming the five
+// columns above are skipped. Malformed rows and repeats of an earlier
+// flight id are skipped and counted.
+
+struct ScheduleRow {
+    string flight_id;
+    AircraftType aircraft_type;
+    FlightType flight_type;
+    long long arrival_time;
+    long long departure_time;
+    int line;
+};
+
+class ScheduleReader {
+public:
+    static constexpr int MAX_REPORTED_ERRORS = 10;
+    
+private:
+    const char* data;
+    size_t size;
+    size_t position;
+    int line;
+    bool first_row;         // Next row may be the header
+    bool mapped;            // data is an mmap (else owned_data)
+    vector<char> owned_data;
+    
+    int error_count;
+    vector<string> errors;  // First MAX_REPORTED_ERRORS messages
+    unordered_set<string> seen_ids;
+    
+    bool parse_row(const char* begin, const char* end, ScheduleRow& row);
+    void record_error(const string& message);
+    
+    static bool is_header(const char* begin, const char* end);
+    static bool parse_aircraft(const char* begin, const char* end, AircraftType& type);
+    static bool parse_flight_type(const char* begin, const char* end, FlightType& type);
+    static bool parse_time(const char* begin, const char* end, long long& time);
+    
+public:
+    ScheduleReader();
+    ~ScheduleReader();
+    
+    // Map the file; false if it cannot be opened
+    bool open(const string& path);
+    void close();
+    
+    // Next valid row; false at end of file
+    bool next(ScheduleRow& row);
+    
+    size_t get_size() const { return size; }
+    int get_line() const { return line; }
+    int get_error_count() const { return error_count; }
+    const vector<string>& get_errors() const { return errors; }
+};
+
+#endif // SCHEDULE_READER_H
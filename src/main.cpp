@@ -1,5 +1,6 @@
 #include "core/SimulationEngine.h"
 #include <iostream>
+#include <string>
 #include <cstdlib>
 #include <csignal>
 
@@ -18,7 +19,13 @@ void signal_handler(int signum) {
     }
 }
 
-int main() {
+static void print_usage(const char* program) {
+    cout << "Usage: " << program << " [--page-trace <file>] [--schedule <file>]\n"
+         << "  --page-trace <file>   Record simulated page references for replay benchmarks\n"
+         << "  --schedule <file>     Fly a CSV timetable instead of randomly generated flights\n";
+}
+
+int main(int argc, char** argv) {
     // Register signal handlers for clean shutdown
     signal(SIGINT, signal_handler);   // Ctrl+C
     signal(SIGTERM, signal_handler);  // Terminal close
@@ -34,6 +41,26 @@ int main() {
     SimulationEngine* engine = new SimulationEngine();
     g_engine = engine;  // Set global pointer for signal handler
     
+    // Command-line options
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--page-trace" && i + 1 < argc) {
+            if (!engine->enable_page_trace(argv[++i])) {
+                cerr << "Error: could not open page trace file " << argv[i] << endl;
+                g_engine = nullptr;
+                delete engine;
+                return 1;
+            }
+        } else if (arg == "--schedule" && i + 1 < argc) {
+            engine->set_schedule_file(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            g_engine = nullptr;
+            delete engine;
+            return 1;
+        }
+    }
+    
     try {
         engine->initialize();
         
@@ -43,7 +70,7 @@ int main() {
         if (!g_shutdown_requested) {
             engine->run();
         }
-        
+    
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
         g_engine = nullptr;
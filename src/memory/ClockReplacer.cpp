@@ -7,6 +7,9 @@ using namespace std;
 ClockReplacer::ClockReplacer(int frame_count) {
     num_frames = frame_count;
     clock_hand = 0;
+    compressor = nullptr;
+    compressed_reclaims = 0;
+    evicted_reclaims = 0;
     pthread_mutex_init(&clock_mutex, nullptr);
 }
 
@@ -59,12 +62,9 @@ double ClockReplacer::calculate_victim_score(Page* page, long long current_time)
     return score;
 }
 
-int ClockReplacer::clock_sweep(long long current_time) {
-    pthread_mutex_lock(&clock_mutex);
-    
+PageFrame* ClockReplacer::select_victim_locked(long long current_time) {
     if (frames.empty()) {
-        pthread_mutex_unlock(&clock_mutex);
-        return -1;
+        return nullptr;
     }
     
     // Multi-pass sweep: first look for ref=0, modified=0
@@ -91,13 +91,11 @@ int ClockReplacer::clock_sweep(long long current_time) {
             
             // Pass 1: Find ref=0, modified=0 (best victim)
             if (passes == 0 && !ref && !modified) {
-                pthread_mutex_unlock(&clock_mutex);
-                return frame->get_frame_id();
+                return frame;
             }
             // Pass 2: Find ref=0, modified=1
             else if (passes == 1 && !ref && modified) {
-                pthread_mutex_unlock(&clock_mutex);
-                return frame->get_frame_id();
+                return frame;
             }
             // Pass 3 & 4: Clear reference bits and retry
             else if (passes >= 2) {
@@ -108,7 +106,7 @@ int ClockReplacer::clock_sweep(long long current_time) {
     }
     
     // Fallback: use victim scoring to find best candidate
-    int best_frame = -1;
+    PageFrame* best_frame = nullptr;
     double best_score = -1.0;
     
     for (int i = 0; i < (int)frames.size(); i++) {
@@ -118,14 +116,45 @@ int ClockReplacer::clock_sweep(long long current_time) {
         double score = calculate_victim_score(frame->get_page(), current_time);
         if (score > best_score) {
             best_score = score;
-            best_frame = frame->get_frame_id();
+            best_frame = frame;
         }
     }
     
-    pthread_mutex_unlock(&clock_mutex);
     return best_frame;
 }
 
+int ClockReplacer::clock_sweep(long long current_time) {
+    pthread_mutex_lock(&clock_mutex);
+    PageFrame* victim = select_victim_locked(current_time);
+    pthread_mutex_unlock(&clock_mutex);
+    return victim ? victim->get_frame_id() : -1;
+}
+
+int ClockReplacer::reclaim_frame(long long current_time, bool* compressed) {
+    pthread_mutex_lock(&clock_mutex);
+    
+    PageFrame* victim = select_victim_locked(current_time);
+    Page* page = victim ? victim->evict_page() : nullptr;
+    if (page == nullptr) {
+        pthread_mutex_unlock(&clock_mutex);
+        if (compressed) *compressed = false;
+        return (victim && victim->is_empty()) ? victim->get_frame_id() : -1;
+    }
+    
+    // Compressing beats eviction when compress + decompress costs less
+    // than the write-out and refault; rejected pages are evicted
+    bool kept = compressor && compressor->should_compress(page) && compressor->compress_page(page);
+    if (kept) {
+        compressed_reclaims++;
+    } else {
+        evicted_reclaims++;
+    }
+    
+    pthread_mutex_unlock(&clock_mutex);
+    if (compressed) *compressed = kept;
+    return victim->get_frame_id();
+}
+
 int ClockReplacer::find_victim(long long current_time) {
     return clock_sweep(current_time);
 }
@@ -3,6 +3,7 @@
 
 #include "Page.h"
 #include "PageFrame.h"
+#include "CompressionManager.h"
 #include <vector>
 #include <pthread.h>
 
@@ -12,6 +13,10 @@ using namespace std;
 // Multi-pass clock algorithm with composite victim scoring
 // Formula from README:
 // Victim_Score = (Frequency × W_freq) + (Recency × W_rec) + (Phase × W_phase) + ...
+//
+// reclaim_frame() frees the victim's frame: with a CompressionManager
+// attached, a victim it judges worth compressing moves to the compressed
+// tier (a later access is a cheap decompress) instead of being evicted.
 
 class ClockReplacer {
 private:
@@ -27,11 +32,18 @@ private:
     static constexpr double W_TIER = 0.10;      // Data tier
     static constexpr double W_DIRTY = 0.10;     // Dirty bit penalty
     
+    CompressionManager* compressor;     // Not owned; nullptr = evict only
+    long long compressed_reclaims;
+    long long evicted_reclaims;
+    
     pthread_mutex_t clock_mutex;
     
     // Calculate victim score (higher = better victim)
     double calculate_victim_score(Page* page, long long current_time);
     
+    // Caller holds clock_mutex
+    PageFrame* select_victim_locked(long long current_time);
+    
 public:
     ClockReplacer(int frame_count);
     ~ClockReplacer();
@@ -45,8 +57,17 @@ public:
     // Multi-pass algorithm
     int clock_sweep(long long current_time);
     
+    // Compress-or-evict decisions for reclaimed victims (nullptr detaches)
+    void attach_compression_manager(CompressionManager* manager) { compressor = manager; }
+    
+    // Free the victim's frame, compressing or evicting its page; returns
+    // the freed frame id (-1 if none). compressed reports which happened.
+    int reclaim_frame(long long current_time, bool* compressed = nullptr);
+    
     // Statistics
     int get_hand_position() const { return clock_hand; }
+    long long get_compressed_reclaims() const { return compressed_reclaims; }
+    long long get_evicted_reclaims() const { return evicted_reclaims; }
 };
 
 #endif // CLOCK_REPLACER_H
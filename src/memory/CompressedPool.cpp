@@ -0,0 +1,106 @@
+#include "CompressedPool.h"
+#include <cstring>
+
+using namespace std;
+
+CompressedPool::CompressedPool(long long capacity) {
+    capacity_bytes = capacity;
+    slab_bytes = 0;
+    stored_bytes = 0;
+    stored_objects = 0;
+
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        classes[c].slot_size = (c + 1) * CLASS_GRANULE;
+        classes[c].slots_per_slab = SLAB_SIZE / classes[c].slot_size;
+    }
+}
+
+CompressedPool::~CompressedPool() {
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        for (uint8_t* slab : classes[c].slabs) {
+            delete[] slab;
+        }
+    }
+}
+
+uint8_t* CompressedPool::slot_address(const SizeClass& sc, int slot) const {
+    int slab = slot / sc.slots_per_slab;
+    int index = slot % sc.slots_per_slab;
+    return sc.slabs[slab] + (size_t)index * sc.slot_size;
+}
+
+int CompressedPool::store(const uint8_t* data, int length) {
+    if (length <= 0 || length > MAX_OBJECT_SIZE) return -1;
+
+    int class_index = (length - 1) / CLASS_GRANULE;
+    SizeClass& sc = classes[class_index];
+
+    // Grow this class by one slab if it has no free slot
+    if (sc.free_slots.empty()) {
+        int slab_size = sc.slots_per_slab * sc.slot_size;
+        if (slab_bytes + slab_size > capacity_bytes) {
+            return -1;  // Pool full - caller should evict instead
+        }
+
+        int slab_index = (int)sc.slabs.size();
+        sc.slabs.push_back(new uint8_t[slab_size]);
+        slab_bytes += slab_size;
+
+        // Push in reverse so slots are handed out in address order
+        for (int i = sc.slots_per_slab - 1; i >= 0; i--) {
+            sc.free_slots.push_back(slab_index * sc.slots_per_slab + i);
+        }
+    }
+
+    int slot = sc.free_slots.back();
+    sc.free_slots.pop_back();
+    memcpy(slot_address(sc, slot), data, length);
+
+    int handle;
+    if (!free_handles.empty()) {
+        handle = free_handles.back();
+        free_handles.pop_back();
+    } else {
+        handle = (int)handles.size();
+        handles.push_back(Handle{});
+    }
+    handles[handle] = Handle{class_index, slot, length, true};
+
+    stored_bytes += length;
+    stored_objects++;
+    return handle;
+}
+
+const uint8_t* CompressedPool::get(int handle) const {
+    if (handle < 0 || handle >= (int)handles.size() || !handles[handle].in_use) {
+        return nullptr;
+    }
+    const Handle& h = handles[handle];
+    return slot_address(classes[h.size_class], h.slot);
+}
+
+int CompressedPool::get_length(int handle) const {
+    if (handle < 0 || handle >= (int)handles.size() || !handles[handle].in_use) {
+        return 0;
+    }
+    return handles[handle].length;
+}
+
+void CompressedPool::free_object(int handle) {
+    if (handle < 0 || handle >= (int)handles.size() || !handles[handle].in_use) {
+        return;
+    }
+
+    Handle& h = handles[handle];
+    classes[h.size_class].free_slots.push_back(h.slot);
+    stored_bytes -= h.length;
+    stored_objects--;
+
+    h.in_use = false;
+    free_handles.push_back(handle);
+}
+
+double CompressedPool::get_fragmentation() const {
+    if (slab_bytes == 0) return 0.0;
+    return 1.0 - (double)stored_bytes / slab_bytes;
+}
@@ -0,0 +1,70 @@
+#ifndef COMPRESSED_POOL_H
+#define COMPRESSED_POOL_H
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+// CompressedPool stores compressed page payloads (zswap/zsmalloc style)
+// Objects are rounded up to a size class; each class carves fixed-size
+// slots out of its own slabs and recycles them through a free list, so
+// storing a compressed page never touches the general-purpose heap once
+// the slabs are warm.
+// Not thread-safe: CompressionManager serializes access.
+
+class CompressedPool {
+private:
+    static constexpr int CLASS_GRANULE = 32;      // Size class step (bytes)
+    static constexpr int MAX_OBJECT_SIZE = 4096;  // One uncompressed page
+    static constexpr int NUM_CLASSES = MAX_OBJECT_SIZE / CLASS_GRANULE;
+    static constexpr int SLAB_SIZE = 16384;       // Bytes per slab
+
+    struct SizeClass {
+        int slot_size;
+        int slots_per_slab;
+        vector<uint8_t*> slabs;
+        vector<int> free_slots;   // Encoded as slab * slots_per_slab + slot
+    };
+
+    struct Handle {
+        int size_class;
+        int slot;
+        int length;
+        bool in_use;
+    };
+
+    SizeClass classes[NUM_CLASSES];
+    vector<Handle> handles;
+    vector<int> free_handles;
+
+    long long capacity_bytes;     // Max slab memory
+    long long slab_bytes;         // Slab memory currently allocated
+    long long stored_bytes;       // Payload bytes currently stored
+    int stored_objects;
+
+    uint8_t* slot_address(const SizeClass& sc, int slot) const;
+
+public:
+    CompressedPool(long long capacity = 4 * 1024 * 1024);  // Default 4 MiB
+    ~CompressedPool();
+
+    // Store length bytes; returns handle or -1 if pool is full
+    int store(const uint8_t* data, int length);
+
+    // Access stored object (pointer valid until free_object)
+    const uint8_t* get(int handle) const;
+    int get_length(int handle) const;
+
+    // Release object back to its size class
+    void free_object(int handle);
+
+    // Statistics
+    long long get_capacity() const { return capacity_bytes; }
+    long long get_slab_bytes() const { return slab_bytes; }
+    long long get_stored_bytes() const { return stored_bytes; }
+    int get_stored_objects() const { return stored_objects; }
+    double get_fragmentation() const;  // Wasted fraction of slab memory
+};
+
+#endif // COMPRESSED_POOL_H
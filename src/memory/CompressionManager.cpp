@@ -1,32 +1,32 @@
 #include "CompressionManager.h"
-#include <algorithm>
+#include "PageCodec.h"
+#include <chrono>
 
 using namespace std;
 
-CompressionManager::CompressionManager() {
+static inline long long elapsed_ns(chrono::steady_clock::time_point start) {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count();
+}
+
+CompressionManager::CompressionManager(long long pool_capacity) {
+    pool = new CompressedPool(pool_capacity);
     pages_compressed = 0;
     pages_decompressed = 0;
     bytes_saved = 0;
+    for (TierCompressionStats& ts : tier_stats) {
+        ts = TierCompressionStats{};
+    }
     pthread_mutex_init(&compress_mutex, nullptr);
 }
 
 CompressionManager::~CompressionManager() {
+    delete pool;
     pthread_mutex_destroy(&compress_mutex);
 }
 
-bool CompressionManager::is_compressible(Page* page) {
-    if (page == nullptr) return false;
-    
-    // Simulate: cold data is more compressible
-    DataTier tier = page->get_tier();
-    return tier == TIER_L3 || tier == TIER_L4;
-}
-
-double CompressionManager::estimate_ratio(Page* page) {
-    if (page == nullptr) return 1.0;
-    
-    // Simulate compression ratio based on tier
-    switch (page->get_tier()) {
+double CompressionManager::default_ratio(DataTier tier) {
+    switch (tier) {
         case TIER_L4: return 0.3;  // Historical logs compress well
         case TIER_L3: return 0.5;
         case TIER_L2: return 0.7;
@@ -35,43 +35,226 @@ double CompressionManager::estimate_ratio(Page* page) {
     }
 }
 
-bool CompressionManager::compress_page(Page* page) {
+double CompressionManager::estimate_ratio(Page* page) {
+    if (page == nullptr) return 1.0;
+
+    DataTier tier = page->get_tier();
+    pthread_mutex_lock(&compress_mutex);
+    const TierCompressionStats& ts = tier_stats[tier];
+    double ratio = (ts.pages_compressed + ts.pages_rejected >= MIN_SAMPLES && ts.bytes_in > 0)
+                   ? (double)ts.bytes_out / ts.bytes_in
+                   : default_ratio(tier);
+    pthread_mutex_unlock(&compress_mutex);
+    return ratio;
+}
+
+bool CompressionManager::is_compressible(Page* page) {
     if (page == nullptr) return false;
+
+    DataTier tier = page->get_tier();
+    pthread_mutex_lock(&compress_mutex);
+    bool measured = tier_stats[tier].pages_compressed + tier_stats[tier].pages_rejected >= MIN_SAMPLES;
+    pthread_mutex_unlock(&compress_mutex);
+
+    if (!measured) {
+        // No data yet: try it - compress_page rejects and counts poor pages
+        return true;
+    }
+    return estimate_ratio(page) <= MAX_STORE_RATIO;
+}
+
+bool CompressionManager::should_compress(Page* page) {
     if (!is_compressible(page)) return false;
+
+    DataTier tier = page->get_tier();
+    pthread_mutex_lock(&compress_mutex);
+    const TierCompressionStats& ts = tier_stats[tier];
+    bool decide;
+    if (ts.pages_compressed + ts.pages_rejected < MIN_SAMPLES) {
+        decide = true;  // Keep sampling until costs are known
+    } else {
+        // Compressing wins if a compress + later decompress is cheaper than
+        // writing the page out and faulting it back in
+        double avg_compress = (double)ts.compress_ns / (ts.pages_compressed + ts.pages_rejected);
+        double avg_decompress = ts.pages_decompressed > 0
+                                ? (double)ts.decompress_ns / ts.pages_decompressed
+                                : avg_compress;
+        decide = avg_compress + avg_decompress < SWAP_IO_NS;
+    }
+    bool has_room = pool->get_stored_bytes() + Page::PAGE_SIZE * MAX_STORE_RATIO <= pool->get_capacity();
+    pthread_mutex_unlock(&compress_mutex);
+
+    return decide && has_room;
+}
+
+bool CompressionManager::compress_page(Page* page) {
+    if (page == nullptr) return false;
+
+    page->lock_payload();
+    bool compressed = compress_payload(page);
+    page->unlock_payload();
+    return compressed;
+}
+
+bool CompressionManager::compress_payload(Page* page) {
+    // A concurrent call may have compressed it while we waited
     if (page->get_state() == PAGE_COMPRESSED) return true;
-    
+
+    DataTier tier = page->get_tier();
+    const uint8_t* payload = page->get_data();
+
+    // Zero-filled page (never materialized): nothing to store
+    if (payload == nullptr) {
+        pthread_mutex_lock(&compress_mutex);
+        page->set_compressed_handle(-1);
+        page->set_compressed_size(0);
+        page->set_compressor(this);
+        page->set_state(PAGE_COMPRESSED);
+        pages_compressed++;
+        bytes_saved += Page::PAGE_SIZE;
+        pthread_mutex_unlock(&compress_mutex);
+        return true;
+    }
+
+    // Compress outside the lock into a scratch buffer
+    uint8_t scratch[Page::PAGE_SIZE + Page::PAGE_SIZE / 255 + 16];
+    auto start = chrono::steady_clock::now();
+    int compressed_size = PageCodec::compress(payload, Page::PAGE_SIZE, scratch, sizeof(scratch));
+    long long ns = elapsed_ns(start);
+
     pthread_mutex_lock(&compress_mutex);
-    
-    int original_size = page->get_data_size();
-    double ratio = estimate_ratio(page);
-    int compressed_size = max(MIN_PAGE_SIZE, (int)(original_size * ratio));
-    
+
+    TierCompressionStats& ts = tier_stats[tier];
+    ts.compress_ns += ns;
+    ts.bytes_in += Page::PAGE_SIZE;
+
+    if (compressed_size < 0 || compressed_size > Page::PAGE_SIZE * MAX_STORE_RATIO) {
+        // Incompressible - leave page for eviction
+        ts.bytes_out += Page::PAGE_SIZE;
+        ts.pages_rejected++;
+        pthread_mutex_unlock(&compress_mutex);
+        return false;
+    }
+    ts.bytes_out += compressed_size;
+
+    int handle = pool->store(scratch, compressed_size);
+    if (handle < 0) {
+        ts.pages_rejected++;  // Pool full
+        pthread_mutex_unlock(&compress_mutex);
+        return false;
+    }
+
+    page->set_compressed_handle(handle);
     page->set_compressed_size(compressed_size);
+    page->set_compressor(this);
+    page->release_data();
     page->set_state(PAGE_COMPRESSED);
-    
+
+    ts.pages_compressed++;
     pages_compressed++;
-    bytes_saved += (original_size - compressed_size);
-    
+    bytes_saved += (Page::PAGE_SIZE - compressed_size);
+
     pthread_mutex_unlock(&compress_mutex);
     return true;
 }
 
 bool CompressionManager::decompress_page(Page* page) {
     if (page == nullptr) return false;
+
+    page->lock_payload();
+    bool restored = decompress_payload(page);
+    page->unlock_payload();
+    return restored;
+}
+
+bool CompressionManager::decompress_payload(Page* page) {
     if (page->get_state() != PAGE_COMPRESSED) return true;
-    
+
     pthread_mutex_lock(&compress_mutex);
-    
+
+    int handle = page->get_compressed_handle();
+    if (handle >= 0) {
+        uint8_t* buffer = page->allocate_data();
+
+        auto start = chrono::steady_clock::now();
+        int size = PageCodec::decompress(pool->get(handle), pool->get_length(handle),
+                                         buffer, Page::PAGE_SIZE);
+        long long ns = elapsed_ns(start);
+
+        if (size != Page::PAGE_SIZE) {
+            // Corrupt object: keep it compressed rather than hand out garbage
+            page->release_data();
+            pthread_mutex_unlock(&compress_mutex);
+            return false;
+        }
+
+        TierCompressionStats& ts = tier_stats[page->get_tier()];
+        ts.decompress_ns += ns;
+        ts.pages_decompressed++;
+
+        pool->free_object(handle);
+        bytes_saved -= (Page::PAGE_SIZE - page->get_compressed_size());
+    } else {
+        bytes_saved -= Page::PAGE_SIZE;  // Zero-filled page
+    }
+
+    page->set_compressed_handle(-1);
     page->set_compressed_size(0);
+    page->set_compressor(nullptr);
     page->set_state(PAGE_VALID);
     pages_decompressed++;
-    
+
     pthread_mutex_unlock(&compress_mutex);
     return true;
 }
 
+void CompressionManager::discard_page(Page* page) {
+    if (page == nullptr) return;
+
+    page->lock_payload();
+    pthread_mutex_lock(&compress_mutex);
+
+    if (page->get_state() == PAGE_COMPRESSED) {
+        int handle = page->get_compressed_handle();
+        if (handle >= 0) {
+            pool->free_object(handle);
+            bytes_saved -= (Page::PAGE_SIZE - page->get_compressed_size());
+        } else {
+            bytes_saved -= Page::PAGE_SIZE;  // Zero-filled page
+        }
+        page->set_compressed_handle(-1);
+        page->set_compressed_size(0);
+        page->set_compressor(nullptr);
+        page->set_state(PAGE_INVALID);
+    }
+
+    pthread_mutex_unlock(&compress_mutex);
+    page->unlock_payload();
+}
+
+TierCompressionStats CompressionManager::get_tier_stats(DataTier tier) {
+    pthread_mutex_lock(&compress_mutex);
+    TierCompressionStats ts = tier_stats[tier];
+    pthread_mutex_unlock(&compress_mutex);
+
+    ts.ratio = ts.bytes_in > 0 ? (double)ts.bytes_out / ts.bytes_in : 1.0;
+    // bytes/ns * 1000 = MB/s
+    long long compress_attempts = ts.pages_compressed + ts.pages_rejected;
+    ts.compress_mb_per_s = ts.compress_ns > 0 ? (double)ts.bytes_in / ts.compress_ns * 1000.0 : 0.0;
+    ts.decompress_mb_per_s = ts.decompress_ns > 0
+                             ? (double)ts.pages_decompressed * Page::PAGE_SIZE / ts.decompress_ns * 1000.0
+                             : 0.0;
+    ts.avg_compress_ns = compress_attempts > 0 ? (double)ts.compress_ns / compress_attempts : 0.0;
+    ts.avg_decompress_ns = ts.pages_decompressed > 0 ? (double)ts.decompress_ns / ts.pages_decompressed : 0.0;
+    return ts;
+}
+
 double CompressionManager::get_average_ratio() const {
-    if (pages_compressed == 0) return 1.0;
-    // Approximate based on bytes saved
-    return 1.0 - ((double)bytes_saved / (pages_compressed * 4096));
+    long long in = 0, out = 0;
+    for (const TierCompressionStats& ts : tier_stats) {
+        in += ts.bytes_in;
+        out += ts.bytes_out;
+    }
+    if (in == 0) return 1.0;
+    return (double)out / in;
 }
@@ -2,43 +2,92 @@
 #define COMPRESSION_MANAGER_H
 
 #include "Page.h"
+#include "CompressedPool.h"
 #include <pthread.h>
 
 using namespace std;
 
 // CompressionManager handles page compression to increase effective memory
+// Compressed tier (zswap-like): page payloads are LZ-compressed with
+// PageCodec into a CompressedPool, and the page's own buffer is released.
+// Compress/decompress cost and achieved ratio are measured per DataTier so
+// the compress-vs-evict decision uses real numbers. ClockReplacer asks
+// should_compress() for each victim it reclaims.
+// A compressed page returns its pool slot when destroyed, so the manager
+// must outlive the pages it has compressed.
+
+// Measured compression costs for one data tier
+struct TierCompressionStats {
+    long long pages_compressed;
+    long long pages_decompressed;
+    long long pages_rejected;     // Compressed poorly or pool full
+    long long bytes_in;
+    long long bytes_out;
+    long long compress_ns;
+    long long decompress_ns;
+
+    double ratio;                 // bytes_out / bytes_in (lower is better)
+    double compress_mb_per_s;
+    double decompress_mb_per_s;
+    double avg_compress_ns;       // Per page
+    double avg_decompress_ns;     // Per page
+};
 
 class CompressionManager {
 private:
-    static constexpr double TARGET_RATIO = 0.5;   // Target 50% compression
-    static constexpr int MIN_PAGE_SIZE = 512;     // Minimum compressed size
-    
+    static constexpr double TARGET_RATIO = 0.5;      // Target 50% compression
+    static constexpr double MAX_STORE_RATIO = 0.75;  // Reject pages worse than this
+    static constexpr int MIN_SAMPLES = 8;            // Pages before trusting measurements
+    static constexpr long long SWAP_IO_NS = 100000;  // Simulated evict + refault cost
+
+    CompressedPool* pool;
+
     int pages_compressed;
     int pages_decompressed;
     long long bytes_saved;
-    
+
+    // Raw per-tier counters (indexed by DataTier)
+    TierCompressionStats tier_stats[4];
+
     pthread_mutex_t compress_mutex;
-    
+
+    // Ratio estimate reported until a tier has MIN_SAMPLES measurements;
+    // every tier is sampled before its measured ratio decides
+    static double default_ratio(DataTier tier);
+
+    // Caller holds the page's payload lock
+    bool compress_payload(Page* page);
+    bool decompress_payload(Page* page);
+
 public:
-    CompressionManager();
+    CompressionManager(long long pool_capacity = 4 * 1024 * 1024);
     ~CompressionManager();
-    
-    // Compress a page (simuates compression)
+
+    // Compress page payload into the compressed pool
+    // Pages without a payload are treated as zero-filled
     bool compress_page(Page* page);
-    
-    // Decompress a page
+
+    // Decompress page payload back into a page buffer
     bool decompress_page(Page* page);
-    
+
+    // Drop a compressed page's copy without restoring it (page teardown)
+    void discard_page(Page* page);
+
     // Check if page is compressible (based on data patterns)
     bool is_compressible(Page* page);
-    
-    // Estimate compression ratio for page
+
+    // Compress-vs-evict decision using measured tier costs
+    bool should_compress(Page* page);
+
+    // Estimate compression ratio for page (measured when available)
     double estimate_ratio(Page* page);
-    
+
     // Statistics
     int get_pages_compressed() const { return pages_compressed; }
     long long get_bytes_saved() const { return bytes_saved; }
     double get_average_ratio() const;
+    TierCompressionStats get_tier_stats(DataTier tier);
+    CompressedPool* get_pool() { return pool; }
 };
 
 #endif // COMPRESSION_MANAGER_H
@@ -1,4 +1,6 @@
 #include "Page.h"
+#include "CompressionManager.h"
+#include <cstring>
 
 using namespace std;
 
@@ -14,14 +16,25 @@ Page::Page(int id, int proc_id) {
     last_access_time = 0;
     load_time = 0;
     
-    data_size = 4096;      // 4KB default page size
+    data_size = PAGE_SIZE;  // 4KB default page size
     compressed_size = 0;
     
+    data = nullptr;
+    compressed_handle = -1;
+    compressor = nullptr;
+    
     pthread_mutex_init(&page_mutex, nullptr);
+    pthread_mutex_init(&payload_mutex, nullptr);
 }
 
 Page::~Page() {
+    // Return the compressed copy's pool slot
+    if (compressor != nullptr) {
+        compressor->discard_page(this);
+    }
+    delete[] data;
     pthread_mutex_destroy(&page_mutex);
+    pthread_mutex_destroy(&payload_mutex);
 }
 
 void Page::access(long long current_time) {
@@ -54,3 +67,23 @@ void Page::set_tier(DataTier new_tier) {
     tier = new_tier;
     pthread_mutex_unlock(&page_mutex);
 }
+
+uint8_t* Page::allocate_data() {
+    pthread_mutex_lock(&page_mutex);
+    
+    if (data == nullptr) {
+        data = new uint8_t[PAGE_SIZE];
+        memset(data, 0, PAGE_SIZE);
+    }
+    uint8_t* buffer = data;
+    
+    pthread_mutex_unlock(&page_mutex);
+    return buffer;
+}
+
+void Page::release_data() {
+    pthread_mutex_lock(&page_mutex);
+    delete[] data;
+    data = nullptr;
+    pthread_mutex_unlock(&page_mutex);
+}
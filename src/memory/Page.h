@@ -2,9 +2,12 @@
 #define PAGE_H
 
 #include <pthread.h>
+#include <cstdint>
 
 using namespace std;
 
+class CompressionManager;
+
 // Page represents a unit of virtual memory
 // In airport context: flight data, passenger manifests, baggage info
 
@@ -23,6 +26,9 @@ enum DataTier {
 };
 
 class Page {
+public:
+    static constexpr int PAGE_SIZE = 4096;  // Bytes per page
+    
 private:
     int page_id;
     int process_id;         // Flight ID owning this page
@@ -40,7 +46,13 @@ private:
     int data_size;          // Bytes of actual data
     int compressed_size;    // If compressed
     
+    // Payload (allocated on demand, released while compressed)
+    uint8_t* data;
+    int compressed_handle;  // CompressedPool handle while compressed (-1 = none)
+    CompressionManager* compressor;  // Owner of compressed_handle
+    
     pthread_mutex_t page_mutex;
+    pthread_mutex_t payload_mutex;  // Held across a compress/decompress
     
 public:
     Page(int id, int proc_id);
@@ -73,11 +85,23 @@ public:
     long long get_load_time() const { return load_time; }
     int get_data_size() const { return data_size; }
     int get_compressed_size() const { return compressed_size; }
+    int get_compressed_handle() const { return compressed_handle; }
+    
+    // Payload management
+    uint8_t* get_data() const { return data; }
+    uint8_t* allocate_data();   // Zero-filled PAGE_SIZE buffer
+    void release_data();
+    // Serializes payload transitions so two compressions of one page
+    // cannot both read the buffer and both store it
+    void lock_payload() { pthread_mutex_lock(&payload_mutex); }
+    void unlock_payload() { pthread_mutex_unlock(&payload_mutex); }
     
     // Setters
     void set_load_time(long long time) { load_time = time; }
     void set_data_size(int size) { data_size = size; }
     void set_compressed_size(int size) { compressed_size = size; }
+    void set_compressed_handle(int handle) { compressed_handle = handle; }
+    void set_compressor(CompressionManager* manager) { compressor = manager; }
 };
 
 #endif // PAGE_H
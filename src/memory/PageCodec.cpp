@@ -0,0 +1,145 @@
+#include "PageCodec.h"
+#include <cstring>
+
+using namespace std;
+
+static inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t hash32(uint32_t v, int bits) {
+    return (v * 2654435761U) >> (32 - bits);
+}
+
+// Write an LZ4-style extended length (values >= 15 spill into extra bytes)
+static inline int write_length(uint8_t* dst, int op, int length) {
+    while (length >= 255) {
+        dst[op++] = 255;
+        length -= 255;
+    }
+    dst[op++] = (uint8_t)length;
+    return op;
+}
+
+int PageCodec::max_compressed_size(int src_len) {
+    return src_len + src_len / 255 + 16;
+}
+
+int PageCodec::compress(const uint8_t* src, int src_len, uint8_t* dst, int dst_capacity) {
+    int table[1 << HASH_BITS];
+    for (int& t : table) t = -1;
+
+    int ip = 0;
+    int anchor = 0;
+    int op = 0;
+    int match_limit = src_len - LAST_LITERALS - MIN_MATCH;
+
+    while (ip <= match_limit) {
+        uint32_t seq = read32(src + ip);
+        uint32_t h = hash32(seq, HASH_BITS);
+        int ref = table[h];
+        table[h] = ip;
+
+        if (ref < 0 || ip - ref > MAX_OFFSET || read32(src + ref) != seq) {
+            ip++;
+            continue;
+        }
+
+        // Extend match forward
+        int match_len = MIN_MATCH;
+        while (ip + match_len < src_len - LAST_LITERALS &&
+               src[ref + match_len] == src[ip + match_len]) {
+            match_len++;
+        }
+
+        int literal_len = ip - anchor;
+        int worst = 1 + literal_len + literal_len / 255 + 1 + 2 + match_len / 255 + 1;
+        if (op + worst > dst_capacity) return -1;
+
+        // Token
+        int lit_code = literal_len < 15 ? literal_len : 15;
+        int match_code = (match_len - MIN_MATCH) < 15 ? (match_len - MIN_MATCH) : 15;
+        dst[op++] = (uint8_t)((lit_code << 4) | match_code);
+
+        // Literals
+        if (lit_code == 15) op = write_length(dst, op, literal_len - 15);
+        memcpy(dst + op, src + anchor, literal_len);
+        op += literal_len;
+
+        // Offset + match length
+        int offset = ip - ref;
+        dst[op++] = (uint8_t)(offset & 0xFF);
+        dst[op++] = (uint8_t)(offset >> 8);
+        if (match_code == 15) op = write_length(dst, op, match_len - MIN_MATCH - 15);
+
+        ip += match_len;
+        anchor = ip;
+    }
+
+    // Final literal-only sequence
+    int literal_len = src_len - anchor;
+    if (op + 1 + literal_len + literal_len / 255 + 1 > dst_capacity) return -1;
+
+    int lit_code = literal_len < 15 ? literal_len : 15;
+    dst[op++] = (uint8_t)(lit_code << 4);
+    if (lit_code == 15) op = write_length(dst, op, literal_len - 15);
+    memcpy(dst + op, src + anchor, literal_len);
+    op += literal_len;
+
+    return op;
+}
+
+int PageCodec::decompress(const uint8_t* src, int src_len, uint8_t* dst, int dst_capacity) {
+    int ip = 0;
+    int op = 0;
+
+    while (ip < src_len) {
+        uint8_t token = src[ip++];
+
+        // Literals
+        int literal_len = token >> 4;
+        if (literal_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= src_len) return -1;
+                b = src[ip++];
+                literal_len += b;
+            } while (b == 255);
+        }
+        if (ip + literal_len > src_len || op + literal_len > dst_capacity) return -1;
+        memcpy(dst + op, src + ip, literal_len);
+        ip += literal_len;
+        op += literal_len;
+
+        // Last sequence has no match part
+        if (ip == src_len) break;
+
+        if (ip + 2 > src_len) return -1;
+        int offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return -1;
+
+        int match_len = token & 0x0F;
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (ip >= src_len) return -1;
+                b = src[ip++];
+                match_len += b;
+            } while (b == 255);
+        }
+        match_len += MIN_MATCH;
+        if (op + match_len > dst_capacity) return -1;
+
+        // Byte copy: source and destination may overlap (runs)
+        const uint8_t* match = dst + op - offset;
+        for (int i = 0; i < match_len; i++) {
+            dst[op + i] = match[i];
+        }
+        op += match_len;
+    }
+
+    return op;
+}
@@ -0,0 +1,35 @@
+#ifndef PAGE_CODEC_H
+#define PAGE_CODEC_H
+
+#include <cstdint>
+
+using namespace std;
+
+// PageCodec is a small in-tree LZ77 codec for page payloads
+// Block format follows LZ4: each sequence is
+//   token (4-bit literal length | 4-bit match length - 4)
+//   [extra literal length bytes] literals
+//   2-byte little-endian offset [extra match length bytes]
+// and the final sequence carries literals only.
+
+class PageCodec {
+private:
+    static constexpr int MIN_MATCH = 4;
+    static constexpr int HASH_BITS = 12;
+    static constexpr int LAST_LITERALS = 5;   // Trailing bytes always literal
+    static constexpr int MAX_OFFSET = 65535;
+
+public:
+    // Worst-case compressed size for an input of src_len bytes
+    static int max_compressed_size(int src_len);
+
+    // Compress src into dst; returns compressed size, or -1 if dst_capacity
+    // is too small
+    static int compress(const uint8_t* src, int src_len, uint8_t* dst, int dst_capacity);
+
+    // Decompress src into dst; returns decompressed size, or -1 if the input
+    // is malformed or does not fit in dst_capacity
+    static int decompress(const uint8_t* src, int src_len, uint8_t* dst, int dst_capacity);
+};
+
+#endif // PAGE_CODEC_H
@@ -2,10 +2,14 @@
 
 using namespace std;
 
-PageTable::PageTable(int proc_id) {
+PageTable::PageTable(int proc_id, int superpage_size) {
     process_id = proc_id;
     page_faults = 0;
     page_hits = 0;
+    superpage_pages = superpage_size > 1 ? superpage_size : 0;
+    tlb = nullptr;
+    promotions = 0;
+    demotions = 0;
     pthread_mutex_init(&table_mutex, nullptr);
 }
 
@@ -40,22 +44,40 @@ void PageTable::add_entry(int page_id, int frame_id) {
     entry.accessed = true;
     entry.protection = 0x7;  // RWX
     
+    auto it = entries.find(page_id);
+    bool was_valid = (it != entries.end() && it->second.valid);
+    if (was_valid && it->second.frame_id != frame_id) {
+        // Remapped to another frame - run is no longer contiguous
+        page_unmapped_locked(page_id);
+        was_valid = false;
+    }
+    
     entries[page_id] = entry;
+    if (!was_valid) {
+        page_mapped_locked(page_id);
+    }
     
     pthread_mutex_unlock(&table_mutex);
 }
 
 void PageTable::remove_entry(int page_id) {
     pthread_mutex_lock(&table_mutex);
-    entries.erase(page_id);
+    auto it = entries.find(page_id);
+    if (it != entries.end()) {
+        if (it->second.valid) {
+            page_unmapped_locked(page_id);
+        }
+        entries.erase(it);
+    }
     pthread_mutex_unlock(&table_mutex);
 }
 
 void PageTable::invalidate_entry(int page_id) {
     pthread_mutex_lock(&table_mutex);
     auto it = entries.find(page_id);
-    if (it != entries.end()) {
+    if (it != entries.end() && it->second.valid) {
         it->second.valid = false;
+        page_unmapped_locked(page_id);
     }
     pthread_mutex_unlock(&table_mutex);
 }
@@ -110,3 +132,106 @@ int PageTable::get_entry_count() {
     pthread_mutex_unlock(&table_mutex);
     return count;
 }
+
+// ========== Superpages ==========
+
+void PageTable::attach_tlb(TLB* t) {
+    pthread_mutex_lock(&table_mutex);
+    tlb = t;
+    pthread_mutex_unlock(&table_mutex);
+}
+
+void PageTable::page_mapped_locked(int page_id) {
+    if (superpage_pages == 0 || page_id < 0) return;
+    
+    int region = page_id / superpage_pages;
+    SuperpageRegion& r = regions[region];  // Value-initialized on first use
+    r.populated++;
+    if (r.populated == superpage_pages && !r.promoted) {
+        try_promote_locked(region);
+    }
+}
+
+void PageTable::page_unmapped_locked(int page_id) {
+    if (superpage_pages == 0 || page_id < 0) return;
+    
+    int region = page_id / superpage_pages;
+    auto it = regions.find(region);
+    if (it == regions.end()) return;
+    
+    if (it->second.promoted) {
+        demote_locked(region);
+    }
+    if (--it->second.populated <= 0) {
+        regions.erase(it);
+    }
+}
+
+bool PageTable::try_promote_locked(int region) {
+    int first_page = region * superpage_pages;
+    auto first = entries.find(first_page);
+    if (first == entries.end()) return false;
+    
+    // Frames must be contiguous and the run aligned to the superpage size
+    int frame_base = first->second.frame_id;
+    if (frame_base < 0 || frame_base % superpage_pages != 0) return false;
+    
+    for (int i = 1; i < superpage_pages; i++) {
+        auto it = entries.find(first_page + i);
+        if (it == entries.end() || !it->second.valid || it->second.frame_id != frame_base + i) {
+            return false;
+        }
+    }
+    
+    SuperpageRegion& r = regions[region];
+    r.promoted = true;
+    r.frame_base = frame_base;
+    promotions++;
+    
+    // One TLB entry now covers the run
+    if (tlb && tlb->get_superpage_size() == superpage_pages) {
+        tlb->insert_superpage(process_id, region, frame_base);
+    }
+    return true;
+}
+
+void PageTable::demote_locked(int region) {
+    SuperpageRegion& r = regions[region];
+    r.promoted = false;
+    demotions++;
+    
+    // Drop the large mapping; remaining base pages refill individually
+    if (tlb) {
+        tlb->invalidate_superpage(process_id, region);
+    }
+}
+
+bool PageTable::is_superpage_mapped(int page_id) {
+    int region, frame_base;
+    return get_superpage_mapping(page_id, region, frame_base);
+}
+
+bool PageTable::get_superpage_mapping(int page_id, int& region, int& frame_base) {
+    if (superpage_pages == 0 || page_id < 0) return false;
+    
+    pthread_mutex_lock(&table_mutex);
+    bool mapped = false;
+    auto it = regions.find(page_id / superpage_pages);
+    if (it != regions.end() && it->second.promoted) {
+        region = it->first;
+        frame_base = it->second.frame_base;
+        mapped = true;
+    }
+    pthread_mutex_unlock(&table_mutex);
+    return mapped;
+}
+
+int PageTable::get_superpage_count() {
+    pthread_mutex_lock(&table_mutex);
+    int count = 0;
+    for (const auto& pair : regions) {
+        if (pair.second.promoted) count++;
+    }
+    pthread_mutex_unlock(&table_mutex);
+    return count;
+}
@@ -3,6 +3,7 @@
 
 #include "Page.h"
 #include "PageFrame.h"
+#include "TLB.h"
 #include <vector>
 #include <unordered_map>
 #include <pthread.h>
@@ -19,6 +20,16 @@ struct PageTableEntry {
     int protection;  // Read/Write/Execute bits
 };
 
+// Superpage bookkeeping for one aligned run of superpage_pages base pages.
+// A run is promoted once every page is mapped and the frames are contiguous
+// and aligned, and its superpage entry goes into the attached TLB; it is
+// demoted (and the entry shot down) as soon as any page in it is removed.
+struct SuperpageRegion {
+    int populated;      // Valid base pages in the run
+    int frame_base;     // First frame while promoted
+    bool promoted;
+};
+
 class PageTable {
 private:
     int process_id;  // Flight ID
@@ -29,8 +40,22 @@ private:
     int page_faults;
     int page_hits;
     
+    // Superpages (superpage_pages == 0 disables promotion)
+    int superpage_pages;
+    unordered_map<int, SuperpageRegion> regions;
+    TLB* tlb;           // Filled on promotion, shot down on demotion; may be null
+    int promotions;
+    int demotions;
+    
+    // Region bookkeeping (caller holds table_mutex)
+    void page_mapped_locked(int page_id);
+    void page_unmapped_locked(int page_id);
+    bool try_promote_locked(int region);
+    void demote_locked(int region);
+    
 public:
-    PageTable(int proc_id);
+    // superpage_size 0 disables promotion; it must match the attached TLB's
+    PageTable(int proc_id, int superpage_size = TLB::DEFAULT_SUPERPAGE_PAGES);
     ~PageTable();
     
     // Lookup page in table
@@ -57,6 +82,16 @@ public:
     vector<int> get_valid_pages();
     int get_entry_count();
     
+    // Superpages
+    void attach_tlb(TLB* t);
+    int get_superpage_size() const { return superpage_pages; }
+    bool is_superpage_mapped(int page_id);
+    // Returns true and fills region/frame_base if page_id lies in a promoted run
+    bool get_superpage_mapping(int page_id, int& region, int& frame_base);
+    int get_superpage_count();
+    int get_promotions() const { return promotions; }
+    int get_demotions() const { return demotions; }
+    
     int get_process_id() const { return process_id; }
 };
 
@@ -0,0 +1,117 @@
+#include "PageTrace.h"
+#include <sstream>
+
+using namespace std;
+
+static const char* TRACE_HEADER = "# page-trace v1";
+
+static void write_record(ostream& os, const PageTraceRecord& r) {
+    os << r.process_id << ' ' << r.page_id << ' ' << r.time << ' '
+       << (r.is_write ? 'w' : 'r') << '\n';
+}
+
+PageTrace::PageTrace() {
+    enabled = false;
+    records_written = 0;
+    pthread_mutex_init(&trace_mutex, nullptr);
+}
+
+PageTrace::~PageTrace() {
+    close();
+    pthread_mutex_destroy(&trace_mutex);
+}
+
+bool PageTrace::open(const string& path) {
+    pthread_mutex_lock(&trace_mutex);
+
+    if (out.is_open()) {
+        flush_locked();
+        out.close();
+    }
+
+    out.open(path, ios::out | ios::trunc);
+    bool ok = out.is_open();
+    if (ok) {
+        out << TRACE_HEADER << '\n';
+        records_written = 0;
+    }
+    enabled = ok;
+
+    pthread_mutex_unlock(&trace_mutex);
+    return ok;
+}
+
+void PageTrace::close() {
+    pthread_mutex_lock(&trace_mutex);
+
+    enabled = false;
+    if (out.is_open()) {
+        flush_locked();
+        out.close();
+    }
+
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+void PageTrace::flush_locked() {
+    for (const PageTraceRecord& r : buffer) {
+        write_record(out, r);
+    }
+    records_written += buffer.size();
+    buffer.clear();
+    out.flush();
+}
+
+void PageTrace::record(int process_id, int page_id, long long time, bool is_write) {
+    if (!enabled.load(memory_order_relaxed)) return;
+
+    pthread_mutex_lock(&trace_mutex);
+
+    if (out.is_open()) {
+        buffer.push_back(PageTraceRecord{process_id, page_id, time, is_write});
+        if ((int)buffer.size() >= FLUSH_THRESHOLD) {
+            flush_locked();
+        }
+    }
+
+    pthread_mutex_unlock(&trace_mutex);
+}
+
+long long PageTrace::get_records_written() {
+    pthread_mutex_lock(&trace_mutex);
+    long long count = records_written + buffer.size();
+    pthread_mutex_unlock(&trace_mutex);
+    return count;
+}
+
+bool PageTrace::load(const string& path, vector<PageTraceRecord>& records) {
+    ifstream in(path);
+    if (!in.is_open()) return false;
+
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream iss(line);
+        PageTraceRecord r;
+        char mode = 'r';
+        if (!(iss >> r.process_id >> r.page_id >> r.time)) {
+            return false;  // Malformed line
+        }
+        iss >> mode;
+        r.is_write = (mode == 'w' || mode == 'W');
+        records.push_back(r);
+    }
+    return true;
+}
+
+bool PageTrace::save(const string& path, const vector<PageTraceRecord>& records) {
+    ofstream os(path, ios::out | ios::trunc);
+    if (!os.is_open()) return false;
+
+    os << TRACE_HEADER << '\n';
+    for (const PageTraceRecord& r : records) {
+        write_record(os, r);
+    }
+    return os.good();
+}
@@ -0,0 +1,59 @@
+#ifndef PAGE_TRACE_H
+#define PAGE_TRACE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <atomic>
+#include <pthread.h>
+
+using namespace std;
+
+// PageTrace captures page references from the memory access path so the
+// replacement policy can be evaluated offline by replaying them.
+//
+// Trace file format (text, one reference per line):
+//   # page-trace v1
+//   <process_id> <page_id> <time> <r|w>
+// Lines starting with '#' are comments.
+
+struct PageTraceRecord {
+    int process_id;
+    int page_id;
+    long long time;     // Simulation time of the access
+    bool is_write;
+};
+
+class PageTrace {
+private:
+    static constexpr int FLUSH_THRESHOLD = 4096;  // Records buffered before write
+
+    atomic<bool> enabled;
+    vector<PageTraceRecord> buffer;
+    ofstream out;
+    long long records_written;
+
+    pthread_mutex_t trace_mutex;
+
+    void flush_locked();
+
+public:
+    PageTrace();
+    ~PageTrace();
+
+    // Start capturing to file (truncates)
+    bool open(const string& path);
+    void close();
+    bool is_enabled() const { return enabled.load(memory_order_relaxed); }
+
+    // Capture hook - no-op unless a trace file is open
+    void record(int process_id, int page_id, long long time, bool is_write);
+
+    long long get_records_written();
+
+    // Offline helpers
+    static bool load(const string& path, vector<PageTraceRecord>& records);
+    static bool save(const string& path, const vector<PageTraceRecord>& records);
+};
+
+#endif // PAGE_TRACE_H
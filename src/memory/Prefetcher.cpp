@@ -3,9 +3,23 @@
 
 using namespace std;
 
+// Process id used for the shared (cross-flight) order-1 model
+static const int SHARED_CONTEXT = -1;
+
 Prefetcher::Prefetcher() {
+    table.assign(TABLE_SETS * TABLE_WAYS, TransitionEntry{});
+    contexts.assign(CONTEXT_SLOTS, ProcessContext{});
+    table_clock = 0;
+
     successful_prefetches = 0;
     failed_prefetches = 0;
+
+    demand_accesses = 0;
+    issued_prefetches = 0;
+    useful_prefetches = 0;
+    expired_prefetches = 0;
+    total_lead = 0;
+
     pthread_mutex_init(&prefetch_mutex, nullptr);
 }
 
@@ -13,79 +27,270 @@ Prefetcher::~Prefetcher() {
     pthread_mutex_destroy(&prefetch_mutex);
 }
 
+uint64_t Prefetcher::hash_context(int process_id, const int* history, int order) {
+    // FNV-1a over (process, order, pages); never returns 0 (empty tag)
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ULL;
+    };
+    mix((uint32_t)process_id);
+    mix((uint64_t)order);
+    for (int i = 0; i < order; i++) {
+        mix((uint32_t)history[i]);
+    }
+    return h == 0 ? 1 : h;
+}
+
+Prefetcher::TransitionEntry* Prefetcher::find_entry(uint64_t tag) {
+    TransitionEntry* set = &table[(tag % TABLE_SETS) * TABLE_WAYS];
+    for (int w = 0; w < TABLE_WAYS; w++) {
+        if (set[w].tag == tag) {
+            set[w].last_use = ++table_clock;
+            return &set[w];
+        }
+    }
+    return nullptr;
+}
+
+Prefetcher::TransitionEntry* Prefetcher::find_or_insert_entry(uint64_t tag) {
+    TransitionEntry* set = &table[(tag % TABLE_SETS) * TABLE_WAYS];
+    TransitionEntry* victim = &set[0];
+
+    for (int w = 0; w < TABLE_WAYS; w++) {
+        if (set[w].tag == tag) {
+            set[w].last_use = ++table_clock;
+            return &set[w];
+        }
+        // Prefer empty ways, then least recently used
+        if (set[w].tag == 0) {
+            if (victim->tag != 0) victim = &set[w];
+        } else if (victim->tag != 0 && set[w].last_use < victim->last_use) {
+            victim = &set[w];
+        }
+    }
+
+    victim->tag = tag;
+    victim->last_use = ++table_clock;
+    for (int s = 0; s < SUCCESSORS; s++) {
+        victim->successors[s] = -1;
+        victim->counts[s] = 0;
+    }
+    return victim;
+}
+
+void Prefetcher::record_transition(uint64_t tag, int next_page) {
+    TransitionEntry* entry = find_or_insert_entry(tag);
+
+    int weakest = 0;
+    for (int s = 0; s < SUCCESSORS; s++) {
+        if (entry->successors[s] == next_page) {
+            if (++entry->counts[s] > MAX_COUNT) {
+                // Age all counts so old patterns fade
+                for (int i = 0; i < SUCCESSORS; i++) {
+                    entry->counts[i] >>= 1;
+                }
+            }
+            return;
+        }
+        if (entry->counts[s] < entry->counts[weakest]) {
+            weakest = s;
+        }
+    }
+
+    entry->successors[weakest] = next_page;
+    entry->counts[weakest] = 1;
+}
+
+void Prefetcher::append_predictions(TransitionEntry* entry, vector<int>& predictions) {
+    if (entry == nullptr) return;
+
+    int total = 0;
+    for (int s = 0; s < SUCCESSORS; s++) {
+        total += entry->counts[s];
+    }
+    if (total == 0) return;
+
+    // At most SUCCESSORS entries: pick in descending count without sorting
+    bool taken[SUCCESSORS] = {};
+    while ((int)predictions.size() < MAX_PREDICTIONS) {
+        int best = -1;
+        for (int s = 0; s < SUCCESSORS; s++) {
+            if (taken[s] || entry->counts[s] == 0) continue;
+            if (best < 0 || entry->counts[s] > entry->counts[best]) best = s;
+        }
+        if (best < 0) break;
+        taken[best] = true;
+
+        int confidence = (entry->counts[best] * 100) / total;
+        if (confidence < MIN_CONFIDENCE) break;
+
+        int page = entry->successors[best];
+        if (find(predictions.begin(), predictions.end(), page) == predictions.end()) {
+            predictions.push_back(page);
+        }
+    }
+}
+
+Prefetcher::ProcessContext* Prefetcher::get_context(int process_id, bool create) {
+    ProcessContext* ctx = &contexts[(uint32_t)process_id % CONTEXT_SLOTS];
+    if (ctx->in_use && ctx->process_id == process_id) {
+        return ctx;
+    }
+    if (!create) return nullptr;
+
+    // Slot collision: the previous owner's context is discarded
+    if (ctx->in_use) {
+        for (int i = 0; i < OUTSTANDING_SLOTS; i++) {
+            if (ctx->outstanding[i].valid) expired_prefetches++;
+        }
+    }
+
+    *ctx = ProcessContext{};
+    ctx->process_id = process_id;
+    ctx->in_use = true;
+    return ctx;
+}
+
 void Prefetcher::record_access(int process_id, int page_id) {
     pthread_mutex_lock(&prefetch_mutex);
-    
-    // Update history
-    auto& history = process_history[process_id];
-    
-    // Record transition from previous page
-    if (!history.empty()) {
-        int prev_page = history.back();
-        transitions[prev_page][page_id]++;
-    }
-    
-    history.push_back(page_id);
-    
-    // Keep history bounded
-    if ((int)history.size() > PATTERN_LENGTH * 2) {
-        history.erase(history.begin());
-    }
-    
+
+    ProcessContext* ctx = get_context(process_id, true);
+    ctx->access_tick++;
+    demand_accesses++;
+
+    // Was this page prefetched for this process?
+    for (int i = 0; i < OUTSTANDING_SLOTS; i++) {
+        OutstandingPrefetch& op = ctx->outstanding[i];
+        if (op.valid && op.page_id == page_id) {
+            useful_prefetches++;
+            total_lead += ctx->access_tick - op.issue_tick;
+            op.valid = false;
+            break;
+        }
+    }
+
+    if (ctx->history_length > 0) {
+        int prev_page = ctx->history[0];
+
+        // Stride detector
+        int stride = page_id - prev_page;
+        if (stride != 0 && stride == ctx->last_stride) {
+            ctx->stride_confidence = min(ctx->stride_confidence + 1, STRIDE_CONFIRMATIONS + 1);
+        } else {
+            ctx->stride_confidence = 0;
+        }
+        ctx->last_stride = stride;
+
+        // Order-1..k per-process contexts plus shared order-1
+        for (int order = 1; order <= ctx->history_length; order++) {
+            record_transition(hash_context(process_id, ctx->history, order), page_id);
+        }
+        record_transition(hash_context(SHARED_CONTEXT, ctx->history, 1), page_id);
+    }
+
+    // Shift history
+    for (int i = MARKOV_ORDER - 1; i > 0; i--) {
+        ctx->history[i] = ctx->history[i - 1];
+    }
+    ctx->history[0] = page_id;
+    ctx->history_length = min(ctx->history_length + 1, MARKOV_ORDER);
+
     pthread_mutex_unlock(&prefetch_mutex);
 }
 
-vector<int> Prefetcher::predict_next(int process_id, int current_page) {
-    vector<int> predictions;
-    
-    pthread_mutex_lock(&prefetch_mutex);
-    
-    auto it = transitions.find(current_page);
-    if (it != transitions.end()) {
-        // Find most likely next pages
-        vector<pair<int, int>> candidates;
-        int total = 0;
-        
-        for (const auto& p : it->second) {
-            candidates.push_back(p);
-            total += p.second;
-        }
-        
-        // Sort by frequency
-        sort(candidates.begin(), candidates.end(),
-             [](const pair<int,int>& a, const pair<int,int>& b) {
-                 return a.second > b.second;
-             });
-        
-        // Return predictions above confidence threshold
-        for (const auto& c : candidates) {
-            int confidence = (c.second * 100) / max(1, total);
-            if (confidence >= MIN_CONFIDENCE) {
-                predictions.push_back(c.first);
+void Prefetcher::predict_locked(ProcessContext* ctx, int process_id, int current_page,
+                                vector<int>& predictions) {
+    bool has_context = ctx != nullptr && ctx->history_length > 0 &&
+                       ctx->history[0] == current_page;
+
+    // 1. Stride / sequential
+    if (has_context && ctx->stride_confidence >= STRIDE_CONFIRMATIONS) {
+        int degree = (ctx->last_stride == 1) ? SEQUENTIAL_DEGREE : STRIDE_DEGREE;
+        for (int d = 1; d <= degree && (int)predictions.size() < MAX_PREDICTIONS; d++) {
+            int page = current_page + d * ctx->last_stride;
+            if (page >= 0) predictions.push_back(page);
+        }
+        return;
+    }
+
+    // 2. Longest matching per-process context
+    if (has_context) {
+        for (int order = ctx->history_length; order >= 1; order--) {
+            TransitionEntry* entry = find_entry(hash_context(process_id, ctx->history, order));
+            if (entry != nullptr) {
+                append_predictions(entry, predictions);
+                if (!predictions.empty()) return;
             }
-            if (predictions.size() >= 3) break;  // Max 3 prefetches
         }
     }
-    
+
+    // 3. Shared order-1 fallback
+    append_predictions(find_entry(hash_context(SHARED_CONTEXT, &current_page, 1)), predictions);
+}
+
+vector<int> Prefetcher::predict_next(int process_id, int current_page) {
+    vector<int> predictions;
+
+    pthread_mutex_lock(&prefetch_mutex);
+    predict_locked(get_context(process_id, false), process_id, current_page, predictions);
     pthread_mutex_unlock(&prefetch_mutex);
+
     return predictions;
 }
 
 vector<int> Prefetcher::get_prefetch_candidates(int process_id) {
-    pthread_mutex_lock(&prefetch_mutex);
-    
     vector<int> candidates;
-    auto it = process_history.find(process_id);
-    if (it != process_history.end() && !it->second.empty()) {
-        int current = it->second.back();
-        pthread_mutex_unlock(&prefetch_mutex);
-        return predict_next(process_id, current);
+
+    pthread_mutex_lock(&prefetch_mutex);
+
+    ProcessContext* ctx = get_context(process_id, false);
+    if (ctx != nullptr && ctx->history_length > 0) {
+        vector<int> predictions;
+        predict_locked(ctx, process_id, ctx->history[0], predictions);
+
+        // Skip pages already in flight for this process
+        for (int page : predictions) {
+            bool pending = false;
+            for (int i = 0; i < OUTSTANDING_SLOTS; i++) {
+                if (ctx->outstanding[i].valid && ctx->outstanding[i].page_id == page) {
+                    pending = true;
+                    break;
+                }
+            }
+            if (!pending) candidates.push_back(page);
+        }
+
+        // Track issued prefetches for accuracy/timeliness
+        for (int page : candidates) {
+            OutstandingPrefetch& slot = ctx->outstanding[ctx->outstanding_next];
+            if (slot.valid) expired_prefetches++;
+            slot.page_id = page;
+            slot.issue_tick = ctx->access_tick;
+            slot.valid = true;
+            ctx->outstanding_next = (ctx->outstanding_next + 1) % OUTSTANDING_SLOTS;
+            issued_prefetches++;
+        }
     }
-    
+
     pthread_mutex_unlock(&prefetch_mutex);
     return candidates;
 }
 
+void Prefetcher::forget_process(int process_id) {
+    pthread_mutex_lock(&prefetch_mutex);
+
+    ProcessContext* ctx = get_context(process_id, false);
+    if (ctx != nullptr) {
+        for (int i = 0; i < OUTSTANDING_SLOTS; i++) {
+            if (ctx->outstanding[i].valid) expired_prefetches++;
+        }
+        *ctx = ProcessContext{};
+    }
+
+    pthread_mutex_unlock(&prefetch_mutex);
+}
+
 void Prefetcher::record_prefetch_hit() {
     pthread_mutex_lock(&prefetch_mutex);
     successful_prefetches++;
@@ -100,6 +305,26 @@ void Prefetcher::record_prefetch_miss() {
 
 double Prefetcher::get_prefetch_accuracy() const {
     int total = successful_prefetches + failed_prefetches;
-    if (total == 0) return 0.0;
+    if (total == 0) {
+        // No external feedback - use self-measured accuracy
+        if (issued_prefetches == 0) return 0.0;
+        return (double)useful_prefetches / issued_prefetches;
+    }
     return (double)successful_prefetches / total;
 }
+
+PrefetchMetrics Prefetcher::get_metrics() {
+    pthread_mutex_lock(&prefetch_mutex);
+
+    PrefetchMetrics m;
+    m.demand_accesses = demand_accesses;
+    m.issued = issued_prefetches;
+    m.useful = useful_prefetches;
+    m.expired = expired_prefetches;
+    m.accuracy = issued_prefetches > 0 ? (double)useful_prefetches / issued_prefetches : 0.0;
+    m.coverage = demand_accesses > 0 ? (double)useful_prefetches / demand_accesses : 0.0;
+    m.average_lead = useful_prefetches > 0 ? (double)total_lead / useful_prefetches : 0.0;
+
+    pthread_mutex_unlock(&prefetch_mutex);
+    return m;
+}
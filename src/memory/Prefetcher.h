@@ -3,57 +3,129 @@
 
 #include "Page.h"
 #include <vector>
-#include <unordered_map>
+#include <cstdint>
 #include <pthread.h>
 
 using namespace std;
 
 // Prefetcher implements predictive prefetching using pattern detection
-// Tracks access patterns and prefetches likely next pages
+// Combines three predictors, consulted in order:
+//   1. Stride/sequential detector per process (page + k*stride)
+//   2. Order-k Markov model per process (context = last k pages)
+//   3. Shared order-1 Markov model (learned across all flights)
+// All state lives in fixed-size tables, so memory does not grow with the
+// number of flights or distinct pages seen.
 
-struct AccessPattern {
-    vector<int> sequence;   // Recent page access sequence
-    int next_predicted;     // Predicted next page
-    int confidence;         // Prediction confidence (0-100)
+// Prefetch quality metrics
+struct PrefetchMetrics {
+    long long demand_accesses;  // Pages accessed via record_access
+    long long issued;           // Pages handed out by get_prefetch_candidates
+    long long useful;           // Issued pages later demanded by the same process
+    long long expired;          // Issued pages dropped before being demanded
+    double accuracy;            // useful / issued
+    double coverage;            // useful / demand_accesses
+    double average_lead;        // Mean accesses between issue and first use
 };
 
 class Prefetcher {
 private:
-    static constexpr int PATTERN_LENGTH = 4;   // History length to track
-    static constexpr int MIN_CONFIDENCE = 60;  // Min confidence to prefetch
-    
-    // Markov-like transition tracking: current -> next -> count
-    unordered_map<int, unordered_map<int, int>> transitions;
-    
-    // Recent access history per process
-    unordered_map<int, vector<int>> process_history;
-    
+    static constexpr int MARKOV_ORDER = 3;        // Longest context length (k)
+    static constexpr int MIN_CONFIDENCE = 60;     // Min confidence to prefetch
+    static constexpr int MAX_PREDICTIONS = 3;     // Max pages per prediction
+
+    // Transition table: set-associative, LRU within each set
+    static constexpr int TABLE_SETS = 1024;
+    static constexpr int TABLE_WAYS = 4;
+    static constexpr int SUCCESSORS = 4;          // Successors tracked per context
+    static constexpr int MAX_COUNT = 255;         // Counts halve on saturation
+
+    // Per-process contexts: direct-mapped by process_id
+    static constexpr int CONTEXT_SLOTS = 256;
+    static constexpr int OUTSTANDING_SLOTS = 8;   // Issued-but-unused prefetches
+
+    // Stride detector
+    static constexpr int STRIDE_CONFIRMATIONS = 2;  // Repeats before trusting stride
+    static constexpr int STRIDE_DEGREE = 2;          // Pages ahead for a stride
+    static constexpr int SEQUENTIAL_DEGREE = 3;      // Pages ahead for stride +1
+
+    struct TransitionEntry {
+        uint64_t tag;                 // Context hash (0 = empty)
+        uint32_t last_use;            // LRU stamp within set
+        int successors[SUCCESSORS];
+        int counts[SUCCESSORS];
+    };
+
+    struct OutstandingPrefetch {
+        int page_id;
+        long long issue_tick;
+        bool valid;
+    };
+
+    struct ProcessContext {
+        int process_id;
+        bool in_use;
+        int history[MARKOV_ORDER];    // history[0] = most recent
+        int history_length;
+        int last_stride;
+        int stride_confidence;
+        long long access_tick;        // Accesses by this process
+        OutstandingPrefetch outstanding[OUTSTANDING_SLOTS];
+        int outstanding_next;
+    };
+
+    vector<TransitionEntry> table;
+    vector<ProcessContext> contexts;
+    uint32_t table_clock;
+
     pthread_mutex_t prefetch_mutex;
-    
-    // Statistics
+
+    // Statistics (external feedback)
     int successful_prefetches;
     int failed_prefetches;
-    
+
+    // Statistics (self-measured)
+    long long demand_accesses;
+    long long issued_prefetches;
+    long long useful_prefetches;
+    long long expired_prefetches;
+    long long total_lead;
+
+    // Context hashing and table access (caller holds prefetch_mutex)
+    static uint64_t hash_context(int process_id, const int* history, int order);
+    TransitionEntry* find_entry(uint64_t tag);
+    TransitionEntry* find_or_insert_entry(uint64_t tag);
+    void record_transition(uint64_t tag, int next_page);
+    void append_predictions(TransitionEntry* entry, vector<int>& predictions);
+
+    ProcessContext* get_context(int process_id, bool create);
+    void predict_locked(ProcessContext* ctx, int process_id, int current_page,
+                        vector<int>& predictions);
+
 public:
     Prefetcher();
     ~Prefetcher();
-    
+
     // Record page access
     void record_access(int process_id, int page_id);
-    
-    // Predict next page(s) to prefetch
+
+    // Predict next page(s) to prefetch (query only)
     vector<int> predict_next(int process_id, int current_page);
-    
-    // Get prefetch candidates based on patterns
+
+    // Get prefetch candidates based on patterns; candidates are counted as
+    // issued prefetches for the accuracy/coverage/timeliness metrics
     vector<int> get_prefetch_candidates(int process_id);
-    
+
+    // Drop per-process context when a flight finishes
+    void forget_process(int process_id);
+
     // Record prefetch result
     void record_prefetch_hit();
     void record_prefetch_miss();
-    
+
     // Statistics
     double get_prefetch_accuracy() const;
     int get_successful_prefetches() const { return successful_prefetches; }
+    PrefetchMetrics get_metrics();
 };
 
 #endif // PREFETCHER_H
@@ -2,10 +2,13 @@
 
 using namespace std;
 
-TLB::TLB(int cap) {
+TLB::TLB(int cap, int superpage_size) {
     capacity = cap;
+    superpage_pages = superpage_size > 0 ? superpage_size : 1;
     hits = 0;
     misses = 0;
+    superpage_hits = 0;
+    superpage_entries = 0;
     pthread_mutex_init(&tlb_mutex, nullptr);
 }
 
@@ -13,94 +16,145 @@ TLB::~TLB() {
     pthread_mutex_destroy(&tlb_mutex);
 }
 
-int TLB::make_key(int proc_id, int page_id) {
-    // Simple key combining process and page
-    return (proc_id << 16) | (page_id & 0xFFFF);
+uint64_t TLB::make_key(int proc_id, int id, bool superpage) const {
+    // Process in the high bits, superpage flag, then page/region id
+    return ((uint64_t)(uint32_t)proc_id << 33) |
+           ((uint64_t)(superpage ? 1 : 0) << 32) |
+           (uint32_t)id;
 }
 
-int TLB::lookup(int proc_id, int page_id) {
-    pthread_mutex_lock(&tlb_mutex);
-    
-    int key = make_key(proc_id, page_id);
-    auto it = cache_map.find(key);
-    
-    if (it != cache_map.end() && it->second->valid) {
-        hits++;
-        
-        // Move to front (most recently used)
-        TLBEntry entry = *(it->second);
-        lru_list.erase(it->second);
-        lru_list.push_front(entry);
-        cache_map[key] = lru_list.begin();
-        
-        pthread_mutex_unlock(&tlb_mutex);
-        return entry.frame_id;
+void TLB::erase_locked(unordered_map<uint64_t, list<TLBEntry>::iterator>::iterator it) {
+    if (it->second->is_superpage && it->second->valid) {
+        superpage_entries--;
     }
-    
-    misses++;
-    pthread_mutex_unlock(&tlb_mutex);
-    return -1;
+    lru_list.erase(it->second);
+    cache_map.erase(it);
 }
 
-void TLB::insert(int proc_id, int page_id, int frame_id) {
-    pthread_mutex_lock(&tlb_mutex);
-    
-    int key = make_key(proc_id, page_id);
-    
+void TLB::insert_locked(const TLBEntry& entry) {
+    uint64_t key = make_key(entry.process_id, entry.page_id, entry.is_superpage);
+
     // If already exists, update
     auto it = cache_map.find(key);
     if (it != cache_map.end()) {
-        lru_list.erase(it->second);
-        cache_map.erase(it);
+        erase_locked(it);
     }
-    
+
     // Evict LRU if full
     if ((int)lru_list.size() >= capacity) {
         TLBEntry& lru = lru_list.back();
-        int lru_key = make_key(lru.process_id, lru.page_id);
-        cache_map.erase(lru_key);
-        lru_list.pop_back();
+        erase_locked(cache_map.find(make_key(lru.process_id, lru.page_id, lru.is_superpage)));
     }
-    
-    // Insert new entry at front
-    TLBEntry entry;
-    entry.page_id = page_id;
-    entry.frame_id = frame_id;
-    entry.process_id = proc_id;
-    entry.valid = true;
-    
+
     lru_list.push_front(entry);
     cache_map[key] = lru_list.begin();
-    
+    if (entry.is_superpage) {
+        superpage_entries++;
+    }
+}
+
+int TLB::lookup(int proc_id, int page_id) {
+    pthread_mutex_lock(&tlb_mutex);
+
+    auto it = cache_map.find(make_key(proc_id, page_id, false));
+    int frame = -1;
+
+    if (it != cache_map.end() && it->second->valid) {
+        frame = it->second->frame_id;
+    } else if (superpage_entries > 0) {
+        // Try a superpage entry covering this page
+        it = cache_map.find(make_key(proc_id, page_id / superpage_pages, true));
+        if (it != cache_map.end() && it->second->valid) {
+            frame = it->second->frame_id + (page_id % superpage_pages);
+            superpage_hits++;
+        }
+    }
+
+    if (frame >= 0) {
+        hits++;
+        // Move to front (most recently used)
+        lru_list.splice(lru_list.begin(), lru_list, it->second);
+    } else {
+        misses++;
+    }
+
+    pthread_mutex_unlock(&tlb_mutex);
+    return frame;
+}
+
+void TLB::insert(int proc_id, int page_id, int frame_id) {
+    pthread_mutex_lock(&tlb_mutex);
+    insert_locked(TLBEntry{page_id, frame_id, proc_id, true, false});
+    pthread_mutex_unlock(&tlb_mutex);
+}
+
+void TLB::insert_superpage(int proc_id, int region, int frame_base) {
+    pthread_mutex_lock(&tlb_mutex);
+
+    // Base entries inside the region are now redundant - free their slots
+    // (walk the cached entries - far fewer than pages in the run)
+    auto it = lru_list.begin();
+    while (it != lru_list.end()) {
+        if (!it->is_superpage && it->process_id == proc_id &&
+            it->page_id / superpage_pages == region) {
+            cache_map.erase(make_key(proc_id, it->page_id, false));
+            it = lru_list.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    insert_locked(TLBEntry{region, frame_base, proc_id, true, true});
+
     pthread_mutex_unlock(&tlb_mutex);
 }
 
 void TLB::invalidate(int proc_id, int page_id) {
     pthread_mutex_lock(&tlb_mutex);
-    
-    int key = make_key(proc_id, page_id);
-    auto it = cache_map.find(key);
+
+    auto it = cache_map.find(make_key(proc_id, page_id, false));
     if (it != cache_map.end()) {
         it->second->valid = false;
     }
-    
+
+    // A superpage covering this page no longer maps the whole run
+    if (superpage_entries > 0) {
+        it = cache_map.find(make_key(proc_id, page_id / superpage_pages, true));
+        if (it != cache_map.end()) {
+            erase_locked(it);
+        }
+    }
+
+    pthread_mutex_unlock(&tlb_mutex);
+}
+
+void TLB::invalidate_superpage(int proc_id, int region) {
+    pthread_mutex_lock(&tlb_mutex);
+
+    auto it = cache_map.find(make_key(proc_id, region, true));
+    if (it != cache_map.end()) {
+        erase_locked(it);
+    }
+
     pthread_mutex_unlock(&tlb_mutex);
 }
 
 void TLB::flush_process(int proc_id) {
     pthread_mutex_lock(&tlb_mutex);
-    
+
     auto it = lru_list.begin();
     while (it != lru_list.end()) {
         if (it->process_id == proc_id) {
-            int key = make_key(it->process_id, it->page_id);
-            cache_map.erase(key);
+            if (it->is_superpage && it->valid) {
+                superpage_entries--;
+            }
+            cache_map.erase(make_key(it->process_id, it->page_id, it->is_superpage));
             it = lru_list.erase(it);
         } else {
             ++it;
         }
     }
-    
+
     pthread_mutex_unlock(&tlb_mutex);
 }
 
@@ -108,6 +162,7 @@ void TLB::flush_all() {
     pthread_mutex_lock(&tlb_mutex);
     cache_map.clear();
     lru_list.clear();
+    superpage_entries = 0;
     pthread_mutex_unlock(&tlb_mutex);
 }
 
@@ -116,3 +171,17 @@ double TLB::get_hit_rate() const {
     if (total == 0) return 0.0;
     return (double)hits / total;
 }
+
+long long TLB::get_reach_pages() {
+    pthread_mutex_lock(&tlb_mutex);
+
+    long long reach = 0;
+    for (const TLBEntry& entry : lru_list) {
+        if (entry.valid) {
+            reach += entry.is_superpage ? superpage_pages : 1;
+        }
+    }
+
+    pthread_mutex_unlock(&tlb_mutex);
+    return reach;
+}
@@ -3,58 +3,85 @@
 
 #include <unordered_map>
 #include <list>
+#include <cstdint>
 #include <pthread.h>
 
 using namespace std;
 
 // Translation Lookaside Buffer - fast page table cache
 // Uses LRU replacement policy
+// Besides base-page entries, an entry may map a whole superpage: an aligned
+// run of superpage_pages base pages backed by contiguous frames. One such
+// entry covers the run, so large flight data (passenger manifests) costs a
+// single TLB slot instead of hundreds.
 
 struct TLBEntry {
-    int page_id;
-    int frame_id;
+    int page_id;        // Base page, or superpage region for superpage entries
+    int frame_id;       // Frame, or first frame of the run for superpage entries
     int process_id;
     bool valid;
+    bool is_superpage;
 };
 
 class TLB {
+public:
+    // Base pages per superpage (2 MiB of 4 KiB pages), shared with PageTable
+    static constexpr int DEFAULT_SUPERPAGE_PAGES = 512;
+
 private:
     int capacity;
-    unordered_map<int, list<TLBEntry>::iterator> cache_map;
+    int superpage_pages;    // Base pages per superpage
+    unordered_map<uint64_t, list<TLBEntry>::iterator> cache_map;
     list<TLBEntry> lru_list;  // Front = most recent, Back = least recent
-    
+
     pthread_mutex_t tlb_mutex;
-    
+
     // Statistics
     int hits;
     int misses;
-    
-    // Make key from process_id and page_id
-    int make_key(int proc_id, int page_id);
-    
+    int superpage_hits;
+    int superpage_entries;  // Valid superpage entries currently cached
+
+    // Make key from process_id and page_id (or superpage region)
+    uint64_t make_key(int proc_id, int id, bool superpage) const;
+
+    // Insert entry at MRU position (caller holds tlb_mutex)
+    void insert_locked(const TLBEntry& entry);
+    void erase_locked(unordered_map<uint64_t, list<TLBEntry>::iterator>::iterator it);
+
 public:
-    TLB(int cap = 64);  // Default 64 entries
+    TLB(int cap = 64, int superpage_size = DEFAULT_SUPERPAGE_PAGES);  // Default 64 entries
     ~TLB();
-    
+
     // Lookup - returns frame_id or -1 if miss
     int lookup(int proc_id, int page_id);
-    
+
     // Insert new mapping
     void insert(int proc_id, int page_id, int frame_id);
-    
-    // Invalidate entry
+
+    // Insert superpage mapping covering region (pages region*size .. +size-1)
+    void insert_superpage(int proc_id, int region, int frame_base);
+
+    // Invalidate entry (also shoots down a covering superpage entry)
     void invalidate(int proc_id, int page_id);
-    
+    void invalidate_superpage(int proc_id, int region);
+
     // Flush all entries for a process
     void flush_process(int proc_id);
-    
+
     // Flush entire TLB
     void flush_all();
-    
+
     // Statistics
     int get_hits() const { return hits; }
     int get_misses() const { return misses; }
     double get_hit_rate() const;
+    int get_superpage_hits() const { return superpage_hits; }
+    int get_superpage_size() const { return superpage_pages; }
+    int get_superpage_entries() const { return superpage_entries; }
+
+    // TLB reach: base pages translatable without a miss
+    long long get_reach_pages();
 };
 
 #endif // TLB_H
@@ -3,64 +3,115 @@
 
 using namespace std;
 
-ThrashingDetector::ThrashingDetector() {
-    recent_accesses.resize(SAMPLE_WINDOW, true);  // Start with all hits
-    current_index = 0;
+ThrashingDetector::ThrashingDetector(const vector<long long>& window_sizes) {
+    for (long long size : window_sizes) {
+        if (size <= 0) continue;
+
+        Window* w = new Window();
+        w->buckets = (int)min<long long>(BUCKETS_PER_WINDOW, size);
+        w->bucket_len = (size + w->buckets - 1) / w->buckets;
+        // A bucket's fault count must fit in COUNT_BITS
+        w->bucket_len = min<long long>(w->bucket_len, (long long)COUNT_MASK);
+        w->size = w->bucket_len * w->buckets;
+        w->slots = new atomic<uint64_t>[w->buckets];
+        for (int i = 0; i < w->buckets; i++) {
+            w->slots[i].store(0);
+        }
+        w->faults.store(0);
+        windows.push_back(w);
+    }
+    sort(windows.begin(), windows.end(),
+         [](const Window* a, const Window* b) { return a->size < b->size; });
+
     total_samples = 0;
+    compulsory_faults = 0;
     is_thrashing = false;
     consecutive_critical = 0;
     pthread_mutex_init(&detector_mutex, nullptr);
 }
 
 ThrashingDetector::~ThrashingDetector() {
+    for (Window* w : windows) {
+        delete[] w->slots;
+        delete w;
+    }
     pthread_mutex_destroy(&detector_mutex);
 }
 
+void ThrashingDetector::record(bool fault) {
+    long long seq = total_samples.fetch_add(1, memory_order_relaxed);
+
+    for (Window* w : windows) {
+        uint64_t epoch = (uint64_t)(seq / w->bucket_len);
+        atomic<uint64_t>& slot = w->slots[epoch % w->buckets];
+
+        // Roll over and count in one CAS, so a fault always lands in the
+        // epoch it was checked against. The window total is raised before
+        // the CAS (and lowered again if it fails), so a concurrent rollover
+        // can never retire a fault that was not yet added.
+        uint64_t current = slot.load(memory_order_acquire);
+        while (true) {
+            uint64_t slot_epoch = current >> COUNT_BITS;
+            if (slot_epoch > epoch) break;  // Straggler: bucket moved on, drop
+            uint64_t next = (slot_epoch < epoch ? epoch << COUNT_BITS : current) + (fault ? 1 : 0);
+            if (next == current) break;     // Hit in the current epoch
+            if (fault) w->faults.fetch_add(1, memory_order_relaxed);
+            if (slot.compare_exchange_weak(current, next, memory_order_acq_rel)) {
+                if (slot_epoch < epoch) {
+                    w->faults.fetch_sub((long long)(current & COUNT_MASK), memory_order_relaxed);
+                }
+                break;
+            }
+            if (fault) w->faults.fetch_sub(1, memory_order_relaxed);
+        }
+    }
+}
+
 void ThrashingDetector::record_hit() {
-    pthread_mutex_lock(&detector_mutex);
-    
-    recent_accesses[current_index] = true;
-    current_index = (current_index + 1) % SAMPLE_WINDOW;
-    total_samples++;
-    
-    pthread_mutex_unlock(&detector_mutex);
+    record(false);
 }
 
 void ThrashingDetector::record_fault() {
-    pthread_mutex_lock(&detector_mutex);
-    
-    recent_accesses[current_index] = false;
-    current_index = (current_index + 1) % SAMPLE_WINDOW;
-    total_samples++;
-    
-    pthread_mutex_unlock(&detector_mutex);
+    record(true);
+}
+
+void ThrashingDetector::record_compulsory_fault() {
+    compulsory_faults.fetch_add(1, memory_order_relaxed);
+}
+
+double ThrashingDetector::window_fault_rate(const Window* w) const {
+    long long samples = total_samples.load(memory_order_relaxed);
+    if (samples == 0) return 0.0;
+
+    // Live buckets are the last `buckets` epochs up to the newest sample
+    long long newest_epoch = (samples - 1) / w->bucket_len;
+    long long oldest_epoch = max(0LL, newest_epoch - w->buckets + 1);
+    long long covered = samples - oldest_epoch * w->bucket_len;
+
+    long long faults = w->faults.load(memory_order_relaxed);
+    double rate = (double)faults / covered;
+    return min(1.0, max(0.0, rate));
 }
 
 double ThrashingDetector::get_current_fault_rate() {
-    pthread_mutex_lock(&detector_mutex);
-    
-    int samples = min(total_samples, SAMPLE_WINDOW);
-    if (samples == 0) {
-        pthread_mutex_unlock(&detector_mutex);
-        return 0.0;
-    }
-    
-    int faults = 0;
-    for (int i = 0; i < samples; i++) {
-        if (!recent_accesses[i]) {
-            faults++;
-        }
-    }
-    
-    pthread_mutex_unlock(&detector_mutex);
-    return (double)faults / samples;
+    return get_fault_rate(0);
+}
+
+double ThrashingDetector::get_fault_rate(int window_index) const {
+    if (window_index < 0 || window_index >= (int)windows.size()) return 0.0;
+    return window_fault_rate(windows[window_index]);
+}
+
+long long ThrashingDetector::get_window_size(int window_index) const {
+    if (window_index < 0 || window_index >= (int)windows.size()) return 0;
+    return windows[window_index]->size;
 }
 
 bool ThrashingDetector::check_thrashing() {
     double fault_rate = get_current_fault_rate();
-    
+
     pthread_mutex_lock(&detector_mutex);
-    
+
     if (fault_rate >= FAULT_RATE_CRITICAL) {
         consecutive_critical++;
         if (consecutive_critical >= 3) {  // 3 consecutive critical readings
@@ -70,15 +121,42 @@ bool ThrashingDetector::check_thrashing() {
         consecutive_critical = 0;
         is_thrashing = false;
     }
-    
+
     bool result = is_thrashing;
     pthread_mutex_unlock(&detector_mutex);
     return result;
 }
 
+PFFSignal ThrashingDetector::get_pff_signal() const {
+    if (windows.empty() || total_samples.load(memory_order_relaxed) == 0) {
+        return PFF_ADMIT;
+    }
+
+    // Short window reacts to bursts; the next window up confirms recovery
+    double short_rate = window_fault_rate(windows[0]);
+    double long_rate = windows.size() > 1 ? window_fault_rate(windows[1]) : short_rate;
+
+    if (is_thrashing.load() || short_rate >= FAULT_RATE_CRITICAL) {
+        return PFF_THROTTLE;
+    }
+    if (short_rate < FAULT_RATE_WARNING && long_rate < FAULT_RATE_CRITICAL) {
+        return PFF_ADMIT;
+    }
+    return PFF_HOLD;
+}
+
+const char* ThrashingDetector::pff_signal_to_string(PFFSignal signal) {
+    switch (signal) {
+        case PFF_ADMIT: return "ADMIT";
+        case PFF_HOLD: return "HOLD";
+        case PFF_THROTTLE: return "THROTTLE";
+        default: return "UNKNOWN";
+    }
+}
+
 int ThrashingDetector::get_recommended_reduction() {
     double fault_rate = get_current_fault_rate();
-    
+
     if (fault_rate >= FAULT_RATE_CRITICAL) {
         // Critical: suspend ~30% of processes
         return 3;
@@ -91,12 +169,17 @@ int ThrashingDetector::get_recommended_reduction() {
 
 void ThrashingDetector::reset() {
     pthread_mutex_lock(&detector_mutex);
-    
-    fill(recent_accesses.begin(), recent_accesses.end(), true);
-    current_index = 0;
+
+    for (Window* w : windows) {
+        for (int i = 0; i < w->buckets; i++) {
+            w->slots[i].store(0);
+        }
+        w->faults.store(0);
+    }
     total_samples = 0;
+    compulsory_faults = 0;
     is_thrashing = false;
     consecutive_critical = 0;
-    
+
     pthread_mutex_unlock(&detector_mutex);
 }
@@ -3,47 +3,89 @@
 
 #include <pthread.h>
 #include <vector>
+#include <atomic>
+#include <cstdint>
 
 using namespace std;
 
 // ThrashingDetector monitors page fault rates to detect thrashing
 // Triggers mitigation when fault rate exceeds threshold
+// Fault rates are tracked over several sliding windows (e.g. the last 100,
+// 10k and 1M accesses). Each window is split into buckets that hold a fault
+// count tagged with the bucket's epoch; a running per-window fault total is
+// adjusted as buckets roll over, so recording an access is a few atomic ops
+// and a fault-rate query is O(1). No lock is taken on the access path.
+// Compulsory (first-touch) faults are counted apart and kept out of the
+// rate: they say a flight is new, not that memory is short.
+
+// Page-fault-frequency admission signal
+enum PFFSignal {
+    PFF_ADMIT,      // Fault rate low - room for more flights
+    PFF_HOLD,       // Between thresholds - keep current load
+    PFF_THROTTLE    // Fault rate high - stop admitting flights
+};
 
 class ThrashingDetector {
 private:
     // Thresholds
     static constexpr double FAULT_RATE_WARNING = 0.15;    // 15% - warning
     static constexpr double FAULT_RATE_CRITICAL = 0.25;   // 25% - thrashing
-    static constexpr int SAMPLE_WINDOW = 100;             // Recent accesses to consider
-    
-    vector<bool> recent_accesses;  // true = hit, false = fault
-    int current_index;
-    int total_samples;
-    
-    bool is_thrashing;
-    int consecutive_critical;
-    
-    pthread_mutex_t detector_mutex;
-    
+    static constexpr int BUCKETS_PER_WINDOW = 100;        // Window granularity (1%)
+    static constexpr int COUNT_BITS = 24;                 // Low bits of a bucket = fault count
+    static constexpr uint64_t COUNT_MASK = (1ULL << COUNT_BITS) - 1;
+
+    struct Window {
+        long long size;           // Accesses covered
+        long long bucket_len;     // Accesses per bucket
+        int buckets;
+        atomic<uint64_t>* slots;  // (epoch << COUNT_BITS) | faults
+        atomic<long long> faults; // Faults across live buckets
+    };
+
+    vector<Window*> windows;       // Ordered smallest to largest
+    atomic<long long> total_samples;
+    atomic<long long> compulsory_faults;
+
+    atomic<bool> is_thrashing;
+    atomic<int> consecutive_critical;
+
+    pthread_mutex_t detector_mutex;  // Control path only (check/reset)
+
+    void record(bool fault);
+    double window_fault_rate(const Window* w) const;
+
 public:
-    ThrashingDetector();
+    ThrashingDetector(const vector<long long>& window_sizes = {100, 10000, 1000000});
     ~ThrashingDetector();
-    
-    // Record access result
+
+    // Record access result (lock-free)
     void record_hit();
     void record_fault();
-    
-    // Get current fault rate (0.0 to 1.0)
+    // First touch of a page - not part of the fault rate
+    void record_compulsory_fault();
+
+    // Get current fault rate (0.0 to 1.0) over the smallest window
     double get_current_fault_rate();
-    
+
+    // Fault rate over a specific window (index into window sizes)
+    double get_fault_rate(int window_index) const;
+    int get_window_count() const { return (int)windows.size(); }
+    long long get_window_size(int window_index) const;
+    long long get_total_samples() const { return total_samples.load(); }
+    long long get_compulsory_faults() const { return compulsory_faults.load(); }
+
     // Check thrashing status
     bool check_thrashing();
-    bool is_in_thrashing_state() const { return is_thrashing; }
-    
+    bool is_in_thrashing_state() const { return is_thrashing.load(); }
+
+    // Page-fault-frequency control signal for flight admission
+    PFFSignal get_pff_signal() const;
+    static const char* pff_signal_to_string(PFFSignal signal);
+
     // Get mitigation recommendations
     int get_recommended_reduction();  // Reduce active processes by this many
-    
-    // Reset detector
+
+    // Reset detector (call while no accesses are being recorded)
     void reset();
 };
 
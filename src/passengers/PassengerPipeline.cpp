@@ -1,121 +1,227 @@
 #include "PassengerPipeline.h"
-#include "../core/Logger.h"
-#include <sstream>
-#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 using namespace std;
 
-PassengerPipeline::PassengerPipeline(int counters, int lanes) {
-    checkin_counters = counters;
-    security_lanes = lanes;
+PassengerPipeline::PassengerPipeline(int counters, int lanes, int fast_counters, int fast_lanes) {
+    int servers[PIPELINE_STAGE_COUNT] = {counters, lanes};
+    int fast[PIPELINE_STAGE_COUNT] = {fast_counters, fast_lanes};
+    double per_group[PIPELINE_STAGE_COUNT] = {CHECKIN_SECONDS_PER_GROUP, SECURITY_SECONDS_PER_GROUP};
+    double per_passenger[PIPELINE_STAGE_COUNT] = {CHECKIN_SECONDS_PER_PASSENGER, SECURITY_SECONDS_PER_PASSENGER};
+    
+    for (int s = 0; s < PIPELINE_STAGE_COUNT; s++) {
+        Stage& stage = stages[s];
+        stage.servers = max(1, servers[s]);
+        // Keep at least one standard server
+        stage.fast_servers = max(0, min(fast[s], stage.servers - 1));
+        stage.busy_standard = 0;
+        stage.busy_fast = 0;
+        stage.seconds_per_group = per_group[s];
+        stage.seconds_per_passenger = per_passenger[s];
+        stage.stats = PipelineStageStats();
+        stage.stats.servers = stage.servers;
+        stage.stats.fast_lane_servers = stage.fast_servers;
+    }
+    
+    clock = 0;
+    next_sequence = 0;
+    gate_count = 0;
+    boarding_count = 0;
+    rng.seed(chrono::steady_clock::now().time_since_epoch().count());
     pthread_mutex_init(&pipeline_mutex, nullptr);
-    pthread_cond_init(&stage_ready, nullptr);
 }
 
 PassengerPipeline::~PassengerPipeline() {
     pthread_mutex_destroy(&pipeline_mutex);
-    pthread_cond_destroy(&stage_ready);
     for (PassengerGroup* g : all_groups) delete g;
 }
 
 void PassengerPipeline::add_arrival(PassengerGroup* group) {
     pthread_mutex_lock(&pipeline_mutex);
     all_groups.push_back(group);
-    arrival_queue.push(group);
     group->set_status(PAX_ARRIVED);
+    enqueue_locked(STAGE_CHECKIN, group);
     pthread_mutex_unlock(&pipeline_mutex);
 }
 
-void PassengerPipeline::process_checkin(long long current_time) {
+void PassengerPipeline::add_arrival(PassengerGroup* group, long long arrival_time) {
     pthread_mutex_lock(&pipeline_mutex);
-    Logger* logger = Logger::get_instance();
-    
-    int processed = 0;
-    while (!arrival_queue.empty() && processed < checkin_counters) {
-        PassengerGroup* g = arrival_queue.front();
-        arrival_queue.pop();
-        
-        // REQ-3: VIP / Special Passenger Handling
-        ostringstream log_msg;
-        int base_time_ms = 500000;  // 0.5s base processing time
-        
-        if (g->is_vip()) {
-            // VIP gets 0.5x processing time (fast-track)
-            base_time_ms = (int)(base_time_ms * g->get_processing_multiplier());
-            log_msg << "[VIP] Fast-tracking " << g->get_count() << " VIP passengers for flight " << g->get_flight_id();
-            logger->log_event(log_msg.str());
-        }
-        
-        if (g->is_disabled()) {
-            // Disabled passengers get extra assistance delay
-            log_msg.str("");
-            log_msg << "[SPECIAL] Wheelchair/assistance provided for " << g->get_count() << " disabled passengers, flight " << g->get_flight_id();
-            logger->log_event(log_msg.str());
-            usleep(g->get_assistance_delay() * 1000);  // Add assistance delay
-        }
-        
-        if (g->is_unaccompanied_minor()) {
-            log_msg.str("");
-            log_msg << "[SPECIAL] Escort assigned for " << g->get_count() << " unaccompanied minors, flight " << g->get_flight_id();
-            logger->log_event(log_msg.str());
-        }
-        
-        // Apply processing time
-        pthread_mutex_unlock(&pipeline_mutex);
-        usleep(base_time_ms);
-        pthread_mutex_lock(&pipeline_mutex);
-        
-        g->record_check_in(current_time);
-        security_queue.push(g);
-        processed++;
+    all_groups.push_back(group);
+    group->set_status(PAX_ARRIVED);
+    if (arrival_time <= clock) {
+        enqueue_locked(STAGE_CHECKIN, group);
+    } else {
+        schedule_locked(arrival_time, PIPE_ARRIVAL, STAGE_CHECKIN, false, group);
+    }
+    pthread_mutex_unlock(&pipeline_mutex);
+}
+
+void PassengerPipeline::schedule_locked(double time, PipelineEventKind kind, int stage, bool fast,
+                                        PassengerGroup* group) {
+    PipelineEvent event;
+    event.time = time;
+    event.started = clock;
+    event.sequence = next_sequence++;
+    event.kind = kind;
+    event.stage = stage;
+    event.fast = fast;
+    event.group = group;
+    events.push(event);
+}
+
+void PassengerPipeline::enqueue_locked(int stage, PassengerGroup* group) {
+    Waiting waiting = {group, clock};
+    if (group->is_vip()) {
+        stages[stage].fast_queue.push(waiting);
+    } else {
+        stages[stage].standard_queue.push(waiting);
+    }
+    dispatch_locked(stage);
+}
+
+void PassengerPipeline::dispatch_locked(int stage) {
+    Stage& s = stages[stage];
+    
+    // Fast lanes take VIPs only
+    while (s.busy_fast < s.fast_servers && !s.fast_queue.empty()) {
+        Waiting waiting = s.fast_queue.front();
+        s.fast_queue.pop();
+        start_service_locked(stage, waiting, true);
+    }
+    
+    // Standard servers take both queues in arrival order
+    int standard_servers = s.servers - s.fast_servers;
+    while (s.busy_standard < standard_servers && (!s.standard_queue.empty() || !s.fast_queue.empty())) {
+        bool vip_first = !s.fast_queue.empty() &&
+                         (s.standard_queue.empty() || s.fast_queue.front().since < s.standard_queue.front().since);
+        queue<Waiting>& from = vip_first ? s.fast_queue : s.standard_queue;
+        Waiting waiting = from.front();
+        from.pop();
+        start_service_locked(stage, waiting, false);
+    }
+}
+
+void PassengerPipeline::start_service_locked(int stage, const Waiting& waiting, bool fast) {
+    Stage& s = stages[stage];
+    PassengerGroup* g = waiting.group;
+    if (fast) s.busy_fast++;
+    else s.busy_standard++;
+    
+    double wait = clock - waiting.since;
+    s.stats.total_wait += wait;
+    s.stats.max_wait = max(s.stats.max_wait, wait);
+    if (g->is_vip()) s.stats.vip_wait += wait;
+    g->set_status(stage == STAGE_CHECKIN ? PAX_CHECKING_IN : PAX_SECURITY);
+    
+    double duration = service_time_locked(stage, g);
+    schedule_locked(clock + duration, PIPE_SERVICE_DONE, stage, fast, g);
+}
+
+double PassengerPipeline::service_time_locked(int stage, PassengerGroup* group) {
+    Stage& s = stages[stage];
+    double mean = s.seconds_per_group + s.seconds_per_passenger * group->get_count();
+    
+    // Lognormal with the stage mean and SERVICE_TIME_CV
+    double sigma2 = log(1.0 + SERVICE_TIME_CV * SERVICE_TIME_CV);
+    lognormal_distribution<double> dist(log(mean) - sigma2 / 2, sqrt(sigma2));
+    double duration = dist(rng);
+    
+    // REQ-3: VIP fast-track, assistance for disabled passengers at check-in
+    duration *= group->get_processing_multiplier();
+    if (stage == STAGE_CHECKIN) {
+        duration += group->get_assistance_delay();
     }
+    return duration;
+}
+
+void PassengerPipeline::handle_locked(const PipelineEvent& event) {
+    PassengerGroup* g = event.group;
+    if (event.kind == PIPE_ARRIVAL) {
+        enqueue_locked(event.stage, g);
+        return;
+    }
+    
+    Stage& s = stages[event.stage];
+    if (event.fast) s.busy_fast--;
+    else s.busy_standard--;
+    s.stats.busy_time += event.time - event.started;
+    s.stats.groups++;
+    s.stats.passengers += g->get_count();
+    if (g->is_vip()) s.stats.vip_groups++;
     
+    if (event.stage == STAGE_CHECKIN) {
+        if (g->is_disabled()) s.stats.assisted_groups++;
+        if (g->is_unaccompanied_minor()) s.stats.escorted_groups++;
+        g->record_check_in((long long)clock);
+        enqueue_locked(STAGE_SECURITY, g);
+    } else {
+        g->set_status(PAX_AT_GATE);
+        gate_groups[g->get_flight_id()].push_back(g);
+        gate_count++;
+    }
+    
+    // The freed server takes the next group
+    dispatch_locked(event.stage);
+}
+
+long long PassengerPipeline::advance_to(long long time) {
+    pthread_mutex_lock(&pipeline_mutex);
+    long long processed = 0;
+    while (!events.empty() && events.top().time <= time) {
+        PipelineEvent event = events.top();
+        events.pop();
+        clock = event.time;
+        handle_locked(event);
+        processed++;
+    }
+    clock = max(clock, (double)time);
     pthread_mutex_unlock(&pipeline_mutex);
+    return processed;
 }
 
-void PassengerPipeline::process_security(long long current_time) {
+long long PassengerPipeline::run_until_idle() {
     pthread_mutex_lock(&pipeline_mutex);
-    Logger* logger = Logger::get_instance();
-    
-    int processed = 0;
-    while (!security_queue.empty() && processed < security_lanes) {
-        PassengerGroup* g = security_queue.front();
-        security_queue.pop();
-        
-        // REQ-3: VIP gets priority security lane
-        int security_time_ms = 300000;  // 0.3s base
-        if (g->is_vip()) {
-            security_time_ms = (int)(security_time_ms * g->get_processing_multiplier());
-        }
-        
-        pthread_mutex_unlock(&pipeline_mutex);
-        usleep(security_time_ms);
-        pthread_mutex_lock(&pipeline_mutex);
-        
-        g->set_status(PAX_AT_GATE);
-        gate_queue.push(g);
+    long long processed = 0;
+    while (!events.empty()) {
+        PipelineEvent event = events.top();
+        events.pop();
+        clock = event.time;
+        handle_locked(event);
         processed++;
     }
-    
+    pthread_mutex_unlock(&pipeline_mutex);
+    return processed;
+}
+
+double PassengerPipeline::get_clock() {
+    pthread_mutex_lock(&pipeline_mutex);
+    double result = clock;
+    pthread_mutex_unlock(&pipeline_mutex);
+    return result;
+}
+
+void PassengerPipeline::set_seed(unsigned seed) {
+    pthread_mutex_lock(&pipeline_mutex);
+    rng.seed(seed);
     pthread_mutex_unlock(&pipeline_mutex);
 }
 
 void PassengerPipeline::process_gate(int flight_id, long long current_time) {
     pthread_mutex_lock(&pipeline_mutex);
     
-    queue<PassengerGroup*> temp;
-    while (!gate_queue.empty()) {
-        PassengerGroup* g = gate_queue.front();
-        gate_queue.pop();
-        
-        if (g->get_flight_id() == flight_id) {
+    auto it = gate_groups.find(flight_id);
+    if (it != gate_groups.end()) {
+        vector<PassengerGroup*>& boarding = boarding_groups[flight_id];
+        for (PassengerGroup* g : it->second) {
             g->set_status(PAX_BOARDING);
-            boarding_queue.push(g);
-        } else {
-            temp.push(g);
+            boarding.push_back(g);
         }
+        gate_count -= it->second.size();
+        boarding_count += it->second.size();
+        gate_groups.erase(it);
     }
-    gate_queue = temp;
     
     pthread_mutex_unlock(&pipeline_mutex);
 }
@@ -123,18 +229,14 @@ void PassengerPipeline::process_gate(int flight_id, long long current_time) {
 void PassengerPipeline::process_boarding(int flight_id, long long current_time) {
     pthread_mutex_lock(&pipeline_mutex);
     
-    queue<PassengerGroup*> temp;
-    while (!boarding_queue.empty()) {
-        PassengerGroup* g = boarding_queue.front();
-        boarding_queue.pop();
-        
-        if (g->get_flight_id() == flight_id) {
+    auto it = boarding_groups.find(flight_id);
+    if (it != boarding_groups.end()) {
+        for (PassengerGroup* g : it->second) {
             g->record_boarding(current_time);
-        } else {
-            temp.push(g);
         }
+        boarding_count -= it->second.size();
+        boarding_groups.erase(it);
     }
-    boarding_queue = temp;
     
     pthread_mutex_unlock(&pipeline_mutex);
 }
@@ -143,10 +245,9 @@ vector<PassengerGroup*> PassengerPipeline::get_boarding_ready(int flight_id) {
     vector<PassengerGroup*> ready;
     pthread_mutex_lock(&pipeline_mutex);
     
-    for (PassengerGroup* g : all_groups) {
-        if (g->get_flight_id() == flight_id && g->get_status() == PAX_BOARDING) {
-            ready.push_back(g);
-        }
+    auto it = boarding_groups.find(flight_id);
+    if (it != boarding_groups.end()) {
+        ready = it->second;
     }
     
     pthread_mutex_unlock(&pipeline_mutex);
@@ -171,10 +272,14 @@ int PassengerPipeline::get_queue_length(PassengerStatus stage) {
     pthread_mutex_lock(&pipeline_mutex);
     int len = 0;
     switch (stage) {
-        case PAX_ARRIVED: len = arrival_queue.size(); break;
-        case PAX_CHECKED_IN: len = security_queue.size(); break;
-        case PAX_AT_GATE: len = gate_queue.size(); break;
-        case PAX_BOARDING: len = boarding_queue.size(); break;
+        case PAX_ARRIVED:
+            len = stages[STAGE_CHECKIN].standard_queue.size() + stages[STAGE_CHECKIN].fast_queue.size();
+            break;
+        case PAX_CHECKED_IN:
+            len = stages[STAGE_SECURITY].standard_queue.size() + stages[STAGE_SECURITY].fast_queue.size();
+            break;
+        case PAX_AT_GATE: len = gate_count; break;
+        case PAX_BOARDING: len = boarding_count; break;
         default: break;
     }
     pthread_mutex_unlock(&pipeline_mutex);
@@ -190,3 +295,18 @@ int PassengerPipeline::get_total_passengers() {
     pthread_mutex_unlock(&pipeline_mutex);
     return total;
 }
+
+PipelineStageStats PassengerPipeline::get_stage_stats(PipelineStage stage) {
+    pthread_mutex_lock(&pipeline_mutex);
+    const Stage& s = stages[stage];
+    PipelineStageStats result = s.stats;
+    result.queue_length = s.standard_queue.size() + s.fast_queue.size();
+    result.busy = s.busy_standard + s.busy_fast;
+    double elapsed = clock;
+    pthread_mutex_unlock(&pipeline_mutex);
+    
+    result.average_wait = result.groups > 0 ? result.total_wait / result.groups : 0.0;
+    result.average_vip_wait = result.vip_groups > 0 ? result.vip_wait / result.vip_groups : 0.0;
+    result.utilization = elapsed > 0 ? result.busy_time / (result.servers * elapsed) : 0.0;
+    return result;
+}
@@ -4,39 +4,146 @@
 #include "PassengerGroup.h"
 #include <vector>
 #include <queue>
+#include <unordered_map>
+#include <random>
 #include <pthread.h>
 
 using namespace std;
 
 // PassengerPipeline implements passenger flow through airport stages
 // Stages: Arrival -> Check-in -> Security -> Gate -> Boarding
+//
+// Check-in and security are a discrete-event queueing model: each stage is
+// a multi-server queue (M/G/c style) whose counters or lanes serve groups
+// in parallel, and service takes virtual time rather than real sleeps.
+// Events (arrivals, service completions) are kept in a min-heap by time;
+// advance_to() runs them in order, so a day of passengers takes
+// milliseconds.
+//
+// Some servers of each stage are VIP fast lanes: they serve only VIP
+// groups. Standard servers serve VIP and standard groups alike in arrival
+// order. Service time is lognormal around a per-group plus
+// per-passenger mean; VIPs take get_processing_multiplier() of it and
+// disabled passengers add get_assistance_delay() at check-in.
+//
+// Times are seconds of virtual time.
+
+enum PipelineStage {
+    STAGE_CHECKIN,
+    STAGE_SECURITY
+};
+
+static constexpr int PIPELINE_STAGE_COUNT = STAGE_SECURITY + 1;
+
+struct PipelineStageStats {
+    int servers;
+    int fast_lane_servers;      // Of servers, VIP only
+    long long groups;           // Served
+    long long passengers;
+    long long vip_groups;
+    long long assisted_groups;  // Disabled passengers (check-in)
+    long long escorted_groups;  // Unaccompanied minors (check-in)
+    double total_wait;          // Seconds queued before service
+    double max_wait;
+    double vip_wait;            // Of total_wait
+    double busy_time;           // Server-seconds of finished service
+    int queue_length;
+    int busy;
+    double average_wait;
+    double average_vip_wait;
+    double utilization;         // busy_time / (servers * clock)
+};
 
 class PassengerPipeline {
+public:
+    // Mean service time per group: base + per passenger (seconds)
+    static constexpr double CHECKIN_SECONDS_PER_GROUP = 60.0;
+    static constexpr double CHECKIN_SECONDS_PER_PASSENGER = 45.0;
+    static constexpr double SECURITY_SECONDS_PER_GROUP = 20.0;
+    static constexpr double SECURITY_SECONDS_PER_PASSENGER = 25.0;
+    static constexpr double SERVICE_TIME_CV = 0.5;      // Std dev / mean
+    
 private:
-    queue<PassengerGroup*> arrival_queue;
-    queue<PassengerGroup*> checkin_queue;
-    queue<PassengerGroup*> security_queue;
-    queue<PassengerGroup*> gate_queue;
-    queue<PassengerGroup*> boarding_queue;
+    struct Waiting {
+        PassengerGroup* group;
+        double since;
+    };
     
-    vector<PassengerGroup*> all_groups;
+    struct Stage {
+        queue<Waiting> standard_queue;
+        queue<Waiting> fast_queue;      // VIP groups
+        int servers;
+        int fast_servers;               // Of servers
+        int busy_standard;
+        int busy_fast;
+        double seconds_per_group;
+        double seconds_per_passenger;
+        PipelineStageStats stats;
+    };
     
-    int checkin_counters;
-    int security_lanes;
+    enum PipelineEventKind {
+        PIPE_ARRIVAL,
+        PIPE_SERVICE_DONE
+    };
+    
+    struct PipelineEvent {
+        double time;
+        double started;                 // Service start
+        long long sequence;             // FIFO among equal times
+        PipelineEventKind kind;
+        int stage;
+        bool fast;                      // Served on a fast lane
+        PassengerGroup* group;
+    };
+    
+    struct EventLater {
+        bool operator()(const PipelineEvent& a, const PipelineEvent& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            return a.sequence > b.sequence;
+        }
+    };
+    
+    priority_queue<PipelineEvent, vector<PipelineEvent>, EventLater> events;
+    Stage stages[PIPELINE_STAGE_COUNT];
+    double clock;
+    long long next_sequence;
+    mt19937 rng;
+    
+    // Past security, by flight id
+    unordered_map<int, vector<PassengerGroup*>> gate_groups;
+    unordered_map<int, vector<PassengerGroup*>> boarding_groups;
+    int gate_count;
+    int boarding_count;
+    
+    vector<PassengerGroup*> all_groups;
     
     pthread_mutex_t pipeline_mutex;
-    pthread_cond_t stage_ready;
+    
+    // Caller holds pipeline_mutex
+    void schedule_locked(double time, PipelineEventKind kind, int stage, bool fast, PassengerGroup* group);
+    void enqueue_locked(int stage, PassengerGroup* group);
+    void dispatch_locked(int stage);
+    void start_service_locked(int stage, const Waiting& waiting, bool fast);
+    double service_time_locked(int stage, PassengerGroup* group);
+    void handle_locked(const PipelineEvent& event);
     
 public:
-    PassengerPipeline(int counters, int lanes);
+    // counters / lanes include fast_counters / fast_lanes VIP-only servers
+    PassengerPipeline(int counters, int lanes, int fast_counters = 1, int fast_lanes = 1);
     ~PassengerPipeline();
     
-    // Add passengers to pipeline
+    // Add passengers to pipeline, now or at a later arrival time
     void add_arrival(PassengerGroup* group);
+    void add_arrival(PassengerGroup* group, long long arrival_time);
+    
+    // Run check-in and security up to time; returns events processed
+    long long advance_to(long long time);
+    // Run until every queued group is past security
+    long long run_until_idle();
+    double get_clock();
+    void set_seed(unsigned seed);
     
-    // Process stage (move to next)
-    void process_checkin(long long current_time);
-    void process_security(long long current_time);
+    // Move a flight's groups from the gate to boarding, then on board
     void process_gate(int flight_id, long long current_time);
     void process_boarding(int flight_id, long long current_time);
     
@@ -49,6 +156,7 @@ public:
     // Statistics
     int get_queue_length(PassengerStatus stage);
     int get_total_passengers();
+    PipelineStageStats get_stage_stats(PipelineStage stage);
 };
 
 #endif // PASSENGER_PIPELINE_H
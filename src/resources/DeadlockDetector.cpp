@@ -1,8 +1,10 @@
 #include "DeadlockDetector.h"
+#include <algorithm>
 
 using namespace std;
 
 DeadlockDetector::DeadlockDetector() {
+    next_order = 0;
     pthread_mutex_init(&detector_mutex, nullptr);
 }
 
@@ -10,109 +12,396 @@ DeadlockDetector::~DeadlockDetector() {
     pthread_mutex_destroy(&detector_mutex);
 }
 
-void DeadlockDetector::add_wait(int waiter_id, int holder_id) {
+int DeadlockDetector::get_node(int flight_id) {
+    auto it = node_of.find(flight_id);
+    if (it != node_of.end()) {
+        return it->second;
+    }
+
+    int index;
+    if (!free_nodes.empty()) {
+        index = free_nodes.back();
+        free_nodes.pop_back();
+    } else {
+        index = nodes.size();
+        nodes.push_back(WaitNode());
+        mark.push_back(0);
+    }
+
+    // New nodes have no edges, so the end of the order is always valid
+    WaitNode& node = nodes[index];
+    node.flight_id = flight_id;
+    node.order = next_order++;
+    node.live = true;
+    node.out.clear();
+    node.in.clear();
+    node_of[flight_id] = index;
+    return index;
+}
+
+bool DeadlockDetector::has_edge(int from, int to) const {
+    const vector<int>& out = nodes[from].out;
+    return find(out.begin(), out.end(), to) != out.end();
+}
+
+void DeadlockDetector::unlink(int from, int to) {
+    vector<int>& out = nodes[from].out;
+    auto it = find(out.begin(), out.end(), to);
+    if (it != out.end()) {
+        *it = out.back();
+        out.pop_back();
+    }
+
+    vector<int>& in = nodes[to].in;
+    it = find(in.begin(), in.end(), from);
+    if (it != in.end()) {
+        *it = in.back();
+        in.pop_back();
+    }
+}
+
+void DeadlockDetector::clear_marks(const vector<int>& visited) {
+    for (int n : visited) {
+        mark[n] = 0;
+    }
+}
+
+// ========== Pearce-Kelly dynamic topological order ==========
+
+bool DeadlockDetector::forward_search(int start, int upper_order, int target) {
+    // Nodes reachable from start that sit before target in the order
+    search_stack.clear();
+    search_stack.push_back(start);
+    mark[start] = 1;
+
+    while (!search_stack.empty()) {
+        int n = search_stack.back();
+        search_stack.pop_back();
+        forward_set.push_back(n);
+
+        for (int w : nodes[n].out) {
+            if (w == target) {
+                // Reached the waiter again - unmark what is still queued
+                clear_marks(search_stack);
+                return true;
+            }
+            if (!mark[w] && nodes[w].order < upper_order) {
+                mark[w] = 1;
+                search_stack.push_back(w);
+            }
+        }
+    }
+    return false;
+}
+
+void DeadlockDetector::backward_search(int start, int lower_order) {
+    // Nodes that reach start and sit after the holder in the order
+    search_stack.clear();
+    search_stack.push_back(start);
+    mark[start] = 1;
+
+    while (!search_stack.empty()) {
+        int n = search_stack.back();
+        search_stack.pop_back();
+        backward_set.push_back(n);
+
+        for (int w : nodes[n].in) {
+            if (!mark[w] && nodes[w].order > lower_order) {
+                mark[w] = 1;
+                search_stack.push_back(w);
+            }
+        }
+    }
+}
+
+void DeadlockDetector::reorder() {
+    auto by_order = [this](int a, int b) { return nodes[a].order < nodes[b].order; };
+    sort(backward_set.begin(), backward_set.end(), by_order);
+    sort(forward_set.begin(), forward_set.end(), by_order);
+
+    // Reuse the same positions: everything reaching the waiter first,
+    // then everything reachable from the holder
+    vector<int> positions;
+    positions.reserve(backward_set.size() + forward_set.size());
+    for (int n : backward_set) positions.push_back(nodes[n].order);
+    for (int n : forward_set) positions.push_back(nodes[n].order);
+    sort(positions.begin(), positions.end());
+
+    size_t k = 0;
+    for (int n : backward_set) nodes[n].order = positions[k++];
+    for (int n : forward_set) nodes[n].order = positions[k++];
+}
+
+bool DeadlockDetector::insert_acyclic(int from, int to) {
+    if (from == to) return false;  // Waiting for itself
+
+    int lower = nodes[to].order;
+    int upper = nodes[from].order;
+    if (lower > upper) {
+        // Already consistent with the order
+        nodes[from].out.push_back(to);
+        nodes[to].in.push_back(from);
+        return true;
+    }
+
+    forward_set.clear();
+    backward_set.clear();
+    if (forward_search(to, upper, from)) {
+        clear_marks(forward_set);
+        return false;
+    }
+    backward_search(from, lower);
+    reorder();
+    clear_marks(forward_set);
+    clear_marks(backward_set);
+
+    nodes[from].out.push_back(to);
+    nodes[to].in.push_back(from);
+    return true;
+}
+
+void DeadlockDetector::retry_back_edges() {
+    // Adding edges never breaks a cycle, so one pass is enough
+    size_t kept = 0;
+    for (size_t i = 0; i < back_edges.size(); i++) {
+        if (!insert_acyclic(back_edges[i].first, back_edges[i].second)) {
+            back_edges[kept++] = back_edges[i];
+        }
+    }
+    back_edges.resize(kept);
+}
+
+// ========== Public interface ==========
+
+bool DeadlockDetector::add_wait(int waiter_id, int holder_id) {
     pthread_mutex_lock(&detector_mutex);
-    wait_for_graph[waiter_id].insert(holder_id);
+
+    int from = get_node(waiter_id);
+    int to = get_node(holder_id);
+    bool closes_cycle = false;
+
+    bool known = has_edge(from, to) ||
+                 find(back_edges.begin(), back_edges.end(), make_pair(from, to)) != back_edges.end();
+    if (!known && !insert_acyclic(from, to)) {
+        back_edges.push_back(make_pair(from, to));
+        closes_cycle = true;
+    }
+
     pthread_mutex_unlock(&detector_mutex);
+    return closes_cycle;
 }
 
 void DeadlockDetector::remove_wait(int waiter_id, int holder_id) {
     pthread_mutex_lock(&detector_mutex);
-    auto it = wait_for_graph.find(waiter_id);
-    if (it != wait_for_graph.end()) {
-        it->second.erase(holder_id);
-        if (it->second.empty()) {
-            wait_for_graph.erase(it);
+
+    auto from_it = node_of.find(waiter_id);
+    auto to_it = node_of.find(holder_id);
+    if (from_it != node_of.end() && to_it != node_of.end()) {
+        int from = from_it->second;
+        int to = to_it->second;
+
+        auto back = find(back_edges.begin(), back_edges.end(), make_pair(from, to));
+        if (back != back_edges.end()) {
+            back_edges.erase(back);
+        } else if (has_edge(from, to)) {
+            unlink(from, to);
+            if (!back_edges.empty()) {
+                retry_back_edges();
+            }
         }
     }
+
     pthread_mutex_unlock(&detector_mutex);
 }
 
 void DeadlockDetector::remove_flight(int flight_id) {
     pthread_mutex_lock(&detector_mutex);
-    
-    // Remove as waiter
-    wait_for_graph.erase(flight_id);
-    
-    // Remove as holder from all waiters
-    for (auto& pair : wait_for_graph) {
-        pair.second.erase(flight_id);
-    }
-    
-    pthread_mutex_unlock(&detector_mutex);
-}
 
-bool DeadlockDetector::dfs_detect_cycle(int node, unordered_set<int>& visited,
-                                         unordered_set<int>& rec_stack) {
-    visited.insert(node);
-    rec_stack.insert(node);
-    
-    auto it = wait_for_graph.find(node);
-    if (it != wait_for_graph.end()) {
-        for (int neighbor : it->second) {
-            if (rec_stack.count(neighbor)) {
-                return true;  // Cycle found
-            }
-            if (!visited.count(neighbor)) {
-                if (dfs_detect_cycle(neighbor, visited, rec_stack)) {
-                    return true;
-                }
+    auto it = node_of.find(flight_id);
+    if (it != node_of.end()) {
+        int n = it->second;
+        WaitNode& node = nodes[n];
+        bool removed_acyclic = !node.out.empty() || !node.in.empty();
+
+        // Only this flight's neighbours are touched
+        for (int w : node.out) {
+            vector<int>& in = nodes[w].in;
+            in.erase(find(in.begin(), in.end(), n));
+        }
+        for (int w : node.in) {
+            vector<int>& out = nodes[w].out;
+            out.erase(find(out.begin(), out.end(), n));
+        }
+        node.out.clear();
+        node.in.clear();
+        node.live = false;
+
+        size_t kept = 0;
+        for (size_t i = 0; i < back_edges.size(); i++) {
+            if (back_edges[i].first != n && back_edges[i].second != n) {
+                back_edges[kept++] = back_edges[i];
             }
         }
+        back_edges.resize(kept);
+
+        node_of.erase(it);
+        free_nodes.push_back(n);
+
+        if (removed_acyclic && !back_edges.empty()) {
+            retry_back_edges();
+        }
     }
-    
-    rec_stack.erase(node);
-    return false;
+
+    pthread_mutex_unlock(&detector_mutex);
 }
 
 bool DeadlockDetector::detect_deadlock() {
     pthread_mutex_lock(&detector_mutex);
-    
-    unordered_set<int> visited;
-    unordered_set<int> rec_stack;
-    
-    for (auto& pair : wait_for_graph) {
-        if (!visited.count(pair.first)) {
-            if (dfs_detect_cycle(pair.first, visited, rec_stack)) {
-                pthread_mutex_unlock(&detector_mutex);
-                return true;
-            }
-        }
-    }
-    
+    bool deadlock = !back_edges.empty();
     pthread_mutex_unlock(&detector_mutex);
-    return false;
+    return deadlock;
 }
 
 vector<int> DeadlockDetector::get_deadlocked_flights() {
     vector<int> deadlocked;
-    
+
     pthread_mutex_lock(&detector_mutex);
-    
-    // Find all flights in cycles using Tarjan's algorithm (simplified)
-    unordered_set<int> in_cycle;
-    
-    for (auto& pair : wait_for_graph) {
-        int start = pair.first;
-        unordered_set<int> visited;
-        unordered_set<int> rec_stack;
-        
-        // DFS to find if this node is in a cycle
-        if (dfs_detect_cycle(start, visited, rec_stack)) {
-            in_cycle.insert(start);
+
+    if (back_edges.empty()) {
+        pthread_mutex_unlock(&detector_mutex);
+        return deadlocked;
+    }
+
+    // Every cycle uses a back edge, so only what the back edges reach is
+    // snapshot, renumbered compactly
+    vector<int> local(nodes.size(), -1);
+    vector<int> members;                // Local id -> node
+    for (const auto& edge : back_edges) {
+        for (int n : {edge.first, edge.second}) {
+            if (local[n] < 0) {
+                local[n] = members.size();
+                members.push_back(n);
+            }
         }
     }
-    
-    for (int flight : in_cycle) {
-        deadlocked.push_back(flight);
+    for (size_t k = 0; k < members.size(); k++) {
+        for (int w : nodes[members[k]].out) {
+            if (local[w] < 0) {
+                local[w] = members.size();
+                members.push_back(w);
+            }
+        }
+    }
+
+    // CSR: acyclic edges, then back edges, grouped by source
+    int count = members.size();
+    vector<int> offsets(count + 1, 0);
+    for (int m = 0; m < count; m++) {
+        offsets[m + 1] = nodes[members[m]].out.size();
     }
-    
+    for (const auto& edge : back_edges) {
+        offsets[local[edge.first] + 1]++;
+    }
+    for (int m = 0; m < count; m++) {
+        offsets[m + 1] += offsets[m];
+    }
+    vector<int> targets(offsets[count]);
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int m = 0; m < count; m++) {
+        for (int w : nodes[members[m]].out) targets[fill[m]++] = local[w];
+    }
+    for (const auto& edge : back_edges) {
+        targets[fill[local[edge.first]]++] = local[edge.second];
+    }
+
+    vector<int> index(count, -1);
+    vector<int> low(count, 0);
+    vector<char> on_stack(count, 0);
+    vector<int> scc_stack;
+    vector<pair<int, int>> call_stack;  // (node, next position in targets)
+    int next_index = 0;
+
+    // Tarjan's SCC only needs to start from back edge sources
+    for (const auto& root_edge : back_edges) {
+        int root = local[root_edge.first];
+        if (index[root] >= 0) continue;
+
+        index[root] = low[root] = next_index++;
+        scc_stack.push_back(root);
+        on_stack[root] = 1;
+        call_stack.push_back(make_pair(root, offsets[root]));
+
+        while (!call_stack.empty()) {
+            int n = call_stack.back().first;
+            int& i = call_stack.back().second;
+
+            if (i < offsets[n + 1]) {
+                int w = targets[i++];
+                if (index[w] < 0) {
+                    index[w] = low[w] = next_index++;
+                    scc_stack.push_back(w);
+                    on_stack[w] = 1;
+                    call_stack.push_back(make_pair(w, offsets[w]));
+                } else if (on_stack[w]) {
+                    low[n] = min(low[n], index[w]);
+                }
+                continue;
+            }
+
+            // All neighbours done - pop and close the SCC if n is its root
+            call_stack.pop_back();
+            if (!call_stack.empty()) {
+                int parent = call_stack.back().first;
+                low[parent] = min(low[parent], low[n]);
+            }
+            if (low[n] == index[n]) {
+                size_t first = scc_stack.size();
+                do {
+                    first--;
+                    on_stack[scc_stack[first]] = 0;
+                } while (scc_stack[first] != n);
+
+                // Cycle if more than one flight, or a flight waiting on itself
+                bool self_wait = find(targets.begin() + offsets[n], targets.begin() + offsets[n + 1], n) !=
+                                 targets.begin() + offsets[n + 1];
+                if (scc_stack.size() - first > 1 || self_wait) {
+                    for (size_t k = first; k < scc_stack.size(); k++) {
+                        deadlocked.push_back(nodes[members[scc_stack[k]]].flight_id);
+                    }
+                }
+                scc_stack.resize(first);
+            }
+        }
+    }
+
     pthread_mutex_unlock(&detector_mutex);
     return deadlocked;
 }
 
 void DeadlockDetector::reset() {
     pthread_mutex_lock(&detector_mutex);
-    wait_for_graph.clear();
+    nodes.clear();
+    node_of.clear();
+    free_nodes.clear();
+    back_edges.clear();
+    mark.clear();
+    next_order = 0;
+    pthread_mutex_unlock(&detector_mutex);
+}
+
+int DeadlockDetector::get_flight_count() {
+    pthread_mutex_lock(&detector_mutex);
+    int count = node_of.size();
+    pthread_mutex_unlock(&detector_mutex);
+    return count;
+}
+
+int DeadlockDetector::get_edge_count() {
+    pthread_mutex_lock(&detector_mutex);
+    size_t count = back_edges.size();
+    for (const WaitNode& node : nodes) {
+        count += node.out.size();
+    }
     pthread_mutex_unlock(&detector_mutex);
+    return count;
 }
@@ -3,45 +3,91 @@
 
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <pthread.h>
 
 using namespace std;
 
 // DeadlockDetector implements wait-for graph with cycle detection
+//
+// Cycles are detected online as edges are added. The acyclic part of the
+// graph keeps a topological order (Pearce-Kelly): an edge that agrees with
+// the order is accepted in O(1), otherwise only the nodes between its two
+// ends are searched and reordered. An edge that would close a cycle is kept
+// aside as a back edge, so detect_deadlock() is O(1). Whenever acyclic edges
+// are removed, back edges are retried and move back in if their cycle broke.
+// get_deadlocked_flights() reports cycle members with Tarjan's SCC.
+//
+// Edges come and go one at a time, so each node keeps its own out/in
+// vectors; a CSR array would have to be rebuilt on every edit. The full
+// report instead snapshots the part the back edges reach as CSR (offsets
+// + targets) and runs Tarjan over that.
+
+struct WaitNode {
+    int flight_id;
+    int order;              // Topological position among acyclic edges
+    bool live;
+    vector<int> out;        // Acyclic edges: nodes this flight waits for
+    vector<int> in;         // Acyclic edges: nodes waiting for this flight
+};
 
 class DeadlockDetector {
 private:
-    // Wait-for graph: flight -> set of flights it's waiting for
-    unordered_map<int, unordered_set<int>> wait_for_graph;
-    
+    // Wait-for graph over compact node indices
+    vector<WaitNode> nodes;
+    unordered_map<int, int> node_of;        // Flight id -> node index
+    vector<int> free_nodes;
+    int next_order;
+
+    // Edges (waiter node, holder node) that close a cycle
+    vector<pair<int, int>> back_edges;
+
+    // Search scratch, reused between calls
+    vector<char> mark;
+    vector<int> search_stack;
+    vector<int> forward_set;
+    vector<int> backward_set;
+
     pthread_mutex_t detector_mutex;
-    
-    // DFS for cycle detection
-    bool dfs_detect_cycle(int node, unordered_set<int>& visited, 
-                          unordered_set<int>& rec_stack);
-    
+
+    int get_node(int flight_id);
+    bool has_edge(int from, int to) const;
+    void unlink(int from, int to);
+    void clear_marks(const vector<int>& visited);
+
+    // Pearce-Kelly insertion; false (graph unchanged) if the edge closes a cycle
+    bool insert_acyclic(int from, int to);
+    bool forward_search(int start, int upper_order, int target);
+    void backward_search(int start, int lower_order);
+    void reorder();
+
+    // Move back edges into the acyclic part where possible
+    void retry_back_edges();
+
 public:
     DeadlockDetector();
     ~DeadlockDetector();
-    
+
     // Add wait edge: waiter is waiting for holder
-    void add_wait(int waiter_id, int holder_id);
-    
+    // Returns true if this edge closed a cycle (deadlock)
+    bool add_wait(int waiter_id, int holder_id);
+
     // Remove wait edge
     void remove_wait(int waiter_id, int holder_id);
-    
+
     // Remove all edges involving a flight
     void remove_flight(int flight_id);
-    
+
     // Detect if there's a cycle (deadlock)
     bool detect_deadlock();
-    
+
     // Get flights involved in deadlock cycle
     vector<int> get_deadlocked_flights();
-    
+
     // Clear all edges
     void reset();
+
+    int get_flight_count();
+    int get_edge_count();
 };
 
 #endif // DEADLOCK_DETECTOR_H
@@ -1,4 +1,5 @@
 #include "Resource.h"
+#include <chrono>
 
 using namespace std;
 
@@ -10,6 +11,7 @@ Resource::Resource(int id, ResourceType t, const string& n) {
     assigned_flight_id = -1;
     assignment_time = 0;
     expected_duration = 0;
+    acquired_ns = 0;
     pthread_mutex_init(&resource_mutex, nullptr);
 }
 
@@ -29,6 +31,8 @@ bool Resource::try_acquire(int flight_id, long long current_time, long long dura
     assigned_flight_id = flight_id;
     assignment_time = current_time;
     expected_duration = duration;
+    acquired_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
     
     pthread_mutex_unlock(&resource_mutex);
     return true;
@@ -45,6 +49,13 @@ void Resource::release() {
     pthread_mutex_unlock(&resource_mutex);
 }
 
+long long Resource::get_held_ns() const {
+    if (is_available) return 0;
+    long long now = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+    return now - acquired_ns;
+}
+
 string Resource::type_to_string(ResourceType type) {
     switch (type) {
         case RES_FUEL_TRUCK: return "Fuel Truck";
@@ -1,6 +1,7 @@
 #ifndef RESOURCE_H
 #define RESOURCE_H
 
+#include "ResourceCalendar.h"
 #include <string>
 #include <pthread.h>
 
@@ -28,9 +29,13 @@ private:
     
     long long assignment_time;
     long long expected_duration;
+    long long acquired_ns;      // Steady clock at acquisition, for hold times
     
     pthread_mutex_t resource_mutex;
     
+    // Future bookings (guarded by the owning pool's lock)
+    ResourceCalendar calendar;
+    
 public:
     Resource(int id, ResourceType t, const string& n);
     ~Resource();
@@ -47,6 +52,8 @@ public:
     int get_assigned_flight() const { return assigned_flight_id; }
     long long get_assignment_time() const { return assignment_time; }
     long long get_expected_duration() const { return expected_duration; }
+    long long get_held_ns() const;
+    ResourceCalendar& get_calendar() { return calendar; }
     
     static string type_to_string(ResourceType type);
 };
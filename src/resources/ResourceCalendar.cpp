@@ -0,0 +1,76 @@
+#include "ResourceCalendar.h"
+
+using namespace std;
+
+bool ResourceCalendar::is_free(long long start, long long end) const {
+    if (end <= start) return true;
+    auto it = bookings.lower_bound(end);
+    if (it == bookings.begin()) return true;
+    --it;
+    return it->second.end <= start;
+}
+
+const CalendarBooking* ResourceCalendar::first_overlap(long long start, long long end) const {
+    if (end <= start) return nullptr;
+    auto it = bookings.upper_bound(start);
+    if (it != bookings.begin()) {
+        auto prev = it;
+        --prev;
+        if (prev->second.end > start) return &prev->second;
+    }
+    if (it != bookings.end() && it->first < end) return &it->second;
+    return nullptr;
+}
+
+long long ResourceCalendar::earliest_free(long long not_before, long long duration) const {
+    long long start = not_before;
+    
+    // A booking that started earlier may still be running
+    auto it = bookings.upper_bound(start);
+    if (it != bookings.begin()) {
+        auto prev = it;
+        --prev;
+        if (prev->second.end > start) {
+            start = prev->second.end;
+        }
+    }
+    
+    // Skip bookings until a gap is long enough
+    while (it != bookings.end() && it->first < start + duration) {
+        if (it->second.end > start) {
+            start = it->second.end;
+        }
+        ++it;
+    }
+    return start;
+}
+
+bool ResourceCalendar::book(long long start, long long end, int flight_id) {
+    if (end <= start || !is_free(start, end)) {
+        return false;
+    }
+    
+    CalendarBooking booking;
+    booking.start = start;
+    booking.end = end;
+    booking.flight_id = flight_id;
+    bookings[start] = booking;
+    return true;
+}
+
+bool ResourceCalendar::cancel(long long start, int flight_id) {
+    auto it = bookings.find(start);
+    if (it == bookings.end() || it->second.flight_id != flight_id) {
+        return false;
+    }
+    bookings.erase(it);
+    return true;
+}
+
+void ResourceCalendar::prune(long long now) {
+    // Ends are sorted too, so expired bookings are a prefix
+    auto it = bookings.begin();
+    while (it != bookings.end() && it->second.end <= now) {
+        it = bookings.erase(it);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef RESOURCE_CALENDAR_H
+#define RESOURCE_CALENDAR_H
+
+#include <map>
+
+using namespace std;
+
+// ResourceCalendar holds future bookings of one resource.
+//
+// Bookings never overlap, so keyed by start time they are also sorted by
+// end time: the only booking that can overlap [start, end) is the last one
+// starting before end. Conflict checks are one O(log n) lookup; the earliest
+// free slot walks forward from the first booking that could collide.
+// Not thread-safe - the owning pool's lock guards it.
+
+struct CalendarBooking {
+    long long start;
+    long long end;          // Exclusive
+    int flight_id;
+};
+
+class ResourceCalendar {
+private:
+    map<long long, CalendarBooking> bookings;   // Start -> booking
+    
+public:
+    // True if [start, end) overlaps no booking
+    bool is_free(long long start, long long end) const;
+    
+    // Earliest-starting booking that overlaps [start, end), nullptr if none
+    const CalendarBooking* first_overlap(long long start, long long end) const;
+    
+    // Earliest start >= not_before with [start, start + duration) free
+    long long earliest_free(long long not_before, long long duration) const;
+    
+    // Add a booking; false if the window is taken
+    bool book(long long start, long long end, int flight_id);
+    
+    // Remove the booking starting at start, if flight_id holds it
+    bool cancel(long long start, int flight_id);
+    
+    // Drop bookings that ended at or before now
+    void prune(long long now);
+    
+    int get_booking_count() const { return bookings.size(); }
+};
+
+#endif // RESOURCE_CALENDAR_H
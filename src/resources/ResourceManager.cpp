@@ -1,25 +1,81 @@
 #include "ResourceManager.h"
 #include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <chrono>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
+// need <= work across all lanes, compared 4 lanes at a time
+static inline bool fits(const int* need_row, const int* work) {
+#if defined(__SSE2__)
+    __m128i gt_lo = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)need_row),
+                                    _mm_loadu_si128((const __m128i*)work));
+    __m128i gt_hi = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(need_row + 4)),
+                                    _mm_loadu_si128((const __m128i*)(work + 4)));
+    return _mm_movemask_epi8(_mm_or_si128(gt_lo, gt_hi)) == 0;
+#else
+    int ok = 1;
+    for (int j = 0; j < ResourceManager::RESOURCE_LANES; j++) {
+        ok &= (need_row[j] <= work[j]);
+    }
+    return ok != 0;
+#endif
+}
+
+static inline void add_lanes(int* work, const int* row) {
+    for (int j = 0; j < ResourceManager::RESOURCE_LANES; j++) {
+        work[j] += row[j];
+    }
+}
+
 ResourceManager::ResourceManager() {
     num_resource_types = 7;
     num_flights = 0;
-    available.resize(num_resource_types, 0);
+    allocated_total.resize(RESOURCE_LANES, 0);
+    sequence_valid = true;
+    incremental_checks = 0;
+    full_checks = 0;
+    profiler = nullptr;
+    listening = false;
+    release_listener = nullptr;
+    release_listener_arg = nullptr;
+    pthread_mutex_init(&listener_mutex, nullptr);
+    for (int j = 0; j < RESOURCE_LANES; j++) {
+        available[j] = 0;
+        pthread_mutex_init(&pools[j].lock, nullptr);
+        memset(&pools[j].stats, 0, sizeof(pools[j].stats));
+        memset(&pools[j].booking_stats, 0, sizeof(pools[j].booking_stats));
+    }
     pthread_mutex_init(&manager_mutex, nullptr);
     pthread_cond_init(&resource_available, nullptr);
+    pthread_condattr_init(&wait_condattr);
+    pthread_condattr_setclock(&wait_condattr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&bundle_mutex, nullptr);
+    pthread_cond_init(&bundle_cond, &wait_condattr);
+    bundle_waiters = 0;
+    bundle_generation = 0;
+    memset(&bundle_stats, 0, sizeof(bundle_stats));
 }
 
 ResourceManager::~ResourceManager() {
     pthread_mutex_destroy(&manager_mutex);
     pthread_cond_destroy(&resource_available);
+    pthread_condattr_destroy(&wait_condattr);
+    pthread_mutex_destroy(&bundle_mutex);
+    pthread_cond_destroy(&bundle_cond);
+    pthread_mutex_destroy(&listener_mutex);
     
     // Clean up resources
-    for (auto& pair : resource_pools) {
-        for (Resource* r : pair.second) {
+    for (int j = 0; j < RESOURCE_LANES; j++) {
+        for (Resource* r : pools[j].resources) {
             delete r;
         }
+        pthread_mutex_destroy(&pools[j].lock);
     }
 }
 
@@ -29,131 +85,227 @@ void ResourceManager::initialize(int fuel_trucks, int catering, int baggage,
     
     // Create fuel trucks
     for (int i = 0; i < fuel_trucks; i++) {
-        resource_pools[RES_FUEL_TRUCK].push_back(
+        pools[RES_FUEL_TRUCK].resources.push_back(
             new Resource(i, RES_FUEL_TRUCK, "FuelTruck-" + to_string(i)));
     }
     available[RES_FUEL_TRUCK] = fuel_trucks;
     
     // Create catering vehicles
     for (int i = 0; i < catering; i++) {
-        resource_pools[RES_CATERING_VEHICLE].push_back(
+        pools[RES_CATERING_VEHICLE].resources.push_back(
             new Resource(i, RES_CATERING_VEHICLE, "Catering-" + to_string(i)));
     }
     available[RES_CATERING_VEHICLE] = catering;
     
     // Create baggage carts
     for (int i = 0; i < baggage; i++) {
-        resource_pools[RES_BAGGAGE_CART].push_back(
+        pools[RES_BAGGAGE_CART].resources.push_back(
             new Resource(i, RES_BAGGAGE_CART, "Baggage-" + to_string(i)));
     }
     available[RES_BAGGAGE_CART] = baggage;
     
     // Create cleaning crews
     for (int i = 0; i < cleaning; i++) {
-        resource_pools[RES_CLEANING_CREW].push_back(
+        pools[RES_CLEANING_CREW].resources.push_back(
             new Resource(i, RES_CLEANING_CREW, "Cleaning-" + to_string(i)));
     }
     available[RES_CLEANING_CREW] = cleaning;
     
     // Create passenger buses
     for (int i = 0; i < buses; i++) {
-        resource_pools[RES_PASSENGER_BUS].push_back(
+        pools[RES_PASSENGER_BUS].resources.push_back(
             new Resource(i, RES_PASSENGER_BUS, "Bus-" + to_string(i)));
     }
     available[RES_PASSENGER_BUS] = buses;
     
     // Create aircraft tugs
     for (int i = 0; i < tugs; i++) {
-        resource_pools[RES_AIRCRAFT_TUG].push_back(
+        pools[RES_AIRCRAFT_TUG].resources.push_back(
             new Resource(i, RES_AIRCRAFT_TUG, "Tug-" + to_string(i)));
     }
     available[RES_AIRCRAFT_TUG] = tugs;
     
     // Create ground power units
     for (int i = 0; i < power_units; i++) {
-        resource_pools[RES_GROUND_POWER_UNIT].push_back(
+        pools[RES_GROUND_POWER_UNIT].resources.push_back(
             new Resource(i, RES_GROUND_POWER_UNIT, "GPU-" + to_string(i)));
     }
     available[RES_GROUND_POWER_UNIT] = power_units;
     
+    // Everything starts idle; reversed so the lowest id is handed out first
+    for (int j = 0; j < num_resource_types; j++) {
+        pthread_mutex_lock(&pools[j].lock);
+        pools[j].free_list.assign(pools[j].resources.rbegin(), pools[j].resources.rend());
+        pthread_mutex_unlock(&pools[j].lock);
+    }
+    
     pthread_mutex_unlock(&manager_mutex);
 }
 
 int ResourceManager::register_flight(const vector<int>& max_demand) {
     pthread_mutex_lock(&manager_mutex);
     
-    int flight_index = num_flights++;
+    int row = num_flights++;
+    int handle;
+    if (!free_handles.empty()) {
+        handle = free_handles.back();
+        free_handles.pop_back();
+        handle_row[handle] = row;
+    } else {
+        handle = handle_row.size();
+        handle_row.push_back(row);
+    }
+    row_handle.push_back(handle);
     
-    max_need.push_back(max_demand);
-    allocation.push_back(vector<int>(num_resource_types, 0));
-    need.push_back(max_demand);  // Initially need = max
+    max_need.resize((size_t)num_flights * RESOURCE_LANES, 0);
+    allocation.resize((size_t)num_flights * RESOURCE_LANES, 0);
+    need.resize((size_t)num_flights * RESOURCE_LANES, 0);
+    int* max_row = row_of(max_need, row);
+    for (int j = 0; j < num_resource_types && j < (int)max_demand.size(); j++) {
+        max_row[j] = max(0, max_demand[j]);
+    }
+    memcpy(row_of(need, row), max_row, RESOURCE_LANES * sizeof(int));  // Initially need = max
+    
+    // Holding nothing, the new flight can always run last once every
+    // other flight has finished - if its max fits in the whole pool
+    safe_sequence.push_back(row);
+    sequence_pos.push_back(safe_sequence.size() - 1);
+    if (sequence_valid) {
+        int work[RESOURCE_LANES];
+        load_available(work);
+        add_lanes(work, allocated_total.data());
+        sequence_valid = fits(max_row, work);
+    }
     
     pthread_mutex_unlock(&manager_mutex);
-    return flight_index;
+    return handle;
 }
 
 void ResourceManager::unregister_flight(int flight_index) {
+    bool returned = false;
     pthread_mutex_lock(&manager_mutex);
     
-    if (flight_index >= 0 && flight_index < (int)allocation.size()) {
+    if (flight_index >= 0 && flight_index < (int)handle_row.size() && handle_row[flight_index] >= 0) {
+        int row = handle_row[flight_index];
+        
         // Release all allocated resources
+        int* alloc_row = row_of(allocation, row);
         for (int j = 0; j < num_resource_types; j++) {
-            available[j] += allocation[flight_index][j];
-            allocation[flight_index][j] = 0;
-            need[flight_index][j] = 0;
-            max_need[flight_index][j] = 0;
+            if (alloc_row[j] > 0) {
+                allocated_total[j] -= alloc_row[j];
+                return_units((ResourceType)j, alloc_row[j]);
+                returned = true;
+            }
+        }
+        
+        // Drop from the safe sequence - remaining order stays safe
+        int pos = sequence_pos[row];
+        safe_sequence.erase(safe_sequence.begin() + pos);
+        for (int k = pos; k < (int)safe_sequence.size(); k++) {
+            sequence_pos[safe_sequence[k]] = k;
         }
+        
+        // Compact: move the last row into the hole
+        int last = num_flights - 1;
+        if (row != last) {
+            memcpy(row_of(max_need, row), row_of(max_need, last), RESOURCE_LANES * sizeof(int));
+            memcpy(row_of(allocation, row), row_of(allocation, last), RESOURCE_LANES * sizeof(int));
+            memcpy(row_of(need, row), row_of(need, last), RESOURCE_LANES * sizeof(int));
+            row_handle[row] = row_handle[last];
+            handle_row[row_handle[row]] = row;
+            sequence_pos[row] = sequence_pos[last];
+            safe_sequence[sequence_pos[row]] = row;
+        }
+        num_flights--;
+        max_need.resize((size_t)num_flights * RESOURCE_LANES);
+        allocation.resize((size_t)num_flights * RESOURCE_LANES);
+        need.resize((size_t)num_flights * RESOURCE_LANES);
+        row_handle.pop_back();
+        sequence_pos.pop_back();
+        
+        handle_row[flight_index] = -1;
+        free_handles.push_back(flight_index);
     }
     
     pthread_cond_broadcast(&resource_available);
     pthread_mutex_unlock(&manager_mutex);
+    if (returned) notify_release_listener();
 }
 
 bool ResourceManager::is_safe_state() {
-    // Banker's Algorithm safety check
-    vector<int> work = available;
-    vector<bool> finish(num_flights, false);
+    int work[RESOURCE_LANES];
+    load_available(work);
+    return complete_sequence(0, work);
+}
+
+bool ResourceManager::complete_sequence(int prefix, int* work) {
+    // Banker's Algorithm safety check. safe_sequence[0, prefix) is already
+    // known to finish with work accumulated; letting a flight finish never
+    // hurts, so the search continues from there. The old order is a good
+    // first guess for the rest, and each pass only revisits stuck flights.
+    full_checks++;
     
-    int count = 0;
-    while (count < num_flights) {
-        bool found = false;
-        
-        for (int i = 0; i < num_flights; i++) {
-            if (!finish[i]) {
-                // Check if need[i] <= work
-                bool can_finish = true;
-                for (int j = 0; j < num_resource_types; j++) {
-                    if (need[i][j] > work[j]) {
-                        can_finish = false;
-                        break;
-                    }
-                }
-                
-                if (can_finish) {
-                    // Simulate completion
-                    for (int j = 0; j < num_resource_types; j++) {
-                        work[j] += allocation[i][j];
-                    }
-                    finish[i] = true;
-                    found = true;
-                    count++;
-                }
+    vector<int> order(safe_sequence.begin(), safe_sequence.begin() + prefix);
+    vector<int> pending(safe_sequence.begin() + prefix, safe_sequence.end());
+    order.reserve(num_flights);
+    
+    while (!pending.empty()) {
+        size_t stuck = 0;
+        for (int i : pending) {
+            if (fits(row_of(need, i), work)) {
+                // Simulate completion
+                add_lanes(work, row_of(allocation, i));
+                order.push_back(i);
+            } else {
+                pending[stuck++] = i;
             }
         }
         
-        if (!found) {
+        if (stuck == pending.size()) {
             // No progress possible - unsafe state
             return false;
         }
+        pending.resize(stuck);
     }
     
+    // Remember the order for incremental checks
+    safe_sequence.swap(order);
+    for (int k = 0; k < num_flights; k++) {
+        sequence_pos[safe_sequence[k]] = k;
+    }
+    sequence_valid = true;
     return true;
 }
 
-bool ResourceManager::can_satisfy(int flight_index, const vector<int>& request) {
+bool ResourceManager::is_safe_after_grant(int row) {
+    // Granting to row only lowers work for the flights ordered before it
+    // (its own need drops by the same amount, later flights are unchanged),
+    // so re-checking that prefix proves the old sequence still safe.
+    if (!sequence_valid) {
+        return is_safe_state();
+    }
+    incremental_checks++;
+    
+    int work[RESOURCE_LANES];
+    load_available(work);
+    int pos = sequence_pos[row];
+    for (int k = 0; k < pos; k++) {
+        int i = safe_sequence[k];
+        if (!fits(row_of(need, i), work)) {
+            // Old order broke at k - search for a new one from there
+            sequence_valid = false;
+            return complete_sequence(k, work);
+        }
+        add_lanes(work, row_of(allocation, i));
+    }
+    return true;
+}
+
+bool ResourceManager::can_satisfy(int row, const vector<int>& request) {
     // Check if request <= need and request <= available
+    const int* need_row = row_of(need, row);
     for (int j = 0; j < num_resource_types; j++) {
-        if (request[j] > need[flight_index][j] || request[j] > available[j]) {
+        if (request[j] > need_row[j] || request[j] > available[j].load()) {
             return false;
         }
     }
@@ -161,32 +313,65 @@ bool ResourceManager::can_satisfy(int flight_index, const vector<int>& request)
 }
 
 bool ResourceManager::request_resources(int flight_index, ResourceType type, int count) {
+    if (type < 0 || type >= num_resource_types || count < 0) return false;
+    
+    vector<int> request(num_resource_types, 0);
+    request[type] = count;
+    return request_bundle(flight_index, request);
+}
+
+bool ResourceManager::request_bundle(int flight_index, const vector<int>& counts) {
+    if ((int)counts.size() > num_resource_types) return false;
+    vector<int> request(num_resource_types, 0);
+    for (size_t j = 0; j < counts.size(); j++) {
+        if (counts[j] < 0) return false;
+        request[j] = counts[j];
+    }
+    
     pthread_mutex_lock(&manager_mutex);
     
-    if (flight_index < 0 || flight_index >= (int)allocation.size()) {
+    if (flight_index < 0 || flight_index >= (int)handle_row.size() || handle_row[flight_index] < 0 ||
+        !can_satisfy(handle_row[flight_index], request)) {
         pthread_mutex_unlock(&manager_mutex);
         return false;
     }
+    int row = handle_row[flight_index];
     
-    vector<int> request(num_resource_types, 0);
-    request[type] = count;
-    
-    if (!can_satisfy(flight_index, request)) {
+    // Claim the units first - pools may take them concurrently
+    int claimed = 0;
+    for (; claimed < num_resource_types; claimed++) {
+        if (request[claimed] > 0 && !claim_units((ResourceType)claimed, request[claimed])) {
+            break;
+        }
+    }
+    if (claimed < num_resource_types) {
+        for (int j = 0; j < claimed; j++) {
+            return_units((ResourceType)j, request[j]);
+        }
         pthread_mutex_unlock(&manager_mutex);
         return false;
     }
     
-    // Temporarily allocate
-    available[type] -= count;
-    allocation[flight_index][type] += count;
-    need[flight_index][type] -= count;
+    // Temporarily allocate the whole bundle
+    int* alloc_row = row_of(allocation, row);
+    int* need_row = row_of(need, row);
+    for (int j = 0; j < num_resource_types; j++) {
+        allocated_total[j] += request[j];
+        alloc_row[j] += request[j];
+        need_row[j] -= request[j];
+    }
     
-    // Check if safe
-    if (!is_safe_state()) {
+    // Check if safe - the prefix argument holds for any request vector
+    if (!is_safe_after_grant(row)) {
         // Rollback
-        available[type] += count;
-        allocation[flight_index][type] -= count;
-        need[flight_index][type] += count;
+        for (int j = 0; j < num_resource_types; j++) {
+            allocated_total[j] -= request[j];
+            alloc_row[j] -= request[j];
+            need_row[j] += request[j];
+        }
+        for (int j = 0; j < num_resource_types; j++) {
+            return_units((ResourceType)j, request[j]);
+        }
         pthread_mutex_unlock(&manager_mutex);
         return false;
     }
@@ -196,66 +381,555 @@ bool ResourceManager::request_resources(int flight_index, ResourceType type, int
 }
 
 void ResourceManager::release_resources(int flight_index, ResourceType type, int count) {
+    int actual = 0;
     pthread_mutex_lock(&manager_mutex);
     
-    if (flight_index >= 0 && flight_index < (int)allocation.size()) {
-        int actual = min(count, allocation[flight_index][type]);
-        allocation[flight_index][type] -= actual;
-        available[type] += actual;
-        need[flight_index][type] += actual;
+    if (flight_index >= 0 && flight_index < (int)handle_row.size() && handle_row[flight_index] >= 0 &&
+        type >= 0 && type < num_resource_types && count > 0) {
+        // A release never breaks the safe sequence
+        int row = handle_row[flight_index];
+        actual = min(count, row_of(allocation, row)[type]);
+        row_of(allocation, row)[type] -= actual;
+        allocated_total[type] -= actual;
+        row_of(need, row)[type] += actual;
+        return_units(type, actual);
         
         pthread_cond_broadcast(&resource_available);
     }
     
     pthread_mutex_unlock(&manager_mutex);
+    if (actual > 0) notify_release_listener();
+}
+
+void ResourceManager::load_available(int* work) {
+    // Pool holders return without asking for more, so only Banker's grants
+    // count against the pool
+    for (int j = 0; j < RESOURCE_LANES; j++) {
+        work[j] = (int)pools[j].resources.size() - allocated_total[j];
+    }
+}
+
+bool ResourceManager::claim_units(ResourceType type, int count) {
+    int current = available[type].load();
+    while (current >= count) {
+        if (available[type].compare_exchange_weak(current, current - count)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResourceManager::return_units(ResourceType type, int count) {
+    if (count <= 0) return;
+    available[type] += count;
+    
+    // Units the Banker's side gave back may unblock queued threads
+    pthread_mutex_lock(&pools[type].lock);
+    hand_off_free_locked(type);
+    pthread_mutex_unlock(&pools[type].lock);
+    notify_bundle_waiters();
+}
+
+void ResourceManager::notify_release_listener() {
+    if (!listening.load()) return;
+    pthread_mutex_lock(&listener_mutex);
+    if (release_listener) release_listener(release_listener_arg);
+    pthread_mutex_unlock(&listener_mutex);
+}
+
+void ResourceManager::set_release_listener(void (*listener)(void*), void* arg) {
+    pthread_mutex_lock(&listener_mutex);
+    release_listener = listener;
+    release_listener_arg = arg;
+    listening = listener != nullptr;
+    pthread_mutex_unlock(&listener_mutex);
+}
+
+void ResourceManager::notify_bundle_waiters() {
+    bundle_generation++;
+    if (bundle_waiters.load() > 0) {
+        pthread_mutex_lock(&bundle_mutex);
+        pthread_cond_broadcast(&bundle_cond);
+        pthread_mutex_unlock(&bundle_mutex);
+    }
+}
+
+Resource* ResourceManager::take_free_locked(ResourceType type, int flight_id,
+                                            long long current_time, long long duration, bool claimed) {
+    ResourcePool& pool = pools[type];
+    if (pool.free_list.empty() || (!claimed && !claim_units(type, 1))) {
+        return nullptr;
+    }
+    
+    // Prefer an idle resource nobody has booked for this window; if every
+    // one is booked, take one anyway - its booking falls back at claim time
+    size_t pick = pool.free_list.size() - 1;
+    long long end = current_time + max(duration, 1LL);
+    for (size_t i = pool.free_list.size(); i-- > 0; ) {
+        if (pool.free_list[i]->get_calendar().is_free(current_time, end)) {
+            pick = i;
+            break;
+        }
+    }
+    
+    Resource* r = pool.free_list[pick];
+    pool.free_list[pick] = pool.free_list.back();
+    pool.free_list.pop_back();
+    r->try_acquire(flight_id, current_time, duration);
+    return r;
+}
+
+bool ResourceManager::take_specific_locked(Resource* resource, int flight_id,
+                                           long long current_time, long long duration) {
+    vector<Resource*>& free_list = pools[resource->get_type()].free_list;
+    auto it = find(free_list.begin(), free_list.end(), resource);
+    if (it == free_list.end() || !claim_units(resource->get_type(), 1)) {
+        return false;
+    }
+    
+    *it = free_list.back();
+    free_list.pop_back();
+    resource->try_acquire(flight_id, current_time, duration);
+    return true;
+}
+
+void ResourceManager::hand_off_free_locked(ResourceType type) {
+    ResourcePool& pool = pools[type];
+    while (!pool.waiters.empty() && !pool.free_list.empty() && claim_units(type, 1)) {
+        ResourceWaiter* waiter = pool.waiters.front();
+        pool.waiters.pop_front();
+        Resource* r = pool.free_list.back();
+        pool.free_list.pop_back();
+        r->try_acquire(waiter->flight_id, waiter->current_time, waiter->duration);
+        waiter->granted = r;
+        pthread_cond_signal(&waiter->wake);
+    }
 }
 
 Resource* ResourceManager::allocate_resource(ResourceType type, int flight_id,
                                               long long current_time, long long duration) {
-    pthread_mutex_lock(&manager_mutex);
+    if (type < 0 || type >= num_resource_types) return nullptr;
     
-    auto it = resource_pools.find(type);
-    if (it == resource_pools.end()) {
-        pthread_mutex_unlock(&manager_mutex);
-        return nullptr;
+    ResourcePool& pool = pools[type];
+    pthread_mutex_lock(&pool.lock);
+    
+    // Never barge past queued threads
+    Resource* r = nullptr;
+    if (pool.waiters.empty()) {
+        r = take_free_locked(type, flight_id, current_time, duration);
+    }
+    
+    pthread_mutex_unlock(&pool.lock);
+    if (profiler) {
+        if (r) profiler->record_acquire(type, 0);
+        else profiler->record_busy(type);
+    }
+    return r;
+}
+
+Resource* ResourceManager::acquire_resource(ResourceType type, int flight_id, long long current_time,
+                                             long long duration, int priority, long long timeout_ms) {
+    if (type < 0 || type >= num_resource_types) return nullptr;
+    
+    ResourcePool& pool = pools[type];
+    pthread_mutex_lock(&pool.lock);
+    
+    Resource* r = nullptr;
+    if (pool.waiters.empty()) {
+        r = take_free_locked(type, flight_id, current_time, duration);
+    }
+    if (r || timeout_ms == 0) {
+        record_wait_locked(type, false, r != nullptr, 0);
+        pthread_mutex_unlock(&pool.lock);
+        return r;
     }
     
-    for (Resource* r : it->second) {
-        if (r->try_acquire(flight_id, current_time, duration)) {
-            available[type]--;
-            pthread_mutex_unlock(&manager_mutex);
-            return r;
+    auto start = chrono::steady_clock::now();
+    
+    ResourceWaiter waiter;
+    waiter.flight_id = flight_id;
+    waiter.priority = priority;
+    waiter.current_time = current_time;
+    waiter.duration = duration;
+    waiter.granted = nullptr;
+    pthread_cond_init(&waiter.wake, &wait_condattr);
+    
+    // Behind every waiter of equal or more urgent priority
+    list<ResourceWaiter*>& queue = pool.waiters;
+    auto pos = queue.begin();
+    while (pos != queue.end() && (*pos)->priority <= priority) {
+        ++pos;
+    }
+    auto self = queue.insert(pos, &waiter);
+    
+    struct timespec deadline;
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
         }
     }
     
-    pthread_mutex_unlock(&manager_mutex);
-    return nullptr;
+    while (waiter.granted == nullptr) {
+        int result = (timeout_ms > 0)
+            ? pthread_cond_timedwait(&waiter.wake, &pool.lock, &deadline)
+            : pthread_cond_wait(&waiter.wake, &pool.lock);
+        if (result == ETIMEDOUT && waiter.granted == nullptr) {
+            queue.erase(self);
+            break;
+        }
+    }
+    
+    long long wait_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count();
+    record_wait_locked(type, true, waiter.granted != nullptr, wait_ns);
+    
+    pthread_cond_destroy(&waiter.wake);
+    pthread_mutex_unlock(&pool.lock);
+    return waiter.granted;
+}
+
+void ResourceManager::record_wait_locked(ResourceType type, bool queued, bool acquired, long long wait_ns) {
+    ResourceWaitStats& stats = pools[type].stats;
+    if (acquired) {
+        stats.acquisitions++;
+        if (profiler) profiler->record_acquire(type, wait_ns);
+    } else if (queued) {
+        stats.timeouts++;
+    } else if (profiler) {
+        profiler->record_busy(type);    // Non-blocking try
+    }
+    if (queued) {
+        stats.waited++;
+        stats.total_wait_ns += wait_ns;
+        stats.max_wait_ns = max(stats.max_wait_ns, wait_ns);
+    }
 }
 
 void ResourceManager::release_resource(Resource* resource) {
     if (resource == nullptr) return;
     
-    pthread_mutex_lock(&manager_mutex);
-    
     ResourceType type = resource->get_type();
+    ResourcePool& pool = pools[type];
+    pthread_mutex_lock(&pool.lock);
+    
+    if (profiler) profiler->record_release(type, resource->get_held_ns());
     resource->release();
-    available[type]++;
     
-    pthread_cond_broadcast(&resource_available);
-    pthread_mutex_unlock(&manager_mutex);
+    if (!pool.waiters.empty()) {
+        // Direct hand-off: the resource never becomes free, so nobody can
+        // barge past the waiter between the release and its wake-up
+        ResourceWaiter* waiter = pool.waiters.front();
+        pool.waiters.pop_front();
+        resource->try_acquire(waiter->flight_id, waiter->current_time, waiter->duration);
+        waiter->granted = resource;
+        pthread_cond_signal(&waiter->wake);
+    } else {
+        pool.free_list.push_back(resource);
+        available[type]++;
+    }
+    
+    pthread_mutex_unlock(&pool.lock);
+    notify_bundle_waiters();
+    notify_release_listener();
+}
+
+bool ResourceManager::take_bundle(int flight_index, vector<int>& missing, bool reserve_partial, int flight_id,
+                                  long long current_time, long long duration, vector<Resource*>& held) {
+    // Queued single-resource waiters go first
+    bool queued[RESOURCE_LANES] = {false};
+    bool any_queued = false;
+    for (int j = 0; j < num_resource_types; j++) {
+        if (missing[j] > 0) {
+            pthread_mutex_lock(&pools[j].lock);
+            queued[j] = !pools[j].waiters.empty();
+            pthread_mutex_unlock(&pools[j].lock);
+            any_queued |= queued[j];
+        }
+    }
+    
+    // Units are granted (claimed and charged to the row) by the Banker's side
+    vector<int> granted(num_resource_types, 0);
+    if (!reserve_partial) {
+        if (any_queued || !request_bundle(flight_index, missing)) {
+            return false;
+        }
+        granted = missing;
+    } else {
+        // One unit at a time, so each held unit is safety-checked on its own
+        for (int j = 0; j < num_resource_types; j++) {
+            while (!queued[j] && granted[j] < missing[j] &&
+                   request_resources(flight_index, (ResourceType)j, 1)) {
+                granted[j]++;
+            }
+        }
+    }
+    
+    // A granted unit is still on the free list - nobody else may take it
+    for (int j = 0; j < num_resource_types; j++) {
+        if (granted[j] == 0) continue;
+        pthread_mutex_lock(&pools[j].lock);
+        for (int k = 0; k < granted[j]; k++) {
+            held.push_back(take_free_locked((ResourceType)j, flight_id, current_time, duration, true));
+        }
+        pthread_mutex_unlock(&pools[j].lock);
+        missing[j] -= granted[j];
+    }
+    
+    for (int j = 0; j < num_resource_types; j++) {
+        if (missing[j] > 0) return false;
+    }
+    return true;
+}
+
+bool ResourceManager::acquire_bundle(int flight_index, const vector<int>& counts, int flight_id,
+                                     long long current_time, long long duration, long long timeout_ms,
+                                     bool reserve_partial, vector<Resource*>& bundle) {
+    bundle.clear();
+    if ((int)counts.size() > num_resource_types) return false;
+    vector<int> missing(num_resource_types, 0);
+    for (size_t j = 0; j < counts.size(); j++) {
+        if (counts[j] < 0) return false;
+        missing[j] = counts[j];
+    }
+    
+    auto start = chrono::steady_clock::now();
+    
+    struct timespec deadline;
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+    
+    // Registered before the first attempt so a release in between is not missed
+    bundle_waiters++;
+    
+    bool complete = false;
+    while (true) {
+        long long seen = bundle_generation.load();
+        complete = take_bundle(flight_index, missing, reserve_partial, flight_id, current_time, duration, bundle);
+        if (complete || timeout_ms == 0) break;
+        
+        // Sleep until something came back since the attempt began
+        int result = 0;
+        pthread_mutex_lock(&bundle_mutex);
+        while (bundle_generation.load() == seen && result != ETIMEDOUT) {
+            result = (timeout_ms > 0)
+                ? pthread_cond_timedwait(&bundle_cond, &bundle_mutex, &deadline)
+                : pthread_cond_wait(&bundle_cond, &bundle_mutex);
+        }
+        pthread_mutex_unlock(&bundle_mutex);
+        if (result == ETIMEDOUT) {
+            complete = take_bundle(flight_index, missing, reserve_partial, flight_id, current_time,
+                                   duration, bundle);
+            break;
+        }
+    }
+    
+    bundle_waiters--;
+    long long wait_ns = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - start).count();
+    pthread_mutex_lock(&bundle_mutex);
+    if (complete) {
+        bundle_stats.granted++;
+        bundle_stats.total_wait_ns += wait_ns;
+    } else {
+        bundle_stats.timeouts++;
+        if (!bundle.empty()) bundle_stats.reservations_expired++;
+    }
+    pthread_mutex_unlock(&bundle_mutex);
+    
+    if (complete && profiler) {
+        for (Resource* r : bundle) profiler->record_acquire(r->get_type(), wait_ns);
+    } else if (timeout_ms == 0 && profiler) {
+        for (int j = 0; j < num_resource_types; j++) {
+            if (missing[j] > 0) profiler->record_busy((ResourceType)j);
+        }
+    }
+    if (!complete) {
+        // Reservation deadline passed - give back the partial bundle
+        release_bundle(flight_index, bundle);
+    }
+    return complete;
+}
+
+void ResourceManager::release_bundle(int flight_index, vector<Resource*>& bundle) {
+    // Resources go back on the free lists still claimed; returning their
+    // units through the row then hands them to queued threads
+    int returned[RESOURCE_LANES] = {0};
+    for (Resource* r : bundle) {
+        ResourceType type = r->get_type();
+        pthread_mutex_lock(&pools[type].lock);
+        if (profiler) profiler->record_release(type, r->get_held_ns());
+        r->release();
+        pools[type].free_list.push_back(r);
+        pthread_mutex_unlock(&pools[type].lock);
+        returned[type]++;
+    }
+    for (int j = 0; j < num_resource_types; j++) {
+        if (returned[j] > 0) {
+            release_resources(flight_index, (ResourceType)j, returned[j]);
+        }
+    }
+    bundle.clear();
+}
+
+// ========== Reservation calendar ==========
+
+bool ResourceManager::book_resource(ResourceType type, int flight_id, long long current_time,
+                                    long long earliest_start, long long duration, long long latest_start,
+                                    ResourceBooking& booking) {
+    booking.resource = nullptr;
+    booking.start = booking.end = 0;
+    booking.flight_id = flight_id;
+    if (type < 0 || type >= num_resource_types || duration <= 0) return false;
+    
+    ResourcePool& pool = pools[type];
+    pthread_mutex_lock(&pool.lock);
+    
+    // The resource whose calendar opens up first wins
+    Resource* best = nullptr;
+    long long best_start = 0;
+    for (Resource* r : pool.resources) {
+        ResourceCalendar& calendar = r->get_calendar();
+        calendar.prune(current_time);
+        long long start = calendar.earliest_free(earliest_start, duration);
+        if (start <= latest_start && (best == nullptr || start < best_start)) {
+            best = r;
+            best_start = start;
+        }
+    }
+    
+    if (best) {
+        best->get_calendar().book(best_start, best_start + duration, flight_id);
+        booking.resource = best;
+        booking.start = best_start;
+        booking.end = best_start + duration;
+        pool.booking_stats.booked++;
+    } else {
+        pool.booking_stats.rejected++;
+    }
+    
+    pthread_mutex_unlock(&pool.lock);
+    return best != nullptr;
+}
+
+void ResourceManager::cancel_booking(ResourceBooking& booking) {
+    if (booking.resource == nullptr) return;
+    
+    ResourcePool& pool = pools[booking.resource->get_type()];
+    pthread_mutex_lock(&pool.lock);
+    if (booking.resource->get_calendar().cancel(booking.start, booking.flight_id)) {
+        pool.booking_stats.cancelled++;
+    }
+    pthread_mutex_unlock(&pool.lock);
+    booking.resource = nullptr;
+}
+
+Resource* ResourceManager::claim_booking(ResourceBooking& booking, long long current_time, long long duration,
+                                         int priority, long long timeout_ms) {
+    Resource* booked = booking.resource;
+    if (booked == nullptr) return nullptr;
+    booking.resource = nullptr;
+    
+    ResourceType type = booked->get_type();
+    ResourcePool& pool = pools[type];
+    pthread_mutex_lock(&pool.lock);
+    
+    // The window was planned for this flight, so it goes ahead of the queue
+    booked->get_calendar().cancel(booking.start, booking.flight_id);
+    bool taken = take_specific_locked(booked, booking.flight_id, current_time, duration);
+    if (taken) {
+        pool.booking_stats.claimed++;
+        record_wait_locked(type, false, true, 0);
+    } else {
+        pool.booking_stats.missed++;
+    }
+    
+    pthread_mutex_unlock(&pool.lock);
+    
+    if (taken) return booked;
+    return acquire_resource(type, booking.flight_id, current_time, duration, priority, timeout_ms);
+}
+
+long long ResourceManager::get_earliest_slot(ResourceType type, long long earliest_start, long long duration) {
+    if (type < 0 || type >= num_resource_types) return -1;
+    
+    pthread_mutex_lock(&pools[type].lock);
+    long long best = -1;
+    for (Resource* r : pools[type].resources) {
+        long long start = r->get_calendar().earliest_free(earliest_start, duration);
+        if (best < 0 || start < best) best = start;
+    }
+    pthread_mutex_unlock(&pools[type].lock);
+    return best;
+}
+
+BookingStats ResourceManager::get_booking_stats(ResourceType type) {
+    BookingStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (type < 0 || type >= num_resource_types) return stats;
+    
+    pthread_mutex_lock(&pools[type].lock);
+    stats = pools[type].booking_stats;
+    pthread_mutex_unlock(&pools[type].lock);
+    return stats;
 }
 
 int ResourceManager::get_available_count(ResourceType type) {
-    pthread_mutex_lock(&manager_mutex);
-    int count = available[type];
-    pthread_mutex_unlock(&manager_mutex);
-    return count;
+    if (type < 0 || type >= num_resource_types) return 0;
+    return available[type].load();
 }
 
 int ResourceManager::get_total_count(ResourceType type) {
+    if (type < 0 || type >= num_resource_types) return 0;
+    pthread_mutex_lock(&pools[type].lock);
+    int count = pools[type].resources.size();
+    pthread_mutex_unlock(&pools[type].lock);
+    return count;
+}
+
+int ResourceManager::get_waiting_count(ResourceType type) {
+    if (type < 0 || type >= num_resource_types) return 0;
+    pthread_mutex_lock(&pools[type].lock);
+    int count = pools[type].waiters.size();
+    pthread_mutex_unlock(&pools[type].lock);
+    return count;
+}
+
+ResourceWaitStats ResourceManager::get_wait_stats(ResourceType type) {
+    ResourceWaitStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (type < 0 || type >= num_resource_types) return stats;
+    
+    pthread_mutex_lock(&pools[type].lock);
+    stats = pools[type].stats;
+    pthread_mutex_unlock(&pools[type].lock);
+    
+    stats.average_wait_us = stats.waited > 0 ? stats.total_wait_ns / 1000.0 / stats.waited : 0.0;
+    return stats;
+}
+
+BundleStats ResourceManager::get_bundle_stats() {
+    pthread_mutex_lock(&bundle_mutex);
+    BundleStats stats = bundle_stats;
+    pthread_mutex_unlock(&bundle_mutex);
+    
+    stats.average_wait_us = stats.granted > 0 ? stats.total_wait_ns / 1000.0 / stats.granted : 0.0;
+    return stats;
+}
+
+int ResourceManager::get_registered_flights() {
     pthread_mutex_lock(&manager_mutex);
-    auto it = resource_pools.find(type);
-    int count = (it != resource_pools.end()) ? it->second.size() : 0;
+    int count = num_flights;
     pthread_mutex_unlock(&manager_mutex);
     return count;
 }
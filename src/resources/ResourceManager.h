@@ -2,35 +2,177 @@
 #define RESOURCE_MANAGER_H
 
 #include "Resource.h"
+#include "ResourceProfiler.h"
 #include <vector>
-#include <unordered_map>
+#include <list>
+#include <atomic>
 #include <pthread.h>
 
 using namespace std;
 
 // ResourceManager implements Banker's Algorithm for deadlock-free allocation
 // Manages 7 resource types from README
+//
+// Each resource type has its own pool with its own lock and free list, so
+// fuel-truck contention never blocks catering allocation. The Banker's state
+// has a separate lock and only touches a pool to hand out returned units.
+//
+// Banker's matrices are stored as flat row-major arrays, one row of
+// RESOURCE_LANES ints per registered flight. Retired flights are compacted
+// out (last row moves into the hole), so the scan only covers live flights.
+// The last proven safe sequence is kept and re-verified incrementally: a
+// grant only shrinks work for flights ordered before the requester, so only
+// that prefix is re-checked; the full algorithm runs only if it fails.
+//
+// Units taken straight from a pool (allocate/acquire_resource, bookings)
+// have no Banker's row. Their holders ask for nothing more before releasing,
+// so the safety check counts them as returnable: its work vector is the
+// pool size minus Banker's allocations, which only changes under
+// manager_mutex, and pool traffic never touches the safe sequence.
+
+// A thread blocked in acquire_resource (lives on the waiter's stack).
+// Releasing threads hand resources straight to the first waiter.
+struct ResourceWaiter {
+    int flight_id;
+    int priority;           // 0 = Emergency .. 100 = Low, as Flight::priority
+    long long current_time;
+    long long duration;
+    Resource* granted;      // Set by the releasing thread
+    pthread_cond_t wake;
+};
+
+// Per-type wait statistics for acquire_resource
+struct ResourceWaitStats {
+    long long acquisitions;     // Successful acquire_resource calls
+    long long waited;           // Calls that had to queue
+    long long timeouts;
+    long long total_wait_ns;
+    long long max_wait_ns;
+    double average_wait_us;     // Over calls that queued
+};
+
+// Statistics for acquire_bundle
+struct BundleStats {
+    long long granted;
+    long long timeouts;
+    long long reservations_expired;  // Partial bundles returned at the deadline
+    long long total_wait_ns;
+    double average_wait_us;          // Over granted bundles
+};
+
+// A time window booked on one resource with book_resource
+struct ResourceBooking {
+    Resource* resource;     // nullptr if nothing could be booked
+    long long start;
+    long long end;          // Exclusive
+    int flight_id;
+};
+
+// Per-type booking statistics
+struct BookingStats {
+    long long booked;
+    long long rejected;     // No resource free before latest_start
+    long long claimed;      // Booked resource was idle at claim time
+    long long missed;       // Booked resource still busy - fell back to the queue
+    long long cancelled;
+};
+
+// One resource type's pool. Aligned so neighbouring pools' locks do not
+// share a cache line.
+struct alignas(64) ResourcePool {
+    pthread_mutex_t lock;
+    vector<Resource*> resources;    // Every resource of this type
+    vector<Resource*> free_list;    // Idle resources, used as a stack
+    list<ResourceWaiter*> waiters;  // Ordered by priority then arrival (FIFO)
+    ResourceWaitStats stats;
+    BookingStats booking_stats;
+};
 
 class ResourceManager {
+public:
+    static constexpr int RESOURCE_LANES = 8;  // 7 types padded for vector compares
+    
 private:
-    // Resource pools by type
-    unordered_map<ResourceType, vector<Resource*>> resource_pools;
+    // Resource pools by type (pool lock guards everything in the pool)
+    ResourcePool pools[RESOURCE_LANES];
+    
+    // Available[j] = units of type j neither held nor granted by Banker's.
+    // Atomic so pools and the Banker's check can claim units under their
+    // own locks.
+    atomic<int> available[RESOURCE_LANES];
     
-    // Banker's Algorithm matrices
-    vector<int> available;          // Available[j] = # of resource type j available
-    vector<vector<int>> max_need;   // Max[i][j] = max demand of flight i for type j
-    vector<vector<int>> allocation; // Allocation[i][j] = currently allocated
-    vector<vector<int>> need;       // Need[i][j] = Max[i][j] - Allocation[i][j]
+    // Banker's Algorithm matrices (flat, row = flight slot)
+    vector<int> max_need;           // Max[i][j] = max demand of flight i for type j
+    vector<int> allocation;         // Allocation[i][j] = currently allocated
+    vector<int> need;               // Need[i][j] = Max[i][j] - Allocation[i][j]
+    vector<int> allocated_total;    // Column sums of allocation
     
     int num_resource_types;
-    int num_flights;
+    int num_flights;                // Live rows
     
-    pthread_mutex_t manager_mutex;
+    // Flight handles stay stable while rows are compacted
+    vector<int> handle_row;         // Handle -> row (-1 if retired)
+    vector<int> row_handle;         // Row -> handle
+    vector<int> free_handles;
+    
+    // Last safe sequence (a permutation of the live rows)
+    vector<int> safe_sequence;
+    vector<int> sequence_pos;       // Row -> position in safe_sequence
+    bool sequence_valid;            // Sequence proven safe for current state
+    
+    long long incremental_checks;
+    long long full_checks;
+    
+    pthread_condattr_t wait_condattr;   // Waiter conds use CLOCK_MONOTONIC
+    
+    // Bundle waiters sleep on one condition, broadcast when idle resources
+    // come back; bundle_generation counts those returns so a waiter that
+    // tried while one happened does not sleep through it. Waiters hold no
+    // other lock. Lock order: manager_mutex, bundle_mutex, pool locks by type.
+    pthread_mutex_t bundle_mutex;
+    pthread_cond_t bundle_cond;
+    atomic<int> bundle_waiters;
+    atomic<long long> bundle_generation;
+    BundleStats bundle_stats;
+    
+    ResourceProfiler* profiler;     // Not owned; nullptr when not profiling
+    
+    // Called after a holder gives resources back (not on failed grants),
+    // with no ResourceManager lock held but listener_mutex. Releases skip
+    // the lock while nothing listens.
+    pthread_mutex_t listener_mutex;
+    atomic<bool> listening;
+    void (*release_listener)(void*);
+    void* release_listener_arg;
+    
+    pthread_mutex_t manager_mutex;  // Banker's state only, safe sequence included
     pthread_cond_t resource_available;
     
-    // Banker's algorithm helpers
+    // Banker's algorithm helpers (caller holds manager_mutex)
     bool is_safe_state();
-    bool can_satisfy(int flight_index, const vector<int>& request);
+    bool complete_sequence(int prefix, int* work);
+    bool is_safe_after_grant(int row);
+    bool can_satisfy(int row, const vector<int>& request);
+    void load_available(int* work);
+    
+    // Pool helpers (caller holds the pool lock)
+    bool claim_units(ResourceType type, int count);   // Lock-free
+    // claimed: the unit is already claimed by a Banker's grant
+    Resource* take_free_locked(ResourceType type, int flight_id,
+                               long long current_time, long long duration, bool claimed = false);
+    bool take_specific_locked(Resource* resource, int flight_id,
+                              long long current_time, long long duration);
+    void hand_off_free_locked(ResourceType type);
+    void record_wait_locked(ResourceType type, bool queued, bool acquired, long long wait_ns);
+    void return_units(ResourceType type, int count);
+    void notify_bundle_waiters();
+    void notify_release_listener();
+    
+    // Grant what is missing through the Banker's check, then take the
+    // granted resources from the pools (caller holds no lock)
+    bool take_bundle(int flight_index, vector<int>& missing, bool reserve_partial, int flight_id,
+                     long long current_time, long long duration, vector<Resource*>& held);
+    int* row_of(vector<int>& matrix, int row) { return &matrix[(size_t)row * RESOURCE_LANES]; }
     
 public:
     ResourceManager();
@@ -46,6 +188,9 @@ public:
     
     // Request resources (Banker's algorithm)
     bool request_resources(int flight_index, ResourceType type, int count);
+    // counts[type] units of several types at once - granted all-or-nothing,
+    // with the safety check applied to the whole bundle
+    bool request_bundle(int flight_index, const vector<int>& counts);
     
     // Release resources
     void release_resources(int flight_index, ResourceType type, int count);
@@ -55,10 +200,61 @@ public:
                                  long long current_time, long long duration);
     void release_resource(Resource* resource);
     
+    // Blocking allocation: queue behind earlier/higher-priority waiters and
+    // take a released resource by direct hand-off. timeout_ms < 0 waits
+    // forever, 0 never waits. Returns nullptr on timeout.
+    Resource* acquire_resource(ResourceType type, int flight_id, long long current_time,
+                               long long duration, int priority, long long timeout_ms);
+    
+    // Turnaround bundle: counts[type] resources of each type, all-or-nothing,
+    // so nothing sits idle while the rest is awaited. The bundle is granted
+    // to the registered flight_index through request_bundle, so it passes
+    // the Banker's safety check and counts against the flight's max demand.
+    // With reserve_partial, idle resources are granted one at a time as they
+    // come free and all are returned if the bundle is still incomplete at
+    // the timeout (the reservation deadline).
+    bool acquire_bundle(int flight_index, const vector<int>& counts, int flight_id, long long current_time,
+                        long long duration, long long timeout_ms, bool reserve_partial,
+                        vector<Resource*>& bundle);
+    // Return a bundle's resources and their units to flight_index's row
+    // (before unregistering it)
+    void release_bundle(int flight_index, vector<Resource*>& bundle);
+    
+    // Reservation calendar: book the resource of this type that is free
+    // earliest in [earliest_start, latest_start] for duration time units.
+    // Unbooked allocations avoid booked windows while any other resource
+    // of the type is idle. Returns false if no resource has such a slot.
+    bool book_resource(ResourceType type, int flight_id, long long current_time,
+                       long long earliest_start, long long duration, long long latest_start,
+                       ResourceBooking& booking);
+    void cancel_booking(ResourceBooking& booking);
+    // Take the booked resource if it is idle, otherwise queue for any
+    // resource of the type as acquire_resource does. The booking is spent.
+    Resource* claim_booking(ResourceBooking& booking, long long current_time, long long duration,
+                            int priority, long long timeout_ms);
+    // Earliest start >= earliest_start at which some resource is free
+    long long get_earliest_slot(ResourceType type, long long earliest_start, long long duration);
+    
+    // Feed acquisitions and releases to a profiler (nullptr detaches)
+    void attach_profiler(ResourceProfiler* p) { profiler = p; }
+    // Call listener(arg) whenever resources are released (nullptr detaches;
+    // no call is in progress once this returns)
+    void set_release_listener(void (*listener)(void*), void* arg);
+    
     // Statistics
     int get_available_count(ResourceType type);
     int get_total_count(ResourceType type);
     double get_utilization(ResourceType type);
+    
+    int get_waiting_count(ResourceType type);
+    ResourceWaitStats get_wait_stats(ResourceType type);
+    BundleStats get_bundle_stats();
+    BookingStats get_booking_stats(ResourceType type);
+    
+    // Banker's bookkeeping
+    int get_registered_flights();
+    long long get_incremental_checks() const { return incremental_checks; }
+    long long get_full_checks() const { return full_checks; }
 };
 
 #endif // RESOURCE_MANAGER_H
@@ -0,0 +1,196 @@
+#include "ResourceProfiler.h"
+#include "ResourceManager.h"
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+ResourceProfiler::ResourceProfiler(int types, long long width) {
+    num_types = min(max(types, 1), MAX_TYPES);
+    bucket_width = max(width, 1LL);
+    latest_bucket = -1;
+    pthread_mutex_init(&profiler_mutex, nullptr);
+    
+    ProfileBucket empty;
+    memset(&empty, 0, sizeof(empty));
+    empty.start_time = -1;
+    for (int t = 0; t < MAX_TYPES; t++) {
+        counters[t].acquisitions = 0;
+        counters[t].busy_attempts = 0;
+        counters[t].total_wait_ns = 0;
+        counters[t].max_wait_ns = 0;
+        counters[t].releases = 0;
+        counters[t].total_hold_ns = 0;
+        rings[t].assign(RING_BUCKETS, empty);
+    }
+}
+
+ResourceProfiler::~ResourceProfiler() {
+    pthread_mutex_destroy(&profiler_mutex);
+}
+
+void ResourceProfiler::record_acquire(ResourceType type, long long wait_ns) {
+    if (type < 0 || type >= num_types) return;
+    ProfileCounters& c = counters[type];
+    c.acquisitions.fetch_add(1, memory_order_relaxed);
+    if (wait_ns > 0) {
+        c.total_wait_ns.fetch_add(wait_ns, memory_order_relaxed);
+        long long current = c.max_wait_ns.load(memory_order_relaxed);
+        while (wait_ns > current &&
+               !c.max_wait_ns.compare_exchange_weak(current, wait_ns, memory_order_relaxed)) {
+        }
+    }
+}
+
+void ResourceProfiler::record_release(ResourceType type, long long hold_ns) {
+    if (type < 0 || type >= num_types) return;
+    counters[type].releases.fetch_add(1, memory_order_relaxed);
+    counters[type].total_hold_ns.fetch_add(hold_ns, memory_order_relaxed);
+}
+
+void ResourceProfiler::record_busy(ResourceType type) {
+    if (type < 0 || type >= num_types) return;
+    counters[type].busy_attempts.fetch_add(1, memory_order_relaxed);
+}
+
+ProfileBucket& ResourceProfiler::bucket_locked(int type, long long start_time) {
+    ProfileBucket& bucket = rings[type][(start_time / bucket_width) % RING_BUCKETS];
+    if (bucket.start_time != start_time) {
+        // Slot still holds a bucket from one lap ago - reuse it
+        memset(&bucket, 0, sizeof(bucket));
+        bucket.start_time = start_time;
+    }
+    return bucket;
+}
+
+void ResourceProfiler::sample(ResourceManager* manager, long long current_time) {
+    if (current_time < 0) current_time = 0;
+    long long start_time = current_time - current_time % bucket_width;
+    
+    pthread_mutex_lock(&profiler_mutex);
+    latest_bucket = max(latest_bucket, start_time);
+    
+    for (int t = 0; t < num_types; t++) {
+        ResourceType type = (ResourceType)t;
+        ProfileBucket& bucket = bucket_locked(t, start_time);
+        
+        int queue = manager->get_waiting_count(type);
+        bucket.samples++;
+        bucket.utilization_sum += manager->get_utilization(type);
+        bucket.queue_sum += queue;
+        bucket.queue_max = max(bucket.queue_max, queue);
+        
+        ProfileCounters& c = counters[t];
+        bucket.acquisitions += c.acquisitions.exchange(0, memory_order_relaxed);
+        bucket.busy_attempts += c.busy_attempts.exchange(0, memory_order_relaxed);
+        bucket.total_wait_ns += c.total_wait_ns.exchange(0, memory_order_relaxed);
+        bucket.max_wait_ns = max(bucket.max_wait_ns, c.max_wait_ns.exchange(0, memory_order_relaxed));
+        bucket.releases += c.releases.exchange(0, memory_order_relaxed);
+        bucket.total_hold_ns += c.total_hold_ns.exchange(0, memory_order_relaxed);
+    }
+    
+    pthread_mutex_unlock(&profiler_mutex);
+}
+
+ResourceProfileSummary ResourceProfiler::get_summary(ResourceType type, int last_buckets) {
+    ResourceProfileSummary summary;
+    memset(&summary, 0, sizeof(summary));
+    if (type < 0 || type >= num_types) return summary;
+    last_buckets = min(max(last_buckets, 1), RING_BUCKETS);
+    
+    pthread_mutex_lock(&profiler_mutex);
+    
+    int samples = 0;
+    long long queue_sum = 0, total_wait_ns = 0, max_wait_ns = 0, releases = 0, total_hold_ns = 0;
+    double utilization_sum = 0.0;
+    long long oldest = latest_bucket - (last_buckets - 1) * bucket_width;
+    
+    for (const ProfileBucket& b : rings[type]) {
+        if (b.start_time < 0 || b.start_time < oldest || b.start_time > latest_bucket) continue;
+        samples += b.samples;
+        utilization_sum += b.utilization_sum;
+        queue_sum += b.queue_sum;
+        summary.max_queue = max(summary.max_queue, b.queue_max);
+        summary.acquisitions += b.acquisitions;
+        summary.busy_attempts += b.busy_attempts;
+        total_wait_ns += b.total_wait_ns;
+        max_wait_ns = max(max_wait_ns, b.max_wait_ns);
+        releases += b.releases;
+        total_hold_ns += b.total_hold_ns;
+    }
+    
+    pthread_mutex_unlock(&profiler_mutex);
+    
+    if (samples > 0) {
+        summary.utilization = utilization_sum / samples;
+        summary.average_queue = (double)queue_sum / samples;
+    }
+    if (summary.acquisitions > 0) {
+        summary.average_wait_us = total_wait_ns / 1000.0 / summary.acquisitions;
+    }
+    summary.max_wait_us = max_wait_ns / 1000.0;
+    if (releases > 0) {
+        summary.average_hold_ms = total_hold_ns / 1e6 / releases;
+    }
+    return summary;
+}
+
+int ResourceProfiler::get_bottleneck(int last_buckets) {
+    int worst = -1;
+    ResourceProfileSummary worst_summary;
+    memset(&worst_summary, 0, sizeof(worst_summary));
+    
+    for (int t = 0; t < num_types; t++) {
+        ResourceProfileSummary s = get_summary((ResourceType)t, last_buckets);
+        if (s.average_queue == 0.0 && s.busy_attempts == 0 && s.utilization == 0.0) continue;
+        bool busier = s.average_queue > worst_summary.average_queue ||
+                      (s.average_queue == worst_summary.average_queue &&
+                       (s.busy_attempts > worst_summary.busy_attempts ||
+                        (s.busy_attempts == worst_summary.busy_attempts &&
+                         s.utilization > worst_summary.utilization)));
+        if (worst < 0 || busier) {
+            worst = t;
+            worst_summary = s;
+        }
+    }
+    return worst;
+}
+
+bool ResourceProfiler::export_csv(const string& path) {
+    ofstream out(path, ios::out | ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    
+    out << "type,bucket_start,utilization,avg_queue,max_queue,acquisitions,"
+           "busy_attempts,avg_wait_us,max_wait_us,releases,avg_hold_ms\n";
+    
+    pthread_mutex_lock(&profiler_mutex);
+    for (int t = 0; t < num_types; t++) {
+        // Oldest bucket first
+        vector<const ProfileBucket*> buckets;
+        for (const ProfileBucket& b : rings[t]) {
+            if (b.start_time >= 0 && b.samples > 0) buckets.push_back(&b);
+        }
+        sort(buckets.begin(), buckets.end(),
+             [](const ProfileBucket* a, const ProfileBucket* b) { return a->start_time < b->start_time; });
+        
+        for (const ProfileBucket* b : buckets) {
+            out << Resource::type_to_string((ResourceType)t) << ","
+                << b->start_time << ","
+                << b->utilization_sum / b->samples << ","
+                << (double)b->queue_sum / b->samples << ","
+                << b->queue_max << ","
+                << b->acquisitions << ","
+                << b->busy_attempts << ","
+                << (b->acquisitions > 0 ? b->total_wait_ns / 1000.0 / b->acquisitions : 0.0) << ","
+                << b->max_wait_ns / 1000.0 << ","
+                << b->releases << ","
+                << (b->releases > 0 ? b->total_hold_ns / 1e6 / b->releases : 0.0) << "\n";
+        }
+    }
+    pthread_mutex_unlock(&profiler_mutex);
+    
+    return out.good();
+}
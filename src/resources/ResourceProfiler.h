@@ -0,0 +1,110 @@
+#ifndef RESOURCE_PROFILER_H
+#define RESOURCE_PROFILER_H
+
+#include "Resource.h"
+#include <vector>
+#include <string>
+#include <atomic>
+#include <pthread.h>
+
+using namespace std;
+
+class ResourceManager;
+
+// ResourceProfiler records per-type utilization, queue length, acquisition
+// wait and hold time as a time series, to find the bottleneck pool during
+// peak banks.
+//
+// Acquire/release hooks only bump per-type atomic counters. A sampler
+// thread calls sample() periodically; it reads pool occupancy and drains
+// the counters into a bucket of bucket_width simulation time units. Each
+// type keeps the last RING_BUCKETS buckets in a fixed ring.
+//
+// Queue length and wait time cover blocking callers only (acquire_resource,
+// claim_booking, bundles with a timeout). Non-blocking callers such as
+// allocate_resource and ServiceScheduler's bundles never queue; a try that
+// finds no unit is counted as a busy attempt instead.
+//
+// CSV export (one row per type and bucket):
+//   type,bucket_start,utilization,avg_queue,max_queue,acquisitions,
+//   busy_attempts,avg_wait_us,max_wait_us,releases,avg_hold_ms
+
+struct ProfileBucket {
+    long long start_time;       // -1 if the slot is unused
+    int samples;
+    double utilization_sum;
+    long long queue_sum;
+    int queue_max;
+    long long acquisitions;
+    long long busy_attempts;    // Non-blocking tries that found no unit
+    long long total_wait_ns;
+    long long max_wait_ns;
+    long long releases;
+    long long total_hold_ns;
+};
+
+// Averages over a range of buckets
+struct ResourceProfileSummary {
+    double utilization;         // 0.0 to 1.0
+    double average_queue;
+    int max_queue;
+    long long acquisitions;
+    long long busy_attempts;
+    double average_wait_us;
+    double max_wait_us;
+    double average_hold_ms;
+};
+
+// Hot-path counters, drained by sample(). One cache line per type.
+struct alignas(64) ProfileCounters {
+    atomic<long long> acquisitions;
+    atomic<long long> busy_attempts;
+    atomic<long long> total_wait_ns;
+    atomic<long long> max_wait_ns;
+    atomic<long long> releases;
+    atomic<long long> total_hold_ns;
+};
+
+class ResourceProfiler {
+public:
+    static constexpr int MAX_TYPES = 8;
+    static constexpr int RING_BUCKETS = 360;
+    
+private:
+    int num_types;
+    long long bucket_width;
+    
+    ProfileCounters counters[MAX_TYPES];
+    vector<ProfileBucket> rings[MAX_TYPES];
+    long long latest_bucket;    // Start time of the newest bucket, -1 if none
+    
+    pthread_mutex_t profiler_mutex;     // Rings only
+    
+    ProfileBucket& bucket_locked(int type, long long start_time);
+    
+public:
+    ResourceProfiler(int types = 7, long long width = 10);
+    ~ResourceProfiler();
+    
+    // Called by ResourceManager (lock-free)
+    void record_acquire(ResourceType type, long long wait_ns);
+    void record_release(ResourceType type, long long hold_ns);
+    void record_busy(ResourceType type);
+    
+    // Take one sample of every pool into the bucket covering current_time
+    void sample(ResourceManager* manager, long long current_time);
+    
+    // Summary of the newest last_buckets buckets
+    ResourceProfileSummary get_summary(ResourceType type, int last_buckets);
+    
+    // Type with the longest average queue (then most busy attempts, then
+    // highest utilization) over the newest last_buckets buckets; -1 if
+    // every pool is idle
+    int get_bottleneck(int last_buckets);
+    
+    bool export_csv(const string& path);
+    
+    long long get_bucket_width() const { return bucket_width; }
+};
+
+#endif // RESOURCE_PROFILER_H
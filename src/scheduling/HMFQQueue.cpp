@@ -227,6 +227,11 @@ void HMFQQueue::complete(Operation* op) {
     op->is_completed = true;
     op->is_running = false;
     
+    // Still queued if it was never dispatched
+    for (int q = 0; q < 5; q++) {
+        queues[q].erase(remove(queues[q].begin(), queues[q].end(), op), queues[q].end());
+    }
+    
     if (current_operation == op) {
         current_operation = nullptr;
     }
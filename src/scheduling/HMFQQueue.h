@@ -65,7 +65,7 @@ public:
     // Get next operation to run
     Operation* dequeue(long long current_time);
     
-    // Complete an operation
+    // Complete an operation, taking it off its queue if still waiting
     void complete(Operation* op);
     
     // Block operation (waiting for resource)
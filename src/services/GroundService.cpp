@@ -1,11 +1,15 @@
 #include "GroundService.h"
 #include <chrono>
+#include <functional>
+#include <thread>
 
 using namespace std;
 
-// Static random number generator for equipment failure simulation
-mt19937 GroundService::rng;
-bool GroundService::rng_initialized = false;
+mt19937& GroundService::thread_rng() {
+    static thread_local mt19937 rng(chrono::steady_clock::now().time_since_epoch().count() ^
+                                    hash<thread::id>()(this_thread::get_id()));
+    return rng;
+}
 
 GroundService::GroundService(int id, ServiceType t, int flight, int gate) {
     service_id = id;
@@ -23,12 +27,6 @@ GroundService::GroundService(int id, ServiceType t, int flight, int gate) {
     failure_recovery_time = 0;
     retry_count = 0;
     
-    // Initialize RNG if not already done
-    if (!rng_initialized) {
-        rng.seed(chrono::steady_clock::now().time_since_epoch().count());
-        rng_initialized = true;
-    }
-    
     pthread_mutex_init(&service_mutex, nullptr);
     pthread_cond_init(&service_complete, nullptr);
 }
@@ -53,8 +51,8 @@ bool GroundService::start(long long current_time) {
         retry_count++;
         
         // Recovery time varies by service type (5-15 minutes)
-        uniform_int_distribution<int> recovery_dist(5, 15);
-        failure_recovery_time = recovery_dist(rng);
+        uniform_int_distribution<int> recovery_dist(MIN_RECOVERY_MINUTES, MAX_RECOVERY_MINUTES);
+        failure_recovery_time = recovery_dist(thread_rng());
         
         pthread_mutex_unlock(&service_mutex);
         return false;  // Service cannot start due to equipment failure
@@ -172,7 +170,7 @@ int GroundService::get_default_duration(ServiceType type) {
 bool GroundService::check_equipment_failure() {
     // Generate random number between 0 and 1
     uniform_real_distribution<double> dist(0.0, 1.0);
-    double roll = dist(rng);
+    double roll = dist(thread_rng());
     
     // 5% chance of equipment failure
     return roll < EQUIPMENT_FAILURE_PROBABILITY;
@@ -27,6 +27,8 @@ enum ServiceType {
     SVC_PUSHBACK
 };
 
+static constexpr int SERVICE_TYPE_COUNT = SVC_PUSHBACK + 1;
+
 enum ServiceStatus {
     SVC_PENDING,
     SVC_IN_PROGRESS,
@@ -37,6 +39,13 @@ enum ServiceStatus {
 };
 
 class GroundService {
+public:
+    // Equipment failure model (5% probability as per spec)
+    static constexpr double EQUIPMENT_FAILURE_PROBABILITY = 0.05;  // Per start attempt
+    static constexpr int MAX_RETRIES = 3;           // Failed starts before giving up
+    static constexpr int MIN_RECOVERY_MINUTES = 5;
+    static constexpr int MAX_RECOVERY_MINUTES = 15;
+    
 private:
     int service_id;
     ServiceType type;
@@ -51,16 +60,10 @@ private:
     long long start_time;
     long long end_time;
     
-    // Equipment failure simulation (5% probability as per spec)
-    static constexpr double EQUIPMENT_FAILURE_PROBABILITY = 0.05;  // 5%
+    // Equipment failure simulation
     bool equipment_failed;
     int failure_recovery_time;  // Minutes to recover from failure
     int retry_count;
-    static constexpr int MAX_RETRIES = 3;
-    
-    // Random number generator for failure simulation
-    static mt19937 rng;
-    static bool rng_initialized;
     
     pthread_mutex_t service_mutex;
     pthread_cond_t service_complete;
@@ -97,10 +100,16 @@ public:
     string get_name() const { return name; }
     int get_flight_id() const { return flight_id; }
     int get_duration() const { return estimated_duration; }
+    long long get_start_time() const { return start_time; }
+    long long get_end_time() const { return end_time; }
     const vector<ServiceType>& get_dependencies() const { return dependencies; }
     
     static string type_to_string(ServiceType type);
     static int get_default_duration(ServiceType type);
+    
+    // Random generator of the calling thread, seeded on first use; services
+    // start on parallel workers and share no generator
+    static mt19937& thread_rng();
 };
 
 #endif // GROUND_SERVICE_H
@@ -56,6 +56,38 @@ vector<ServiceType> ServiceDependencyGraph::get_dependencies(ServiceType service
     return vector<ServiceType>();
 }
 
+vector<ServiceType> ServiceDependencyGraph::get_dependents(ServiceType service) {
+    vector<ServiceType> dependents;
+    for (int i = SVC_DOCKING; i <= SVC_PUSHBACK; i++) {
+        for (ServiceType dep : adjacency[(ServiceType)i]) {
+            if (dep == service) {
+                dependents.push_back((ServiceType)i);
+                break;
+            }
+        }
+    }
+    return dependents;
+}
+
+vector<int> ServiceDependencyGraph::get_remaining_work() {
+    vector<int> remaining(SERVICE_TYPE_COUNT, 0);
+    vector<ServiceType> order = get_execution_order();
+    
+    // Reverse topological order: every dependent is done before its dependencies
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        remaining[*it] += GroundService::get_default_duration(*it);
+        for (ServiceType dep : adjacency[*it]) {
+            remaining[dep] = max(remaining[dep], remaining[*it]);
+        }
+    }
+    return remaining;
+}
+
+int ServiceDependencyGraph::get_critical_path_length() {
+    vector<int> remaining = get_remaining_work();
+    return *max_element(remaining.begin(), remaining.end());
+}
+
 void ServiceDependencyGraph::dfs_topo(ServiceType node, unordered_set<ServiceType>& visited,
                                        vector<ServiceType>& result) {
     visited.insert(node);
@@ -28,9 +28,19 @@ public:
     // Get dependencies for a service
     vector<ServiceType> get_dependencies(ServiceType service);
     
+    // Services that wait on this one
+    vector<ServiceType> get_dependents(ServiceType service);
+    
     // Topological sort - returns execution order
     vector<ServiceType> get_execution_order();
     
+    // Longest default-duration path from each service to the end of the
+    // turnaround, including the service itself (indexed by ServiceType)
+    vector<int> get_remaining_work();
+    
+    // Minimum turnaround length with unlimited parallelism
+    int get_critical_path_length();
+    
     // Check if graph has cycles (would be error)
     bool has_cycle();
     
@@ -1,52 +1,71 @@
 #include "ServiceExecutor.h"
 #include "../core/Logger.h"
 #include <sstream>
+#include <algorithm>
 #include <unistd.h>
 
 using namespace std;
 
-ServiceExecutor::ServiceExecutor(ServiceDependencyGraph* graph, ResourceManager* resources) {
+ServiceExecutor::ServiceExecutor(ServiceDependencyGraph* graph, int workers) {
     dep_graph = graph;
-    resource_manager = resources;
+    worker_count = max(1, workers);
+    microseconds_per_minute = MICROSECONDS_PER_MINUTE;
+    finished_count = 0;
+    failed_count = 0;
+    start_time = 0;
+    finish_time = 0;
     is_running = false;
+    for (int c = 0; c < TURNAROUND_CATEGORY_COUNT; c++) {
+        templates[c].compile(dep_graph, (TurnaroundCategory)c);
+    }
     pthread_mutex_init(&executor_mutex, nullptr);
     pthread_cond_init(&service_ready, nullptr);
+    pthread_cond_init(&all_finished, nullptr);
 }
 
 ServiceExecutor::~ServiceExecutor() {
     reset();
     pthread_mutex_destroy(&executor_mutex);
     pthread_cond_destroy(&service_ready);
+    pthread_cond_destroy(&all_finished);
 }
 
-void ServiceExecutor::create_turnaround_services(int flight_id, int gate_id) {
+void ServiceExecutor::create_turnaround_services(int flight_id, int gate_id, TurnaroundCategory category) {
     pthread_mutex_lock(&executor_mutex);
     
-    int id = 0;
-    vector<ServiceType> order = dep_graph->get_execution_order();
-    
-    for (ServiceType type : order) {
-        GroundService* service = new GroundService(id++, type, flight_id, gate_id);
+    const TurnaroundTemplate* plan = &templates[category];
+    int base = all_services.size();
+    for (int i = 0; i < plan->count; i++) {
+        GroundService* service = new GroundService(base + i, plan->order[i], flight_id, gate_id);
         
-        // Add dependencies from graph
-        vector<ServiceType> deps = dep_graph->get_dependencies(type);
-        for (ServiceType dep : deps) {
-            service->add_dependency(dep);
-        }
+        ServiceNode node;
+        node.service = service;
+        node.plan = plan;
+        node.base = base;
+        node.position = i;
+        node.pending_dependencies = plan->in_degree[i];
+        node.remaining_work = plan->remaining_work[i];
+        node.ready_time = 0;
+        node.queued = false;
+        node.done = false;
         
         all_services.push_back(service);
+        nodes.push_back(node);
     }
     
     pthread_mutex_unlock(&executor_mutex);
 }
 
-void ServiceExecutor::update_ready_queue() {
-    // Find services with all dependencies met
-    for (GroundService* svc : all_services) {
-        if (svc->get_status() == SVC_PENDING) {
-            if (svc->dependencies_met(completed_services)) {
-                ready_queue.push(svc);
-            }
+void ServiceExecutor::push_ready_locked(int index) {
+    nodes[index].queued = true;
+    ready_queue.push(make_pair(nodes[index].remaining_work, -index));
+}
+
+void ServiceExecutor::update_ready_queue_locked() {
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        ServiceNode& node = nodes[i];
+        if (!node.queued && !node.done && node.pending_dependencies == 0) {
+            push_ready_locked(i);
         }
     }
 }
@@ -54,11 +73,9 @@ void ServiceExecutor::update_ready_queue() {
 GroundService* ServiceExecutor::get_next_ready() {
     pthread_mutex_lock(&executor_mutex);
     
-    update_ready_queue();
-    
     GroundService* next = nullptr;
     if (!ready_queue.empty()) {
-        next = ready_queue.front();
+        next = all_services[-ready_queue.top().second];
         ready_queue.pop();
     }
     
@@ -70,20 +87,37 @@ bool ServiceExecutor::execute_service(GroundService* service, long long current_
     if (service == nullptr) return false;
     
     Logger* logger = Logger::get_instance();
+    ostringstream msg;
     
-    // Start service
-    if (!service->start(current_time)) {
-        return false;
+    // Start service, waiting out equipment failures
+    while (!service->start(current_time)) {
+        if (service->get_status() != SVC_EQUIPMENT_FAILURE) {
+            return false;
+        }
+        int recovery = service->get_recovery_time();
+        msg.str("");
+        msg << "[SERVICE] Equipment failure on " << service->get_name() << " for flight "
+            << service->get_flight_id() << " - recovering for " << recovery << " min";
+        logger->log_event(msg.str());
+        usleep(recovery * microseconds_per_minute);
+        current_time += recovery;
+        if (!service->attempt_recovery()) {
+            msg.str("");
+            msg << "[SERVICE] " << service->get_name() << " for flight " << service->get_flight_id()
+                << " failed after " << service->get_retry_count() << " attempts";
+            logger->log_event(msg.str());
+            return false;
+        }
     }
     
-    ostringstream msg;
-    msg << "[SERVICE] Started " << service->get_name() 
+    msg.str("");
+    msg << "[SERVICE] Started " << service->get_name()
         << " for flight " << service->get_flight_id();
     logger->log_event(msg.str());
     
     // Simulate work (scaled down)
     int duration = service->get_duration();
-    usleep(duration * 10000);  // 1 min = 10ms
+    usleep(duration * microseconds_per_minute);
     
     // Complete service
     service->complete(current_time + duration);
@@ -102,27 +136,126 @@ bool ServiceExecutor::execute_service(GroundService* service, long long current_
 void ServiceExecutor::mark_completed(GroundService* service) {
     pthread_mutex_lock(&executor_mutex);
     
+    int index = service->get_id();
+    nodes[index].done = true;
     completed_services.push_back(service);
+    finished_count++;
+    finish_time = max(finish_time, service->get_end_time());
+    
+    // Release dependents whose last dependency this was
+    const ServiceNode& done = nodes[index];
+    for (uint32_t next = done.plan->successors[done.position]; next; next &= next - 1) {
+        int dependent = done.base + __builtin_ctz(next);
+        ServiceNode& node = nodes[dependent];
+        node.ready_time = max(node.ready_time, service->get_end_time());
+        if (--node.pending_dependencies == 0) {
+            push_ready_locked(dependent);
+        }
+    }
+    
     pthread_cond_broadcast(&service_ready);
+    if (finished_count == (int)all_services.size()) {
+        pthread_cond_broadcast(&all_finished);
+    }
     
     pthread_mutex_unlock(&executor_mutex);
 }
 
-void ServiceExecutor::execute_all(long long start_time) {
-    is_running = true;
-    long long current = start_time;
+void ServiceExecutor::fail_locked(int index) {
+    ServiceNode& node = nodes[index];
+    if (node.done) return;
+    node.done = true;
+    failed_count++;
+    finished_count++;
+    if (node.service->get_status() != SVC_FAILED) {
+        node.service->fail("dependency failed");
+    }
+    for (uint32_t next = node.plan->successors[node.position]; next; next &= next - 1) {
+        fail_locked(node.base + __builtin_ctz(next));
+    }
+}
+
+void ServiceExecutor::mark_failed(GroundService* service) {
+    pthread_mutex_lock(&executor_mutex);
+    
+    fail_locked(service->get_id());
+    
+    pthread_cond_broadcast(&service_ready);
+    if (finished_count == (int)all_services.size()) {
+        pthread_cond_broadcast(&all_finished);
+    }
     
-    while ((int)completed_services.size() < (int)all_services.size()) {
-        GroundService* next = get_next_ready();
+    pthread_mutex_unlock(&executor_mutex);
+}
+
+void* ServiceExecutor::worker_func(void* arg) {
+    ServiceExecutor* executor = static_cast<ServiceExecutor*>(arg);
+    
+    while (true) {
+        pthread_mutex_lock(&executor->executor_mutex);
+        while (executor->ready_queue.empty() &&
+               executor->finished_count < (int)executor->all_services.size()) {
+            pthread_cond_wait(&executor->service_ready, &executor->executor_mutex);
+        }
+        if (executor->ready_queue.empty()) {
+            // Everything finished
+            pthread_mutex_unlock(&executor->executor_mutex);
+            break;
+        }
+        int index = -executor->ready_queue.top().second;
+        executor->ready_queue.pop();
+        GroundService* service = executor->all_services[index];
+        long long ready_time = executor->nodes[index].ready_time;
+        pthread_mutex_unlock(&executor->executor_mutex);
         
-        if (next != nullptr) {
-            execute_service(next, current);
-            current += next->get_duration();
-        } else {
-            // Wait for a service to complete
-            usleep(10000);
+        if (!executor->execute_service(service, ready_time)) {
+            executor->mark_failed(service);
+        }
+    }
+    return nullptr;
+}
+
+void ServiceExecutor::execute_all(long long start) {
+    pthread_mutex_lock(&executor_mutex);
+    
+    int outstanding = all_services.size() - finished_count;
+    if (outstanding == 0) {
+        pthread_mutex_unlock(&executor_mutex);
+        return;
+    }
+    is_running = true;
+    start_time = start;
+    finish_time = start;
+    for (ServiceNode& node : nodes) {
+        if (!node.done) node.ready_time = max(node.ready_time, start);
+    }
+    update_ready_queue_locked();
+    
+    pthread_mutex_unlock(&executor_mutex);
+    
+    // No more workers than services can ever use
+    int count = min(worker_count, outstanding);
+    vector<pthread_t> workers(count);
+    int started = 0;
+    for (int i = 0; i < count; i++) {
+        if (pthread_create(&workers[started], nullptr, worker_func, this) == 0) {
+            started++;
         }
     }
+    if (started == 0) {
+        // Run on the calling thread instead
+        worker_func(this);
+    }
+    
+    pthread_mutex_lock(&executor_mutex);
+    while (finished_count < (int)all_services.size()) {
+        pthread_cond_wait(&all_finished, &executor_mutex);
+    }
+    pthread_mutex_unlock(&executor_mutex);
+    
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], nullptr);
+    }
     
     is_running = false;
 }
@@ -135,10 +268,15 @@ void ServiceExecutor::reset() {
     }
     all_services.clear();
     completed_services.clear();
+    nodes.clear();
     
     while (!ready_queue.empty()) {
         ready_queue.pop();
     }
+    finished_count = 0;
+    failed_count = 0;
+    start_time = 0;
+    finish_time = 0;
     
     pthread_mutex_unlock(&executor_mutex);
 }
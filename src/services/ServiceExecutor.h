@@ -3,54 +3,108 @@
 
 #include "GroundService.h"
 #include "ServiceDependencyGraph.h"
-#include "../resources/ResourceManager.h"
+#include "TurnaroundTemplate.h"
 #include <vector>
 #include <queue>
+#include <utility>
 #include <pthread.h>
 
 using namespace std;
 
-// ServiceExecutor runs services in topological order using pthread_cond
+// ServiceExecutor runs turnaround services on a pool of worker threads.
+//
+// Each service keeps a count of unfinished dependencies and a list of the
+// services waiting on it. Completing a service decrements its dependents'
+// counts, and a service whose count reaches zero joins the ready queue,
+// so independent services (refueling, cleaning, cargo) run side by side
+// as the DAG permits. The ready queue is ordered critical-path first: the
+// service with the most work still behind it starts before the others.
+// Turnarounds are instantiated from templates compiled once per aircraft
+// category at construction.
+//
+// The simulation runs its turnarounds through ServiceScheduler; the only
+// user left is benchmarks/service_executor_benchmark.cpp.
 
 class ServiceExecutor {
+public:
+    static constexpr int DEFAULT_WORKERS = 4;
+    static constexpr int MICROSECONDS_PER_MINUTE = 10000;   // 1 min = 10ms
+    
 private:
+    struct ServiceNode {
+        GroundService* service;
+        const TurnaroundTemplate* plan;
+        int base;                       // Index of the turnaround's first node
+        int position;                   // In plan
+        int pending_dependencies;
+        int remaining_work;             // Critical-path length from here
+        long long ready_time;           // Latest dependency end time
+        bool queued;
+        bool done;                      // Completed or failed
+    };
+    
     ServiceDependencyGraph* dep_graph;
-    ResourceManager* resource_manager;
+    TurnaroundTemplate templates[TURNAROUND_CATEGORY_COUNT];
     
     vector<GroundService*> all_services;
     vector<GroundService*> completed_services;
-    queue<GroundService*> ready_queue;
+    vector<ServiceNode> nodes;          // Parallel to all_services
+    priority_queue<pair<int, int>> ready_queue;     // (remaining work, -index)
     
     pthread_mutex_t executor_mutex;
     pthread_cond_t service_ready;
+    pthread_cond_t all_finished;
+    
+    int worker_count;
+    int microseconds_per_minute;
+    int finished_count;                 // Completed + failed
+    int failed_count;
+    long long start_time;
+    long long finish_time;
     
     bool is_running;
     
+    static void* worker_func(void* arg);
+    
+    void push_ready_locked(int index);
+    void fail_locked(int index);
+    
+    // Queue services with no unfinished dependencies
+    void update_ready_queue_locked();
+    
 public:
-    ServiceExecutor(ServiceDependencyGraph* graph, ResourceManager* resources);
+    ServiceExecutor(ServiceDependencyGraph* graph, int workers = DEFAULT_WORKERS);
     ~ServiceExecutor();
     
     // Create services for a flight turnaround
-    void create_turnaround_services(int flight_id, int gate_id);
+    void create_turnaround_services(int flight_id, int gate_id,
+                                    TurnaroundCategory category = TURNAROUND_PASSENGER);
     
     // Execute all services (blocking)
     void execute_all(long long start_time);
     
-    // Execute single service (called by worker thread)
+    // Execute single service (called by worker thread); retries after
+    // equipment failures, false if it failed for good
     bool execute_service(GroundService* service, long long current_time);
     
-    // Check which services are ready to run
-    void update_ready_queue();
-    
-    // Get next ready service
+    // Get next ready service (critical path first), nullptr if none
     GroundService* get_next_ready();
     
-    // Mark service complete and update ready queue
+    // Mark service complete and release its dependents
     void mark_completed(GroundService* service);
     
+    // Mark service failed; its dependents can never run and fail with it
+    void mark_failed(GroundService* service);
+    
+    // Real time per simulated minute of service work
+    void set_time_scale(int microseconds) { microseconds_per_minute = microseconds; }
+    
     // Statistics
     int get_completed_count() const { return completed_services.size(); }
+    int get_failed_count() const { return failed_count; }
     int get_total_count() const { return all_services.size(); }
+    long long get_makespan() const { return finish_time - start_time; }
+    const TurnaroundTemplate& get_template(TurnaroundCategory category) const { return templates[category]; }
     
     // Cleanup
     void reset();
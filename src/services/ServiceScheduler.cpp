@@ -0,0 +1,557 @@
+#include "ServiceScheduler.h"
+#include "../core/Logger.h"
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <climits>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+
+using namespace std;
+
+// Equipment and crew each service needs (-1 = none)
+struct ServiceNeeds {
+    int resource;
+    int crew_role;
+};
+
+static const ServiceNeeds SERVICE_NEEDS[SERVICE_TYPE_COUNT] = {
+    {-1, CREW_GROUND_TECHNICIAN},                   // Docking
+    {RES_GROUND_POWER_UNIT, -1},                    // Power connect
+    {-1, CREW_GATE_AGENT},                          // Passenger unloading
+    {RES_BAGGAGE_CART, CREW_BAGGAGE_HANDLER},       // Baggage unloading
+    {RES_FUEL_TRUCK, CREW_FUEL_TECHNICIAN},         // Refueling
+    {RES_CLEANING_CREW, -1},                        // Cleaning
+    {RES_CATERING_VEHICLE, -1},                     // Catering
+    {-1, CREW_GROUND_TECHNICIAN},                   // Water service
+    {-1, CREW_GROUND_TECHNICIAN},                   // Waste service
+    {RES_BAGGAGE_CART, CREW_BAGGAGE_HANDLER},       // Cargo unload
+    {RES_BAGGAGE_CART, CREW_BAGGAGE_HANDLER},       // Cargo load
+    {RES_BAGGAGE_CART, CREW_BAGGAGE_HANDLER},       // Baggage loading
+    {-1, CREW_GATE_AGENT},                          // Boarding
+    {-1, -1},                                       // Power disconnect
+    {-1, -1},                                       // Pushback: the flight claims its booked tug
+};
+
+// Most positions of the set that no dependency orders against each other
+static int peak_concurrent(const uint32_t* ancestors, uint32_t positions) {
+    int best = 0;
+    // A type is used by a handful of services - try every subset
+    for (uint32_t subset = positions; subset; subset = (subset - 1) & positions) {
+        bool independent = true;
+        for (uint32_t rest = subset; rest && independent; rest &= rest - 1) {
+            independent = (ancestors[__builtin_ctz(rest)] & subset) == 0;
+        }
+        if (independent) best = max(best, __builtin_popcount(subset));
+    }
+    return best;
+}
+
+static long long monotonic_us() {
+    return chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ServiceScheduler::ServiceScheduler(ServiceDependencyGraph* graph, ResourceManager* resources,
+                                   CrewManager* crew, int workers) {
+    dep_graph = graph;
+    resource_manager = resources;
+    crew_manager = crew;
+    worker_count = max(1, workers);
+    microseconds_per_minute = MICROSECONDS_PER_MINUTE;
+    epoch_us = monotonic_us();
+    running = false;
+    stopped = false;
+    next_ticket = 0;
+    next_sequence = 0;
+    next_service_id = 0;
+    wake_generation = 0;
+    stats = ServiceSchedulerStats();
+    
+    for (int c = 0; c < TURNAROUND_CATEGORY_COUNT; c++) {
+        templates[c].compile(dep_graph, (TurnaroundCategory)c);
+        const TurnaroundTemplate& plan = templates[c];
+        
+        // Positions are topological, so predecessors' ancestors are known
+        uint32_t ancestors[SERVICE_TYPE_COUNT];
+        uint32_t users[ResourceManager::RESOURCE_LANES] = {};
+        for (int i = 0; i < plan.count; i++) {
+            ancestors[i] = plan.predecessors[i];
+            for (uint32_t p = plan.predecessors[i]; p; p &= p - 1) {
+                ancestors[i] |= ancestors[__builtin_ctz(p)];
+            }
+            int resource = SERVICE_NEEDS[plan.order[i]].resource;
+            if (resource >= 0) users[resource] |= 1u << i;
+        }
+        for (int j = 0; j < ResourceManager::RESOURCE_LANES; j++) {
+            peak_demand[c][j] = peak_concurrent(ancestors, users[j]);
+        }
+    }
+    
+    pthread_mutex_init(&scheduler_mutex, nullptr);
+    pthread_condattr_init(&condattr);
+    pthread_condattr_setclock(&condattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&work_available, &condattr);
+    pthread_cond_init(&turnaround_done, nullptr);
+    
+    // Equipment released anywhere may unblock a ready service
+    if (resource_manager) resource_manager->set_release_listener(on_release, this);
+}
+
+ServiceScheduler::~ServiceScheduler() {
+    if (resource_manager) resource_manager->set_release_listener(nullptr, nullptr);
+    stop();
+    for (auto& entry : turnarounds) {
+        if (entry.second->banker_handle >= 0) {
+            resource_manager->unregister_flight(entry.second->banker_handle);
+        }
+        for (ServiceTask& task : entry.second->tasks) {
+            delete task.service;
+        }
+        delete entry.second;
+    }
+    pthread_mutex_destroy(&scheduler_mutex);
+    pthread_cond_destroy(&work_available);
+    pthread_cond_destroy(&turnaround_done);
+    pthread_condattr_destroy(&condattr);
+}
+
+long long ServiceScheduler::now() {
+    return (monotonic_us() - epoch_us) / max(1, microseconds_per_minute);
+}
+
+void ServiceScheduler::start() {
+    pthread_mutex_lock(&scheduler_mutex);
+    if (running) {
+        pthread_mutex_unlock(&scheduler_mutex);
+        return;
+    }
+    running = true;
+    stopped = false;
+    pthread_mutex_unlock(&scheduler_mutex);
+    
+    for (int i = 0; i < worker_count; i++) {
+        pthread_t worker;
+        if (pthread_create(&worker, nullptr, worker_func, this) == 0) {
+            workers.push_back(worker);
+        }
+    }
+}
+
+void ServiceScheduler::stop() {
+    pthread_mutex_lock(&scheduler_mutex);
+    bool was_running = running;
+    running = false;
+    pthread_cond_broadcast(&work_available);
+    pthread_mutex_unlock(&scheduler_mutex);
+    if (!was_running) return;
+    
+    // Workers finish the service in hand before exiting
+    for (pthread_t worker : workers) {
+        pthread_join(worker, nullptr);
+    }
+    workers.clear();
+    
+    pthread_mutex_lock(&scheduler_mutex);
+    stopped = true;
+    for (auto& entry : turnarounds) {
+        abandon_locked(entry.second);
+    }
+    pthread_cond_broadcast(&turnaround_done);
+    pthread_mutex_unlock(&scheduler_mutex);
+}
+
+int ServiceScheduler::submit_turnaround(int flight_id, int gate_id, int priority,
+                                        long long sim_time, long long due_in,
+                                        TurnaroundCategory category) {
+    // Max demand, capped at the pool (a service waits its turn either way)
+    int banker_handle = -1;
+    if (resource_manager) {
+        vector<int> demand(peak_demand[category], peak_demand[category] + RES_GROUND_POWER_UNIT + 1);
+        for (int j = 0; j <= RES_GROUND_POWER_UNIT; j++) {
+            demand[j] = min(demand[j], resource_manager->get_total_count((ResourceType)j));
+        }
+        banker_handle = resource_manager->register_flight(demand);
+    }
+    
+    pthread_mutex_lock(&scheduler_mutex);
+    
+    long long release = now();
+    Turnaround* turnaround = new Turnaround();
+    turnaround->ticket = next_ticket++;
+    turnaround->flight_id = flight_id;
+    turnaround->gate_id = gate_id;
+    turnaround->priority = priority;
+    turnaround->sim_time = sim_time;
+    turnaround->banker_handle = banker_handle;
+    turnaround->report = TurnaroundReport();
+    turnaround->report.flight_id = flight_id;
+    turnaround->report.release_time = release;
+    turnaround->report.deadline = release + due_in;
+    turnaround->report.finish_time = release;
+    
+    // Dependency state is a copy of the template's in-degrees
+    const TurnaroundTemplate* plan = &templates[category];
+    turnaround->plan = plan;
+    memcpy(turnaround->pending, plan->in_degree, sizeof(turnaround->pending));
+    turnaround->unfinished = plan->count;
+    turnaround->tasks.resize(plan->count);
+    
+    for (int i = 0; i < plan->count; i++) {
+        ServiceTask& task = turnaround->tasks[i];
+        task.service = new GroundService(next_service_id++, plan->order[i], flight_id, gate_id);
+        task.turnaround = turnaround;
+        task.position = i;
+        task.latest_start = turnaround->report.deadline - plan->remaining_work[i];
+        task.sequence = next_sequence++;
+        task.ready_since = release;
+        task.resource_waited = false;
+        task.crew_waited = false;
+        task.done = false;
+    }
+    turnarounds[turnaround->ticket] = turnaround;
+    
+    for (ServiceTask& task : turnaround->tasks) {
+        if (turnaround->pending[task.position] == 0) {
+            make_ready_locked(&task);
+        }
+    }
+    
+    pthread_mutex_unlock(&scheduler_mutex);
+    return turnaround->ticket;
+}
+
+TurnaroundReport ServiceScheduler::wait_turnaround(int ticket) {
+    pthread_mutex_lock(&scheduler_mutex);
+    
+    auto it = turnarounds.find(ticket);
+    if (it == turnarounds.end()) {
+        pthread_mutex_unlock(&scheduler_mutex);
+        TurnaroundReport none = TurnaroundReport();
+        none.flight_id = -1;
+        return none;
+    }
+    Turnaround* turnaround = it->second;
+    while (turnaround->unfinished > 0 && !stopped) {
+        pthread_cond_wait(&turnaround_done, &scheduler_mutex);
+    }
+    if (turnaround->unfinished > 0) {
+        abandon_locked(turnaround);    // Submitted after stop()
+    }
+    TurnaroundReport report = turnaround->report;
+    turnarounds.erase(ticket);
+    
+    pthread_mutex_unlock(&scheduler_mutex);
+    
+    // Every service has given its equipment back
+    if (turnaround->banker_handle >= 0) {
+        resource_manager->unregister_flight(turnaround->banker_handle);
+    }
+    for (ServiceTask& task : turnaround->tasks) {
+        delete task.service;
+    }
+    delete turnaround;
+    return report;
+}
+
+int ServiceScheduler::crew_role_for(ServiceType type) {
+    return SERVICE_NEEDS[type].crew_role;
+}
+
+TurnaroundReport ServiceScheduler::run_turnaround(int flight_id, int gate_id, int priority,
+                                                  long long sim_time, long long due_in,
+                                                  TurnaroundCategory category) {
+    return wait_turnaround(submit_turnaround(flight_id, gate_id, priority, sim_time, due_in, category));
+}
+
+void ServiceScheduler::make_ready_locked(ServiceTask* task) {
+    task->ready_since = now();
+    ready.insert(task);
+    wake_generation++;
+    pthread_cond_signal(&work_available);
+}
+
+void ServiceScheduler::wake_workers_locked() {
+    wake_generation++;
+    pthread_cond_broadcast(&work_available);
+}
+
+void ServiceScheduler::on_release(void* arg) {
+    ServiceScheduler* scheduler = static_cast<ServiceScheduler*>(arg);
+    pthread_mutex_lock(&scheduler->scheduler_mutex);
+    scheduler->wake_workers_locked();
+    pthread_mutex_unlock(&scheduler->scheduler_mutex);
+}
+
+ServiceScheduler::ServiceTask* ServiceScheduler::dispatch_locked(vector<Resource*>& equipment, Crew*& crew,
+                                                                 int& own_wakes, long long& crew_deadline) {
+    // Once a type or role is found busy, skip the rest of the scan for it
+    bool resource_busy[ResourceManager::RESOURCE_LANES] = {};
+    bool crew_busy[CREW_ATC + 1] = {};
+    long long current = now();
+    crew_deadline = LLONG_MAX;
+    
+    while (running) {
+        ServiceTask* task = nullptr;
+        for (ServiceTask* candidate : ready) {
+            const ServiceNeeds& needs = SERVICE_NEEDS[candidate->service->get_type()];
+            if (needs.resource >= 0 && resource_manager && resource_busy[needs.resource]) continue;
+            if (needs.crew_role >= 0 && crew_manager && crew_busy[needs.crew_role] &&
+                current - candidate->ready_since < CREW_WAIT_LIMIT) {
+                crew_deadline = min(crew_deadline, candidate->ready_since + CREW_WAIT_LIMIT);
+                continue;
+            }
+            task = candidate;
+            break;
+        }
+        if (task == nullptr) return nullptr;
+        
+        // No other worker sees the service while its needs are asked for
+        ready.erase(task);
+        const ServiceNeeds& needs = SERVICE_NEEDS[task->service->get_type()];
+        bool try_crew = needs.crew_role >= 0 && !crew_busy[needs.crew_role];
+        pthread_mutex_unlock(&scheduler_mutex);
+        NeedsResult result = take_needs(task, try_crew, current, equipment, crew);
+        bool crew_returned = false;
+        if (result == EQUIPMENT_BUSY && crew) {
+            crew_manager->release_crew(crew, current * 60);
+            crew = nullptr;
+            crew_returned = true;
+        }
+        pthread_mutex_lock(&scheduler_mutex);
+        
+        bool crew_missing = needs.crew_role >= 0 && crew_manager && crew == nullptr;
+        if (crew_missing && !task->crew_waited) {
+            task->crew_waited = true;
+            stats.crew_waits++;
+        }
+        if (result == NEEDS_MET) return task;
+        
+        ready.insert(task);
+        if (result == CREW_BUSY) {
+            crew_busy[needs.crew_role] = true;
+        } else {
+            resource_busy[needs.resource] = true;
+            if (!task->resource_waited) {
+                task->resource_waited = true;
+                stats.resource_waits++;
+            }
+            if (crew_returned) {
+                // Another worker may have passed over the role meanwhile
+                wake_workers_locked();
+                own_wakes++;
+            }
+        }
+    }
+    return nullptr;
+}
+
+ServiceScheduler::NeedsResult ServiceScheduler::take_needs(ServiceTask* task, bool try_crew, long long current,
+                                                           vector<Resource*>& equipment, Crew*& crew) {
+    Turnaround* turnaround = task->turnaround;
+    const ServiceNeeds& needs = SERVICE_NEEDS[task->service->get_type()];
+    equipment.clear();
+    crew = nullptr;
+    
+    if (needs.crew_role >= 0 && crew_manager) {
+        if (try_crew) {
+            crew = crew_manager->assign_crew((CrewRole)needs.crew_role, turnaround->flight_id, current * 60);
+        }
+        if (crew == nullptr && current - task->ready_since < CREW_WAIT_LIMIT) {
+            return CREW_BUSY;
+        }
+    }
+    
+    if (needs.resource >= 0 && resource_manager) {
+        // Busy or unsafe to grant now - either way, not this round
+        vector<int> counts(RES_GROUND_POWER_UNIT + 1, 0);
+        counts[needs.resource] = 1;
+        if (!resource_manager->acquire_bundle(turnaround->banker_handle, counts, turnaround->flight_id,
+                                              turnaround->sim_time, 0, 0, false, equipment)) {
+            return EQUIPMENT_BUSY;
+        }
+    }
+    return NEEDS_MET;
+}
+
+bool ServiceScheduler::run_task(ServiceTask* task, Crew* crew) {
+    GroundService* service = task->service;
+    Logger* logger = Logger::get_instance();
+    ostringstream msg;
+    
+    // Start service, waiting out equipment failures
+    while (!service->start(now())) {
+        if (service->get_status() != SVC_EQUIPMENT_FAILURE) {
+            return false;
+        }
+        msg.str("");
+        msg << "[SERVICE] Equipment failure on " << service->get_name() << " for flight "
+            << service->get_flight_id() << " - recovering for " << service->get_recovery_time() << " min";
+        logger->log_event(msg.str());
+        usleep(service->get_recovery_time() * microseconds_per_minute);
+        if (!service->attempt_recovery()) {
+            msg.str("");
+            msg << "[SERVICE] " << service->get_name() << " for flight " << service->get_flight_id()
+                << " failed after " << service->get_retry_count() << " attempts";
+            logger->log_event(msg.str());
+            return false;
+        }
+    }
+    
+    // Crew skill scales the work; a crewed service without crew runs slow
+    double duration = service->get_duration();
+    if (crew) {
+        duration = crew->calculate_service_duration(service->get_duration());
+    } else if (SERVICE_NEEDS[service->get_type()].crew_role >= 0 && crew_manager) {
+        duration = service->get_duration() / UNCREWED_EFFICIENCY;
+    }
+    usleep((long long)llround(duration * microseconds_per_minute));
+    
+    service->complete(now());
+    return true;
+}
+
+void ServiceScheduler::finish_locked(ServiceTask* task, bool completed) {
+    Turnaround* turnaround = task->turnaround;
+    task->done = true;
+    turnaround->unfinished--;
+    
+    if (completed) {
+        turnaround->report.completed++;
+        turnaround->report.finish_time = max(turnaround->report.finish_time, task->service->get_end_time());
+        stats.services++;
+        for (uint32_t next = turnaround->plan->successors[task->position]; next; next &= next - 1) {
+            int dependent = __builtin_ctz(next);
+            if (--turnaround->pending[dependent] == 0) {
+                make_ready_locked(&turnaround->tasks[dependent]);
+            }
+        }
+    } else {
+        turnaround->report.failed++;
+        task->service->fail("equipment failure");
+        for (uint32_t next = turnaround->plan->successors[task->position]; next; next &= next - 1) {
+            skip_locked(&turnaround->tasks[__builtin_ctz(next)]);
+        }
+    }
+    
+    if (turnaround->unfinished == 0) {
+        close_turnaround_locked(turnaround);
+    }
+    // Crew just came back
+    wake_workers_locked();
+}
+
+void ServiceScheduler::skip_locked(ServiceTask* task) {
+    if (task->done) return;
+    task->done = true;
+    task->turnaround->unfinished--;
+    task->turnaround->report.failed++;
+    task->service->fail("dependency failed");
+    Turnaround* turnaround = task->turnaround;
+    for (uint32_t next = turnaround->plan->successors[task->position]; next; next &= next - 1) {
+        skip_locked(&turnaround->tasks[__builtin_ctz(next)]);
+    }
+}
+
+void ServiceScheduler::abandon_locked(Turnaround* turnaround) {
+    if (turnaround->unfinished == 0) return;
+    for (ServiceTask& task : turnaround->tasks) {
+        if (!task.done) {
+            ready.erase(&task);
+            task.done = true;
+            turnaround->unfinished--;
+            turnaround->report.failed++;
+            task.service->fail("scheduler stopped");
+        }
+    }
+    close_turnaround_locked(turnaround);
+}
+
+void ServiceScheduler::close_turnaround_locked(Turnaround* turnaround) {
+    TurnaroundReport& report = turnaround->report;
+    if (report.completed < (int)turnaround->tasks.size()) {
+        report.finish_time = max(report.finish_time, now());
+    }
+    report.slack = report.deadline - report.finish_time;
+    
+    stats.turnarounds++;
+    stats.total_slack += report.slack;
+    if (report.slack < 0) stats.late++;
+    if (stats.turnarounds == 1 || report.slack < stats.worst_slack) {
+        stats.worst_slack = report.slack;
+    }
+    pthread_cond_broadcast(&turnaround_done);
+}
+
+void* ServiceScheduler::worker_func(void* arg) {
+    ServiceScheduler* scheduler = static_cast<ServiceScheduler*>(arg);
+    
+    pthread_mutex_lock(&scheduler->scheduler_mutex);
+    while (scheduler->running) {
+        long long seen = scheduler->wake_generation;
+        int own_wakes = 0;
+        long long crew_deadline;
+        vector<Resource*> equipment;
+        Crew* crew = nullptr;
+        ServiceTask* task = scheduler->dispatch_locked(equipment, crew, own_wakes, crew_deadline);
+        
+        if (task) {
+            pthread_mutex_unlock(&scheduler->scheduler_mutex);
+            bool completed = scheduler->run_task(task, crew);
+            if (!equipment.empty()) {
+                scheduler->resource_manager->release_bundle(task->turnaround->banker_handle, equipment);
+            }
+            if (crew) scheduler->crew_manager->release_crew(crew, scheduler->now() * 60);
+            pthread_mutex_lock(&scheduler->scheduler_mutex);
+            scheduler->finish_locked(task, completed);
+            continue;
+        }
+        
+        // Sleep until another thread readies a service or returns equipment
+        // or crew, or a crew wait runs out
+        if (crew_deadline == LLONG_MAX) {
+            while (scheduler->running && scheduler->wake_generation == seen + own_wakes) {
+                pthread_cond_wait(&scheduler->work_available, &scheduler->scheduler_mutex);
+            }
+        } else {
+            long long wake_us = scheduler->epoch_us + crew_deadline * max(1, scheduler->microseconds_per_minute);
+            struct timespec deadline;
+            deadline.tv_sec = wake_us / 1000000;
+            deadline.tv_nsec = (wake_us % 1000000) * 1000;
+            int result = 0;
+            while (scheduler->running && scheduler->wake_generation == seen + own_wakes && result != ETIMEDOUT) {
+                result = pthread_cond_timedwait(&scheduler->work_available, &scheduler->scheduler_mutex, &deadline);
+            }
+        }
+    }
+    pthread_mutex_unlock(&scheduler->scheduler_mutex);
+    return nullptr;
+}
+
+ServiceSchedulerStats ServiceScheduler::get_stats() {
+    pthread_mutex_lock(&scheduler_mutex);
+    ServiceSchedulerStats result = stats;
+    pthread_mutex_unlock(&scheduler_mutex);
+    result.average_slack = result.turnarounds > 0 ? (double)result.total_slack / result.turnarounds : 0.0;
+    return result;
+}
+
+int ServiceScheduler::get_ready_count() {
+    pthread_mutex_lock(&scheduler_mutex);
+    int count = ready.size();
+    pthread_mutex_unlock(&scheduler_mutex);
+    return count;
+}
+
+int ServiceScheduler::get_active_turnarounds() {
+    pthread_mutex_lock(&scheduler_mutex);
+    int count = 0;
+    for (auto& entry : turnarounds) {
+        if (entry.second->unfinished > 0) count++;
+    }
+    pthread_mutex_unlock(&scheduler_mutex);
+    return count;
+}
@@ -0,0 +1,213 @@
+#ifndef SERVICE_SCHEDULER_H
+#define SERVICE_SCHEDULER_H
+
+#include "GroundService.h"
+#include "ServiceDependencyGraph.h"
+#include "TurnaroundTemplate.h"
+#include "../resources/ResourceManager.h"
+#include "../crew/CrewManager.h"
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <pthread.h>
+
+using namespace std;
+
+// ServiceScheduler runs the ground services of every flight at a gate on
+// one airport-wide worker pool.
+//
+// Each submitted turnaround adds its service DAG to a shared ready pool,
+// instantiated from the TurnaroundTemplate of its aircraft category.
+// Ready services are ordered earliest deadline first, where a service's
+// deadline is its flight's departure minus the critical-path work still
+// behind it. A worker takes the first ready service whose equipment
+// (ResourceManager pool) and crew (CrewManager role) are idle right now,
+// so a fuel truck always goes to the most urgent refuel across gates and
+// services that need nothing scarce never wait behind those that do.
+//
+// Each turnaround is registered with the ResourceManager's Banker's
+// algorithm, its max demand being the most services of each equipment
+// type its template can run at once. Equipment is taken as a bundle, so
+// every grant passes the safety check.
+//
+// A worker takes its candidate off the ready set and drops scheduler_mutex
+// while it asks for crew, then equipment; if either is busy the service
+// goes back and the scan goes on past that role or type. Crew comes first
+// so a miss never hands equipment back. Idle workers sleep until a service
+// becomes ready or equipment or crew is released (ResourceManager release
+// listener), or until the next crew wait limit.
+//
+// A crewed service goes ahead without its crew after CREW_WAIT_LIMIT
+// minutes, at novice speed, so a role running short (crew become unfit
+// with fatigue) slows turnarounds rather than stalling them.
+//
+// Times are service minutes since the scheduler started (1 min = 10ms
+// real time, as ServiceExecutor). Each turnaround reports its slack:
+// deadline minus finish, negative when late.
+
+struct TurnaroundReport {
+    int flight_id;
+    long long release_time;     // Submitted (scheduler minutes)
+    long long deadline;
+    long long finish_time;
+    long long slack;            // deadline - finish_time
+    int completed;
+    int failed;                 // Incl. services skipped after a failure
+};
+
+// Totals over finished turnarounds
+struct ServiceSchedulerStats {
+    long long turnarounds;
+    long long late;             // Negative slack
+    long long total_slack;
+    long long worst_slack;
+    long long services;
+    long long resource_waits;   // Services that found their equipment busy
+    long long crew_waits;       // Services that found no crew free
+    double average_slack;
+};
+
+class ServiceScheduler {
+public:
+    static constexpr int DEFAULT_WORKERS = 32;      // Workers only sleep through service
+                                                    // work; equipment and crew are the limit
+    static constexpr int MICROSECONDS_PER_MINUTE = 10000;   // 1 min = 10ms
+    static constexpr int CREW_WAIT_LIMIT = 15;      // Minutes before going without crew
+    static constexpr double UNCREWED_EFFICIENCY = 0.80;     // As a novice crew
+    
+private:
+    struct Turnaround;
+    
+    struct ServiceTask {
+        GroundService* service;
+        Turnaround* turnaround;
+        int position;                   // In the turnaround's template
+        long long latest_start;         // Deadline minus remaining critical path
+        long long sequence;             // FIFO among equal deadlines
+        long long ready_since;
+        bool resource_waited;
+        bool crew_waited;
+        bool done;
+    };
+    
+    struct Turnaround {
+        int ticket;
+        int flight_id;
+        int gate_id;
+        int priority;                   // Flight::priority, breaks deadline ties
+        long long sim_time;             // Caller's clock, for resource bookkeeping
+        int banker_handle;              // ResourceManager registration (-1 = none)
+        TurnaroundReport report;
+        const TurnaroundTemplate* plan;
+        int pending[SERVICE_TYPE_COUNT];    // Unfinished dependencies by position
+        vector<ServiceTask> tasks;      // Never resized after creation
+        int unfinished;
+    };
+    
+    enum NeedsResult {
+        NEEDS_MET,
+        CREW_BUSY,
+        EQUIPMENT_BUSY
+    };
+    
+    struct TaskOrder {
+        bool operator()(const ServiceTask* a, const ServiceTask* b) const {
+            if (a->latest_start != b->latest_start) return a->latest_start < b->latest_start;
+            if (a->turnaround->priority != b->turnaround->priority) {
+                return a->turnaround->priority < b->turnaround->priority;
+            }
+            return a->sequence < b->sequence;
+        }
+    };
+    
+    ServiceDependencyGraph* dep_graph;
+    ResourceManager* resource_manager;  // Not owned
+    CrewManager* crew_manager;          // Not owned; nullptr = no crew needed
+    
+    // Compiled once from the graph
+    TurnaroundTemplate templates[TURNAROUND_CATEGORY_COUNT];
+    // Most services of a category that hold one equipment type at once
+    int peak_demand[TURNAROUND_CATEGORY_COUNT][ResourceManager::RESOURCE_LANES];
+    
+    set<ServiceTask*, TaskOrder> ready;
+    unordered_map<int, Turnaround*> turnarounds;    // Ticket -> turnaround
+    int next_ticket;
+    long long next_sequence;
+    int next_service_id;
+    
+    pthread_mutex_t scheduler_mutex;
+    pthread_cond_t work_available;      // New ready service or freed equipment
+    long long wake_generation;          // Bumped with each work_available wake
+    pthread_cond_t turnaround_done;
+    pthread_condattr_t condattr;        // CLOCK_MONOTONIC timed waits
+    
+    vector<pthread_t> workers;
+    int worker_count;
+    int microseconds_per_minute;
+    long long epoch_us;                 // Clock origin
+    bool running;
+    bool stopped;                       // Workers joined; waiters give up
+    
+    ServiceSchedulerStats stats;
+    
+    static void* worker_func(void* arg);
+    static void on_release(void* arg);
+    
+    // Caller holds scheduler_mutex
+    void make_ready_locked(ServiceTask* task);
+    void wake_workers_locked();
+    // Dropped while crew and equipment are asked for; own_wakes counts the
+    // wakes this caller made by handing crew back, crew_deadline (minutes)
+    // is the earliest a crew wait runs out
+    ServiceTask* dispatch_locked(vector<Resource*>& equipment, Crew*& crew,
+                                 int& own_wakes, long long& crew_deadline);
+    void finish_locked(ServiceTask* task, bool completed);
+    void skip_locked(ServiceTask* task);
+    void abandon_locked(Turnaround* turnaround);
+    void close_turnaround_locked(Turnaround* turnaround);
+    
+    // Caller holds no lock
+    NeedsResult take_needs(ServiceTask* task, bool try_crew, long long current,
+                           vector<Resource*>& equipment, Crew*& crew);
+    bool run_task(ServiceTask* task, Crew* crew);
+    
+public:
+    ServiceScheduler(ServiceDependencyGraph* graph, ResourceManager* resources,
+                     CrewManager* crew, int workers = DEFAULT_WORKERS);
+    ~ServiceScheduler();
+    
+    void start();
+    // Stop the workers; services not yet started fail and waiters return
+    void stop();
+    
+    // Add a flight's turnaround; due_in is minutes until its departure.
+    // Returns a ticket for wait_turnaround.
+    int submit_turnaround(int flight_id, int gate_id, int priority,
+                          long long sim_time, long long due_in,
+                          TurnaroundCategory category = TURNAROUND_PASSENGER);
+    // Block until every service of the turnaround has finished or failed
+    // (or the scheduler is stopped)
+    TurnaroundReport wait_turnaround(int ticket);
+    // submit_turnaround + wait_turnaround
+    TurnaroundReport run_turnaround(int flight_id, int gate_id, int priority,
+                                    long long sim_time, long long due_in,
+                                    TurnaroundCategory category = TURNAROUND_PASSENGER);
+    
+    // Minutes since the scheduler started
+    long long now();
+    
+    // Real time per simulated minute of service work (before start())
+    void set_time_scale(int microseconds) { microseconds_per_minute = microseconds; }
+    
+    const TurnaroundTemplate& get_template(TurnaroundCategory category) const { return templates[category]; }
+    
+    // Crew role a service is run by (-1 = none)
+    static int crew_role_for(ServiceType type);
+    
+    // Statistics
+    ServiceSchedulerStats get_stats();
+    int get_ready_count();
+    int get_active_turnarounds();
+};
+
+#endif // SERVICE_SCHEDULER_H
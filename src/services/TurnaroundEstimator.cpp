@@ -0,0 +1,170 @@
+#include "TurnaroundEstimator.h"
+#include "ServiceScheduler.h"
+#include "../crew/Crew.h"
+#include "../core/Logger.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+TurnaroundEstimator::TurnaroundEstimator(ServiceDependencyGraph* graph, int threads) {
+    thread_count = max(1, threads);
+    seed = chrono::steady_clock::now().time_since_epoch().count();
+    
+    for (int c = 0; c < TURNAROUND_CATEGORY_COUNT; c++) {
+        templates[c].compile(graph, (TurnaroundCategory)c);
+        estimates[c] = TurnaroundEstimate();
+        estimated[c] = false;
+    }
+    for (int t = 0; t < SERVICE_TYPE_COUNT; t++) {
+        crewed[t] = ServiceScheduler::crew_role_for((ServiceType)t) >= 0;
+    }
+    
+    pthread_mutex_init(&estimator_mutex, nullptr);
+}
+
+TurnaroundEstimator::~TurnaroundEstimator() {
+    pthread_mutex_destroy(&estimator_mutex);
+}
+
+bool TurnaroundEstimator::sample_once(const TurnaroundTemplate& plan, mt19937& rng, double& duration) const {
+    bernoulli_distribution equipment_fails(GroundService::EQUIPMENT_FAILURE_PROBABILITY);
+    uniform_int_distribution<int> recovery(GroundService::MIN_RECOVERY_MINUTES,
+                                           GroundService::MAX_RECOVERY_MINUTES);
+    double finish[SERVICE_TYPE_COUNT];
+    duration = 0;
+    
+    // Positions are topological: predecessors are finished before each service
+    for (int i = 0; i < plan.count; i++) {
+        double start = 0;
+        for (uint32_t preds = plan.predecessors[i]; preds; preds &= preds - 1) {
+            start = max(start, finish[__builtin_ctz(preds)]);
+        }
+        
+        // Failed starts each cost a recovery; the last allowed one ends it
+        int failures = 0;
+        while (equipment_fails(rng)) {
+            start += recovery(rng);
+            if (++failures >= GroundService::MAX_RETRIES) return false;
+        }
+        
+        double work = GroundService::get_default_duration(plan.order[i]);
+        if (crewed[plan.order[i]]) {
+            work /= Crew::multiplier_for(Crew::draw_skill_level(rng));
+        }
+        finish[i] = start + work;
+        duration = max(duration, finish[i]);
+    }
+    return true;
+}
+
+void* TurnaroundEstimator::sample_func(void* arg) {
+    SampleBatch* batch = static_cast<SampleBatch*>(arg);
+    
+    // Own generator per thread, reproducible from the base seed
+    seed_seq sequence{(unsigned)batch->seed, (unsigned)(batch->seed >> 32),
+                      (unsigned)batch->plan->category, (unsigned)batch->thread_index};
+    mt19937 rng(sequence);
+    
+    batch->durations.reserve(batch->samples);
+    batch->failed = 0;
+    for (int s = 0; s < batch->samples; s++) {
+        double duration;
+        if (batch->estimator->sample_once(*batch->plan, rng, duration)) {
+            batch->durations.push_back((float)duration);
+        } else {
+            batch->failed++;
+        }
+    }
+    return nullptr;
+}
+
+TurnaroundEstimate TurnaroundEstimator::simulate(TurnaroundCategory category, int samples) {
+    samples = max(1, samples);
+    int threads = min(thread_count, samples);
+    vector<SampleBatch> batches(threads);
+    vector<pthread_t> workers(threads);
+    for (int t = 0; t < threads; t++) {
+        batches[t].estimator = this;
+        batches[t].plan = &templates[category];
+        batches[t].samples = samples / threads + (t < samples % threads ? 1 : 0);
+        batches[t].seed = seed;
+        batches[t].thread_index = t;
+        pthread_create(&workers[t], nullptr, sample_func, &batches[t]);
+    }
+    
+    vector<float> durations;
+    durations.reserve(samples);
+    int failed = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(workers[t], nullptr);
+        durations.insert(durations.end(), batches[t].durations.begin(), batches[t].durations.end());
+        failed += batches[t].failed;
+    }
+    
+    TurnaroundEstimate result;
+    result.category = category;
+    result.samples = samples;
+    result.critical_path = templates[category].critical_path;
+    result.failure_rate = (double)failed / samples;
+    if (durations.empty()) {
+        result.mean = result.p50 = result.p90 = result.critical_path;
+        return result;
+    }
+    
+    double total = 0;
+    for (float d : durations) total += d;
+    result.mean = total / durations.size();
+    
+    // Order statistics: P50 first, then P90 within the upper half
+    size_t median = (durations.size() - 1) / 2;
+    size_t upper = (durations.size() - 1) * 9 / 10;
+    nth_element(durations.begin(), durations.begin() + median, durations.end());
+    result.p50 = durations[median];
+    nth_element(durations.begin() + median, durations.begin() + upper, durations.end());
+    result.p90 = durations[upper];
+    return result;
+}
+
+void TurnaroundEstimator::estimate_all(int samples) {
+    Logger* logger = Logger::get_instance();
+    for (int c = 0; c < TURNAROUND_CATEGORY_COUNT; c++) {
+        TurnaroundEstimate estimate = simulate((TurnaroundCategory)c, samples);
+        
+        pthread_mutex_lock(&estimator_mutex);
+        estimates[c] = estimate;
+        estimated[c] = true;
+        pthread_mutex_unlock(&estimator_mutex);
+        
+        ostringstream msg;
+        msg << fixed << setprecision(1) << "[SERVICE] "
+            << TurnaroundTemplate::category_to_string((TurnaroundCategory)c) << " turnaround estimate ("
+            << estimate.samples << " samples): P50 " << estimate.p50 << " min, P90 " << estimate.p90
+            << " min, critical path " << estimate.critical_path << " min, "
+            << estimate.failure_rate * 100 << "% with a failed service";
+        logger->log_event(msg.str());
+    }
+}
+
+TurnaroundEstimate TurnaroundEstimator::get_estimate(TurnaroundCategory category) {
+    pthread_mutex_lock(&estimator_mutex);
+    if (!estimated[category]) {
+        estimates[category] = simulate(category, DEFAULT_SAMPLES);
+        estimated[category] = true;
+    }
+    TurnaroundEstimate result = estimates[category];
+    pthread_mutex_unlock(&estimator_mutex);
+    return result;
+}
+
+TurnaroundEstimate TurnaroundEstimator::get_estimate(AircraftType type) {
+    return get_estimate(TurnaroundTemplate::category_of(Aircraft::get(type)));
+}
+
+long long TurnaroundEstimator::get_planning_time(const Aircraft* aircraft) {
+    TurnaroundEstimate estimate = get_estimate(TurnaroundTemplate::category_of(aircraft));
+    return (long long)ceil(estimate.p90 / MINUTES_PER_TIME_UNIT);
+}
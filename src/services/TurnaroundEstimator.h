@@ -0,0 +1,89 @@
+#ifndef TURNAROUND_ESTIMATOR_H
+#define TURNAROUND_ESTIMATOR_H
+
+#include "GroundService.h"
+#include "ServiceDependencyGraph.h"
+#include "TurnaroundTemplate.h"
+#include "../airport/Aircraft.h"
+#include <vector>
+#include <random>
+#include <pthread.h>
+
+using namespace std;
+
+// TurnaroundEstimator predicts how long a turnaround takes by Monte-Carlo
+// sampling of the service DAG under the models the services run with:
+// equipment failures (GroundService: failure chance per start, recovery
+// time, retry limit) and crew skill (Crew: hiring mix of skill levels) on
+// every crewed service.
+//
+// Samples are split across threads, each with its own generator. The
+// distribution is uncontended - equipment and crew are assumed free - so
+// it is the turnaround's own variability, not queueing at a busy airport.
+// Estimates are per TurnaroundCategory; aircraft types of one category
+// run the same services and share a distribution.
+//
+// Durations are service minutes; get_planning_time converts the P90 to
+// simulation time units for gate and pushback planning.
+
+struct TurnaroundEstimate {
+    TurnaroundCategory category;
+    int samples;
+    int critical_path;          // No failures, standard crew
+    double mean;                // Minutes, completed samples
+    double p50;
+    double p90;
+    double failure_rate;        // Samples where a service failed for good
+};
+
+class TurnaroundEstimator {
+public:
+    static constexpr int DEFAULT_SAMPLES = 20000;
+    static constexpr int DEFAULT_THREADS = 4;
+    static constexpr int MINUTES_PER_TIME_UNIT = 10;    // 1 time unit = 10 service minutes
+    
+private:
+    struct SampleBatch {
+        const TurnaroundEstimator* estimator;
+        const TurnaroundTemplate* plan;
+        int samples;
+        unsigned long long seed;
+        int thread_index;
+        vector<float> durations;        // Completed samples only
+        int failed;
+    };
+    
+    TurnaroundTemplate templates[TURNAROUND_CATEGORY_COUNT];
+    bool crewed[SERVICE_TYPE_COUNT];    // Duration scaled by crew skill
+    
+    TurnaroundEstimate estimates[TURNAROUND_CATEGORY_COUNT];
+    bool estimated[TURNAROUND_CATEGORY_COUNT];
+    int thread_count;
+    unsigned long long seed;
+    pthread_mutex_t estimator_mutex;
+    
+    static void* sample_func(void* arg);
+    // One turnaround; false if a service failed for good
+    bool sample_once(const TurnaroundTemplate& plan, mt19937& rng, double& duration) const;
+    
+public:
+    TurnaroundEstimator(ServiceDependencyGraph* graph, int threads = DEFAULT_THREADS);
+    ~TurnaroundEstimator();
+    
+    // Sample a category afresh (not cached)
+    TurnaroundEstimate simulate(TurnaroundCategory category, int samples);
+    // Estimate every category once; later lookups are a table read
+    void estimate_all(int samples = DEFAULT_SAMPLES);
+    
+    // Cached estimates (sampled on first use)
+    TurnaroundEstimate get_estimate(TurnaroundCategory category);
+    TurnaroundEstimate get_estimate(AircraftType type);
+    // P90 turnaround in simulation time units, rounded up
+    long long get_planning_time(const Aircraft* aircraft);
+    
+    // Base seed; thread generators derive from it (before estimating)
+    void set_seed(unsigned long long s) { seed = s; }
+    const TurnaroundTemplate& get_template(TurnaroundCategory category) const { return templates[category]; }
+};
+
+#endif // TURNAROUND_ESTIMATOR_H
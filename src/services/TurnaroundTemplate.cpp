@@ -0,0 +1,104 @@
+#include "TurnaroundTemplate.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static uint32_t bit(int n) {
+    return 1u << n;
+}
+
+TurnaroundTemplate::TurnaroundTemplate() {
+    category = TURNAROUND_PASSENGER;
+    count = 0;
+    critical_path = 0;
+    memset(order, 0, sizeof(order));
+    memset(predecessors, 0, sizeof(predecessors));
+    memset(successors, 0, sizeof(successors));
+    memset(in_degree, 0, sizeof(in_degree));
+    memset(remaining_work, 0, sizeof(remaining_work));
+}
+
+uint32_t TurnaroundTemplate::services_for(TurnaroundCategory c) {
+    uint32_t all = bit(SERVICE_TYPE_COUNT) - 1;
+    switch (c) {
+        case TURNAROUND_CARGO:
+            return all & ~(bit(SVC_UNLOADING_PASSENGERS) | bit(SVC_UNLOADING_BAGGAGE) |
+                           bit(SVC_CLEANING) | bit(SVC_CATERING) | bit(SVC_WATER_SERVICE) |
+                           bit(SVC_WASTE_SERVICE) | bit(SVC_LOADING_BAGGAGE) | bit(SVC_BOARDING));
+        case TURNAROUND_PRIVATE:
+            return all & ~(bit(SVC_CARGO_UNLOAD) | bit(SVC_CARGO_LOAD));
+        default:
+            return all;
+    }
+}
+
+TurnaroundCategory TurnaroundTemplate::category_of(const Aircraft* aircraft) {
+    if (aircraft == nullptr) return TURNAROUND_PASSENGER;
+    if (aircraft->is_cargo) return TURNAROUND_CARGO;
+    if (aircraft->is_private) return TURNAROUND_PRIVATE;
+    return TURNAROUND_PASSENGER;
+}
+
+const char* TurnaroundTemplate::category_to_string(TurnaroundCategory c) {
+    switch (c) {
+        case TURNAROUND_PASSENGER: return "Passenger";
+        case TURNAROUND_CARGO: return "Cargo";
+        case TURNAROUND_PRIVATE: return "Private";
+        default: return "Unknown";
+    }
+}
+
+void TurnaroundTemplate::compile(ServiceDependencyGraph* graph, TurnaroundCategory c) {
+    *this = TurnaroundTemplate();
+    category = c;
+    uint32_t included = services_for(c);
+    vector<ServiceType> full_order = graph->get_execution_order();
+    
+    // Direct predecessors among included services, by ServiceType; a left-out
+    // service passes its own predecessors through
+    uint32_t direct[SERVICE_TYPE_COUNT] = {};
+    uint32_t ancestors[SERVICE_TYPE_COUNT] = {};
+    for (ServiceType type : full_order) {
+        for (ServiceType dep : graph->get_dependencies(type)) {
+            direct[type] |= (included & bit(dep)) ? bit(dep) : direct[dep];
+            ancestors[type] |= bit(dep) | ancestors[dep];
+        }
+    }
+    
+    int position[SERVICE_TYPE_COUNT];
+    for (ServiceType type : full_order) {
+        if (included & bit(type)) {
+            position[type] = count;
+            order[count++] = type;
+        }
+    }
+    
+    for (int i = 0; i < count; i++) {
+        // Drop edges implied by another predecessor
+        uint32_t preds = direct[order[i]];
+        uint32_t implied = 0;
+        for (int t = 0; t < SERVICE_TYPE_COUNT; t++) {
+            if (preds & bit(t)) implied |= ancestors[t];
+        }
+        preds &= ~implied;
+        
+        for (int t = 0; t < SERVICE_TYPE_COUNT; t++) {
+            if (preds & bit(t)) {
+                predecessors[i] |= bit(position[t]);
+                successors[position[t]] |= bit(i);
+                in_degree[i]++;
+            }
+        }
+    }
+    
+    // Reverse topological order: successors are done first
+    for (int i = count - 1; i >= 0; i--) {
+        int longest = 0;
+        for (int s = i + 1; s < count; s++) {
+            if (successors[i] & bit(s)) longest = max(longest, remaining_work[s]);
+        }
+        remaining_work[i] = GroundService::get_default_duration(order[i]) + longest;
+        critical_path = max(critical_path, remaining_work[i]);
+    }
+}
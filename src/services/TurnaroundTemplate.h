@@ -0,0 +1,57 @@
+#ifndef TURNAROUND_TEMPLATE_H
+#define TURNAROUND_TEMPLATE_H
+
+#include "GroundService.h"
+#include "ServiceDependencyGraph.h"
+#include "../airport/Aircraft.h"
+#include <cstdint>
+
+using namespace std;
+
+// TurnaroundTemplate is a service dependency graph compiled for one
+// aircraft category: the services that category needs in topological
+// order, predecessor and successor bitmasks by position, in-degrees and
+// critical-path lengths from GroundService::get_default_duration.
+//
+// Templates are compiled once and never change. A turnaround is
+// instantiated by copying in_degree into its per-flight counters; no
+// graph is walked and no dependency list is copied per flight.
+//
+// Categories leave out services they do not need (freighters have no
+// passengers, baggage, cleaning or catering; private jets carry no
+// cargo). A dependency on a left-out service is replaced by that
+// service's own dependencies, and redundant edges are dropped.
+
+static_assert(SERVICE_TYPE_COUNT <= 32, "service bitmasks are 32 bits");
+
+enum TurnaroundCategory {
+    TURNAROUND_PASSENGER,
+    TURNAROUND_CARGO,
+    TURNAROUND_PRIVATE
+};
+
+static constexpr int TURNAROUND_CATEGORY_COUNT = TURNAROUND_PRIVATE + 1;
+
+class TurnaroundTemplate {
+public:
+    TurnaroundCategory category;
+    int count;                                  // Services in this turnaround
+    ServiceType order[SERVICE_TYPE_COUNT];      // Topological; positions index below
+    uint32_t predecessors[SERVICE_TYPE_COUNT];  // Bit p = waits for position p
+    uint32_t successors[SERVICE_TYPE_COUNT];
+    int in_degree[SERVICE_TYPE_COUNT];
+    int remaining_work[SERVICE_TYPE_COUNT];     // Critical path from here, minutes
+    int critical_path;
+    
+    TurnaroundTemplate();
+    
+    // Compile the category's services from graph
+    void compile(ServiceDependencyGraph* graph, TurnaroundCategory c);
+    
+    // Services each category needs, as a ServiceType bitmask
+    static uint32_t services_for(TurnaroundCategory c);
+    static TurnaroundCategory category_of(const Aircraft* aircraft);
+    static const char* category_to_string(TurnaroundCategory c);
+};
+
+#endif // TURNAROUND_TEMPLATE_H
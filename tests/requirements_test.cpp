@@ -9,6 +9,10 @@
  * 3. VIP Passenger Fast-Tracking (REQ-3)
  * 4. Budget Exceed Warning (REQ-4)
  * 5. Deadlock Prevention (existing functionality)
+ * 7. Page Compression Round-Trip
+ * 8. Resource Bundle Rollback
+ * 9. PFF Throttle on Capacity Misses
+ * 10. Wait-For Graph Cycles
  */
 
 #include "../src/core/SimulationEngine.h"
@@ -22,8 +26,19 @@
 #include "../src/crisis/CrisisManager.h"
 #include "../src/crisis/WeatherEvent.h"
 #include "../src/crew/Crew.h"
+#include "../src/memory/Page.h"
+#include "../src/memory/CompressionManager.h"
+#include "../src/resources/ResourceManager.h"
+#include "../src/memory/TLB.h"
+#include "../src/memory/ThrashingDetector.h"
+#include "../src/core/FlightEvents.h"
+#include "../src/resources/DeadlockDetector.h"
 #include <iostream>
 #include <cassert>
+#include <vector>
+#include <algorithm>
+#include <set>
+#include <random>
 #include <unistd.h>
 #include <pthread.h>
 
@@ -284,6 +299,272 @@ void test_deadlock_prevention() {
     delete rm;
 }
 
+// ===========================================================================
+// TEST 7: Page Compression Round-Trip
+// Compressed tier must restore page payloads byte-for-byte
+// ===========================================================================
+void test_page_compression() {
+    cout << "\n=== Test 7: Page Compression Round-Trip ===" << endl;
+    
+    CompressionManager* cm = new CompressionManager();
+    
+    // Manifest-like page: repeated fixed-width records
+    Page* page = new Page(1, 100);
+    page->set_tier(TIER_L3);
+    uint8_t* data = page->allocate_data();
+    for (int i = 0; i < Page::PAGE_SIZE; i++) {
+        data[i] = (uint8_t)("PAX-0000;SEAT-00A;BAG-1;"[i % 24] + (i / 480));
+    }
+    vector<uint8_t> original(data, data + Page::PAGE_SIZE);
+    
+    if (!cm->compress_page(page) || page->get_state() != PAGE_COMPRESSED) {
+        test_fail("Page Compression", "Compressible page was not compressed");
+    } else if (page->get_data() != nullptr ||
+               page->get_compressed_size() >= Page::PAGE_SIZE / 2) {
+        test_fail("Page Compression", "Payload not released or ratio too poor: " +
+                  to_string(page->get_compressed_size()) + " bytes");
+    } else if (!cm->decompress_page(page) ||
+               !equal(original.begin(), original.end(), page->get_data())) {
+        test_fail("Page Compression", "Decompressed payload does not match original");
+    } else {
+        test_pass("Page compressed to " + to_string(cm->get_tier_stats(TIER_L3).bytes_out) +
+                  " bytes and restored exactly");
+    }
+    
+    // Random page: must be rejected and left intact for eviction
+    Page* noisy = new Page(2, 100);
+    noisy->set_tier(TIER_L3);
+    uint8_t* noise = noisy->allocate_data();
+    unsigned int state = 12345;
+    for (int i = 0; i < Page::PAGE_SIZE; i++) {
+        state = state * 1103515245 + 12345;
+        noise[i] = (uint8_t)(state >> 16);
+    }
+    
+    if (!cm->compress_page(noisy) && noisy->get_data() == noise &&
+        cm->get_tier_stats(TIER_L3).pages_rejected == 1) {
+        test_pass("Incompressible page rejected and kept resident");
+    } else {
+        test_fail("Page Compression", "Incompressible page was not rejected");
+    }
+    
+    delete page;
+    delete noisy;
+    delete cm;
+}
+
+// ===========================================================================
+// TEST 8: Resource Bundle Rollback
+// A bundle that cannot be granted whole - busy or unsafe - takes nothing
+// ===========================================================================
+void test_bundle_rollback() {
+    cout << "\n=== Test 8: Resource Bundle Rollback ===" << endl;
+    
+    ResourceManager* rm = new ResourceManager();
+    rm->initialize(2, 0, 0, 0, 0, 0, 1);    // 2 fuel trucks, 1 GPU
+    
+    vector<int> max_demand(7, 0);
+    max_demand[RES_FUEL_TRUCK] = 2;
+    max_demand[RES_GROUND_POWER_UNIT] = 1;
+    int a = rm->register_flight(max_demand);
+    int b = rm->register_flight(max_demand);
+    
+    vector<int> both(7, 0);
+    both[RES_FUEL_TRUCK] = 1;
+    both[RES_GROUND_POWER_UNIT] = 1;
+    vector<Resource*> bundle;
+    
+    // GPU busy outside the Banker's rows: the fuel truck must not be held
+    Resource* gpu = rm->allocate_resource(RES_GROUND_POWER_UNIT, 99, 0, 10);
+    bool granted = rm->acquire_bundle(a, both, 1, 0, 10, 0, false, bundle);
+    if (granted || !bundle.empty() || rm->get_available_count(RES_FUEL_TRUCK) != 2) {
+        test_fail("Bundle Rollback", "Bundle with a busy GPU kept a fuel truck");
+    } else {
+        test_pass("Bundle with a busy member took nothing");
+    }
+    rm->release_resource(gpu);
+    
+    // A holds 1 truck and may need 1 more; granting B's truck and the GPU
+    // would leave A and B both waiting for the last truck - unsafe
+    vector<int> fuel(7, 0);
+    fuel[RES_FUEL_TRUCK] = 1;
+    vector<Resource*> held;
+    bool a_granted = rm->acquire_bundle(a, fuel, 1, 0, 10, 0, false, held);
+    granted = rm->acquire_bundle(b, both, 2, 0, 10, 0, false, bundle);
+    if (!a_granted || granted || !bundle.empty() ||
+        rm->get_available_count(RES_FUEL_TRUCK) != 1 || rm->get_available_count(RES_GROUND_POWER_UNIT) != 1) {
+        test_fail("Bundle Rollback", "Unsafe bundle was granted or not rolled back");
+    } else {
+        rm->release_bundle(a, held);
+        granted = rm->acquire_bundle(b, both, 2, 0, 10, 0, false, bundle);
+        if (granted && bundle.size() == 2 && rm->get_available_count(RES_GROUND_POWER_UNIT) == 0) {
+            test_pass("Unsafe bundle refused whole, granted once safe");
+        } else {
+            test_fail("Bundle Rollback", "Safe bundle was not granted after release");
+        }
+        rm->release_bundle(b, bundle);
+    }
+    
+    rm->unregister_flight(a);
+    rm->unregister_flight(b);
+    delete rm;
+}
+
+// ===========================================================================
+// TEST 9: PFF Throttle on Capacity Misses
+// First touches stay out of the fault rate; pages missing again after
+// being displaced drive the admission signal to THROTTLE
+// ===========================================================================
+void test_pff_capacity_misses() {
+    cout << "\n=== Test 9: PFF Throttle on Capacity Misses ===" << endl;
+    
+    // Working set fits the TLB: only compulsory misses
+    TLB fits_tlb(8);
+    ThrashingDetector fits({100, 1000});
+    vector<bool> fits_touched;
+    for (int pass = 0; pass < 50; pass++) {
+        for (int page = 0; page < 4; page++) touch_page(&fits_tlb, &fits, 1, page, fits_touched);
+    }
+    
+    // Eight pages cycled through a 4-entry LRU TLB miss on every access
+    TLB small_tlb(4);
+    ThrashingDetector thrashing({100, 1000});
+    vector<bool> touched;
+    for (int page = 0; page < 8; page++) touch_page(&small_tlb, &thrashing, 1, page, touched);
+    PFFSignal after_first_touch = thrashing.get_pff_signal();
+    for (int pass = 0; pass < 50; pass++) {
+        for (int page = 0; page < 8; page++) touch_page(&small_tlb, &thrashing, 1, page, touched);
+    }
+    
+    if (fits.get_pff_signal() != PFF_ADMIT || fits.get_compulsory_faults() != 4) {
+        test_fail("PFF Capacity Misses", "Working set that fits the TLB was not admitted");
+    } else if (after_first_touch != PFF_ADMIT || thrashing.get_compulsory_faults() != 8) {
+        test_fail("PFF Capacity Misses", "First touches counted toward the fault rate");
+    } else if (thrashing.get_current_fault_rate() < 0.99 || thrashing.get_pff_signal() != PFF_THROTTLE) {
+        test_fail("PFF Capacity Misses", "Sustained capacity misses did not throttle admission");
+    } else {
+        test_pass("Capacity misses throttle admission, first touches do not");
+    }
+}
+
+// ===========================================================================
+// TEST 10: Wait-For Graph Cycles
+// Online cycle detection: closing edge reported, removals re-admit back
+// edges, and the report matches a brute-force search
+// ===========================================================================
+
+// Flights on a cycle: those reachable again from one of their own successors
+static vector<int> brute_force_deadlocked(const set<pair<int, int>>& edges, int flights) {
+    vector<int> deadlocked;
+    for (int v = 0; v < flights; v++) {
+        vector<bool> seen(flights, false);
+        vector<int> stack;
+        for (const auto& e : edges) {
+            if (e.first == v) stack.push_back(e.second);
+        }
+        bool cycle = false;
+        while (!stack.empty() && !cycle) {
+            int u = stack.back();
+            stack.pop_back();
+            if (u == v) cycle = true;
+            if (seen[u]) continue;
+            seen[u] = true;
+            for (const auto& e : edges) {
+                if (e.first == u) stack.push_back(e.second);
+            }
+        }
+        if (cycle) deadlocked.push_back(v);
+    }
+    return deadlocked;
+}
+
+void test_wait_for_cycles() {
+    cout << "\n=== Test 10: Wait-For Graph Cycles ===" << endl;
+    
+    // Edges added against the topological order force reordering; only
+    // the last one closes the cycle 1 -> 2 -> 3 -> 4 -> 1
+    const int cycle[4][2] = {{3, 4}, {1, 2}, {2, 3}, {4, 1}};
+    bool closing_ok = true;
+    bool removal_ok = true;
+    for (int removed = 0; removed < 4; removed++) {
+        DeadlockDetector dd;
+        for (int e = 0; e < 4; e++) {
+            bool closed = dd.add_wait(cycle[e][0], cycle[e][1]);
+            if (closed != (e == 3)) closing_ok = false;
+        }
+        vector<int> members = dd.get_deadlocked_flights();
+        sort(members.begin(), members.end());
+        if (!dd.detect_deadlock() || members != vector<int>({1, 2, 3, 4})) closing_ok = false;
+        
+        dd.remove_wait(cycle[removed][0], cycle[removed][1]);
+        if (dd.detect_deadlock() || !dd.get_deadlocked_flights().empty()) removal_ok = false;
+    }
+    if (closing_ok) {
+        test_pass("Cycle reported on its closing edge");
+    } else {
+        test_fail("Wait-For Cycles", "Cycle not reported exactly on the closing edge");
+    }
+    if (removal_ok) {
+        test_pass("Removing any cycle edge clears the deadlock");
+    } else {
+        test_fail("Wait-For Cycles", "Deadlock still reported after a cycle edge was removed");
+    }
+    
+    // Dropping a cycle member re-admits the back edge 3 -> 1: a new
+    // 1 -> 3 then closes a cycle through it
+    DeadlockDetector dd;
+    dd.add_wait(1, 2);
+    dd.add_wait(2, 3);
+    dd.add_wait(3, 1);
+    dd.remove_flight(2);
+    bool cleared = !dd.detect_deadlock();
+    bool reclosed = dd.add_wait(1, 3);
+    vector<int> members = dd.get_deadlocked_flights();
+    sort(members.begin(), members.end());
+    if (cleared && reclosed && members == vector<int>({1, 3})) {
+        test_pass("remove_flight re-admits back edges");
+    } else {
+        test_fail("Wait-For Cycles", "Back edge not re-admitted after remove_flight");
+    }
+    
+    // Random edits on small graphs against a brute-force search
+    mt19937 rng(17);
+    int mismatches = 0;
+    for (int trial = 0; trial < 200; trial++) {
+        const int flights = 4 + trial % 5;
+        DeadlockDetector random_dd;
+        set<pair<int, int>> edges;
+        uniform_int_distribution<int> flight(0, flights - 1);
+        for (int step = 0; step < 40; step++) {
+            int roll = rng() % 10;
+            int a = flight(rng), b = flight(rng);
+            if (roll < 6) {
+                random_dd.add_wait(a, b);
+                edges.insert(make_pair(a, b));
+            } else if (roll < 9) {
+                random_dd.remove_wait(a, b);
+                edges.erase(make_pair(a, b));
+            } else {
+                random_dd.remove_flight(a);
+                for (auto it = edges.begin(); it != edges.end();) {
+                    it = (it->first == a || it->second == a) ? edges.erase(it) : next(it);
+                }
+            }
+            vector<int> expected = brute_force_deadlocked(edges, flights);
+            vector<int> reported = random_dd.get_deadlocked_flights();
+            sort(reported.begin(), reported.end());
+            if (reported != expected || random_dd.detect_deadlock() != !expected.empty()) {
+                mismatches++;
+            }
+        }
+    }
+    if (mismatches == 0) {
+        test_pass("Deadlock report matches brute force on 200 random graphs");
+    } else {
+        test_fail("Wait-For Cycles", to_string(mismatches) + " reports differ from brute force");
+    }
+}
+
 // ===========================================================================
 // MAIN
 // ===========================================================================
@@ -302,6 +583,10 @@ int main() {
     test_budget_constraint();
     test_atc_crew_type();
     test_deadlock_prevention();
+    test_page_compression();
+    test_bundle_rollback();
+    test_pff_capacity_misses();
+    test_wait_for_cycles();
     
     // Flush logger to ensure all logs are written
     logger->flush_all();
@@ -0,0 +1,145 @@
+/**
+ * schedule_reader_test.cpp
+ *
+ * Test cases for the CSV schedule parser (ScheduleReader)
+ *
+ * Tests:
+ * 1. Header row recognised by its column names
+ * 2. Malformed rows skipped and counted
+ * 3. Duplicate flight ids rejected
+ */
+
+#include "../src/data/ScheduleReader.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+// Test result tracking
+int tests_passed = 0;
+int tests_failed = 0;
+
+void test_pass(const string& test_name) {
+    cout << "[PASS] " << test_name << endl;
+    tests_passed++;
+}
+
+void test_fail(const string& test_name, const string& reason) {
+    cout << "[FAIL] " << test_name << " - " << reason << endl;
+    tests_failed++;
+}
+
+// Write contents to a scratch file and read every row back
+static vector<ScheduleRow> read_schedule(const string& contents, ScheduleReader& reader) {
+    string path = "/tmp/schedule_reader_test_" + to_string(getpid()) + ".csv";
+    ofstream(path) << contents;
+    vector<ScheduleRow> rows;
+    if (reader.open(path)) {
+        ScheduleRow row;
+        while (reader.next(row)) rows.push_back(row);
+    }
+    unlink(path.c_str());
+    return rows;
+}
+
+// ===========================================================================
+// TEST 1: Header Detection
+// Only a first row naming the columns is skipped silently
+// ===========================================================================
+void test_header() {
+    cout << "\n=== Test 1: Header Detection ===" << endl;
+
+    ScheduleReader reader;
+    vector<ScheduleRow> rows = read_schedule(
+        "# day one\n"
+        "Flight_ID, Aircraft_Type, Flight_Type, Arrival, Departure\n"
+        "EK201,A380,INTERNATIONAL,06:05,08:40\n"
+        "UA88,B737,D,3600,5400\n", reader);
+    if (rows.size() == 2 && reader.get_error_count() == 0 &&
+        rows[0].flight_id == "EK201" && rows[0].arrival_time == 6 * 3600 + 5 * 60 &&
+        rows[1].aircraft_type == B737 && rows[1].flight_type == DOMESTIC) {
+        test_pass("Header row skipped by column names");
+    } else {
+        test_fail("Header", "Expected 2 rows and no errors, got " + to_string(rows.size()) +
+                  " rows, " + to_string(reader.get_error_count()) + " errors");
+    }
+
+    // A bad first row is an error, not a header
+    rows = read_schedule(
+        "EK201,A380,SOMEWHERE,06:05,08:40\n"
+        "UA88,B737,D,3600,5400\n", reader);
+    if (rows.size() == 1 && reader.get_error_count() == 1) {
+        test_pass("Malformed first row counted, not taken as header");
+    } else {
+        test_fail("Header", "Malformed first row was not counted");
+    }
+}
+
+// ===========================================================================
+// TEST 2: Malformed Rows
+// Bad rows are skipped and counted; the good ones around them still load
+// ===========================================================================
+void test_malformed_rows() {
+    cout << "\n=== Test 2: Malformed Rows ===" << endl;
+
+    ScheduleReader reader;
+    vector<ScheduleRow> rows = read_schedule(
+        "flight_id,aircraft_type,flight_type,arrival,departure\n"
+        "AA1,A320,D,100,200\n"
+        "AA2,A320,D,100\n"                  // Too few fields
+        "AA3,A320,D,100,200,extra\n"        // Too many
+        "AA4,CONCORDE,D,100,200\n"          // Unknown aircraft
+        "AA5,A320,D,10:75,11:00\n"          // Bad minutes
+        "AA6,A320,D,300,200\n"              // Departs before arrival
+        ",A320,D,100,200\n"                 // Empty id
+        "\n"
+        "AA7,Falcon_7X,I,100,200\n", reader);
+    if (rows.size() == 2 && reader.get_error_count() == 6 &&
+        rows[0].flight_id == "AA1" && rows[1].flight_id == "AA7" && rows[1].aircraft_type == FALCON_7X &&
+        rows[1].line == 10) {
+        test_pass("6 malformed rows skipped and counted, 2 loaded");
+    } else {
+        test_fail("Malformed Rows", "Expected 2 rows and 6 errors, got " + to_string(rows.size()) +
+                  " rows, " + to_string(reader.get_error_count()) + " errors");
+    }
+}
+
+// ===========================================================================
+// TEST 3: Duplicate Flight Ids
+// The first row with an id wins; repeats are errors
+// ===========================================================================
+void test_duplicate_ids() {
+    cout << "\n=== Test 3: Duplicate Flight Ids ===" << endl;
+
+    ScheduleReader reader;
+    vector<ScheduleRow> rows = read_schedule(
+        "BA10,B777,I,100,400\n"
+        "BA11,B777,I,200,500\n"
+        "BA10,A320,D,300,600\n", reader);
+    const vector<string>& errors = reader.get_errors();
+    if (rows.size() == 2 && reader.get_error_count() == 1 && rows[0].aircraft_type == B777 &&
+        !errors.empty() && errors[0].find("duplicate flight id BA10") != string::npos) {
+        test_pass("Duplicate flight id rejected");
+    } else {
+        test_fail("Duplicate Ids", "Expected the repeated BA10 to be rejected");
+    }
+}
+
+// ===========================================================================
+// MAIN
+// ===========================================================================
+int main() {
+    cout << "╔═══════════════════════════════════════════════════════════════╗" << endl;
+    cout << "║         Smart Airport OS Simulator - Schedule Reader          ║" << endl;
+    cout << "╚═══════════════════════════════════════════════════════════════╝" << endl;
+
+    test_header();
+    test_malformed_rows();
+    test_duplicate_ids();
+
+    cout << "\nPassed: " << tests_passed << ", Failed: " << tests_failed << endl;
+    return tests_failed == 0 ? 0 : 1;
+}